@@ -0,0 +1,129 @@
+#pragma once
+#include "Base/Allocators/Allocator.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bench {
+	using Clock = std::chrono::steady_clock;
+
+	inline double elapsedNs (Clock::time_point start, Clock::time_point end) {
+		return std::chrono::duration<double, std::nano> (end - start).count ();
+	}
+
+	//One measured configuration, -1 for the fields that don't apply
+	struct Result {
+		std::string benchmark;
+		std::string allocator;
+		long long size = -1;
+		long long alignment = -1;
+		long long threads = 1;
+		size_t operations = 0;
+		double ns_per_op = 0;
+		size_t failures = 0;
+		double fragmentation = -1;
+		double max_fragmentation = -1;
+	};
+
+	class Report {
+	public:
+		void add (const Result& result) {
+			_results.push_back (result);
+
+			std::printf ("%-20s %-22s size %6lld align %3lld threads %3lld : %10.2f ns/op",
+				result.benchmark.c_str (), result.allocator.c_str (), result.size, result.alignment, result.threads, result.ns_per_op);
+			if (result.failures > 0) std::printf (", %zu failed", result.failures);
+			if (result.fragmentation >= 0) std::printf (", fragmentation %.3f (max %.3f)", result.fragmentation, result.max_fragmentation);
+			std::printf ("\n");
+			std::fflush (stdout);
+		}
+
+		bool writeJson (const std::string& path, unsigned int hardware_threads) const {
+			FILE* file = std::fopen (path.c_str (), "w");
+			if (file == nullptr) return false;
+
+			std::fprintf (file, "{\n  \"schema\": 1,\n  \"timestamp\": %lld,\n  \"hardware_concurrency\": %u,\n",
+				static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds> (std::chrono::system_clock::now ().time_since_epoch ()).count ()), hardware_threads);
+#ifdef RLMS_ALLOCATOR_GUARDS
+			std::fprintf (file, "  \"guards\": true,\n");
+#else
+			std::fprintf (file, "  \"guards\": false,\n");
+#endif
+#ifdef RLMS_ALLOCATOR_STATS
+			std::fprintf (file, "  \"stats\": true,\n");
+#else
+			std::fprintf (file, "  \"stats\": false,\n");
+#endif
+			std::fprintf (file, "  \"results\": [\n");
+			for (size_t i = 0; i < _results.size (); i++) {
+				const Result& r = _results[i];
+				std::fprintf (file, "    {\"benchmark\": \"%s\", \"allocator\": \"%s\", \"size\": %lld, \"alignment\": %lld, \"threads\": %lld, "
+					"\"operations\": %zu, \"ns_per_op\": %.3f, \"failures\": %zu, \"fragmentation\": %.4f, \"max_fragmentation\": %.4f}%s\n",
+					r.benchmark.c_str (), r.allocator.c_str (), r.size, r.alignment, r.threads,
+					r.operations, r.ns_per_op, r.failures, r.fragmentation, r.max_fragmentation, i + 1 < _results.size () ? "," : "");
+			}
+			std::fprintf (file, "  ]\n}\n");
+
+			return std::fclose (file) == 0;
+		}
+
+	private:
+		std::vector<Result> _results;
+	};
+
+	//The system heap behind the Allocator interface, the baseline every allocator is compared to
+	class MallocAllocator : public Allocator {
+	public:
+		//No range of its own, the whole address space as far as the base class knows
+		MallocAllocator () : Allocator (nullptr, SIZE_MAX) {}
+
+		void* allocate (size_t size, uint8_t alignment) override {
+			if (alignment <= alignof (std::max_align_t)) return std::malloc (size);
+
+			void* p = nullptr;
+			return posix_memalign (&p, alignment, size) == 0 ? p : nullptr;
+		}
+
+		void deallocate (void*&& p) override {
+			std::free (p);
+			p = nullptr;
+		}
+	};
+
+	//Serialize an allocator that is not thread-safe, to compare against the concurrent ones
+	class LockedAllocator : public Allocator {
+	public:
+		//Usage is read from the parent, the base range is never used
+		LockedAllocator (Allocator* const& parent) : Allocator (parent->getStart (), SIZE_MAX), _parent (parent) {}
+
+		void* allocate (size_t size, uint8_t alignment) override {
+			std::lock_guard<std::mutex> lock (_mutex);
+			return _parent->allocate (size, alignment);
+		}
+
+		void deallocate (void*&& p) override {
+			std::lock_guard<std::mutex> lock (_mutex);
+			_parent->deallocate (std::move (p));
+		}
+
+		size_t getUsedMemory () const override {
+			return _parent->getUsedMemory ();
+		}
+
+		size_t getLargestFreeBlock () const override {
+			return _parent->getLargestFreeBlock ();
+		}
+
+	private:
+		Allocator* _parent;
+		std::mutex _mutex;
+	};
+
+	//Chunk scans over normal and huge pages, from bench_VirtualArena.cpp
+	void hugePages (Report& report, size_t scale);
+}
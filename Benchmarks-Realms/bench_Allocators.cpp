@@ -0,0 +1,366 @@
+#include "Benchmark.h"
+
+#include "Base/Allocators/LinearAllocator.h"
+#include "Base/Allocators/StackAllocator.h"
+#include "Base/Allocators/PoolAllocator.h"
+#include "Base/Allocators/ConcurrentPoolAllocator.h"
+#include "Base/Allocators/PagedPoolAllocator.h"
+#include "Base/Allocators/FreeListAllocator.h"
+#include "Base/Allocators/TLSFAllocator.h"
+#include "Base/Allocators/ThreadCacheAllocator.h"
+#include "Base/Allocators/FrameAllocator.h"
+#include "Base/Allocators/ProxyAllocator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
+
+using namespace bench;
+
+namespace {
+	const size_t ARENA_SIZE = 64 * 1024 * 1024;
+
+	//How blocks go back to the allocator
+	enum class Release {
+		Any,
+		Lifo,
+		Reset
+	};
+
+	//One allocator under test, built over the shared arena memory
+	struct Instance {
+		std::unique_ptr<Allocator> parent;
+		std::unique_ptr<Allocator> allocator;
+	};
+
+	struct Subject {
+		std::string name;
+		Release release;
+		//Only serves blocks of the size it was created for
+		bool fixed_size;
+		bool thread_safe;
+		std::function<Instance (void* mem, size_t size, uint8_t alignment)> create;
+		std::function<void (Allocator&)> reset;
+	};
+
+	void* s_arena = nullptr;
+
+	Instance single (Allocator* allocator) {
+		Instance instance;
+		instance.allocator.reset (allocator);
+		return instance;
+	}
+
+	std::vector<Subject> subjects () {
+		auto none = [] (Allocator&) {};
+		//Fixed size allocators need room for their free list link
+		auto object = [] (size_t size) { return size < sizeof (void*) ? sizeof (void*) : size; };
+
+		std::vector<Subject> list;
+		list.push_back ({ "malloc", Release::Any, false, true, [] (void*, size_t, uint8_t) { return single (new MallocAllocator ()); }, none });
+		list.push_back ({ "Linear", Release::Reset, false, false, [] (void* mem, size_t, uint8_t) { return single (new LinearAllocator (mem, ARENA_SIZE)); },
+			[] (Allocator& a) { static_cast<LinearAllocator&>(a).clear (); } });
+		list.push_back ({ "Stack", Release::Lifo, false, false, [] (void* mem, size_t, uint8_t) { return single (new StackAllocator (mem, ARENA_SIZE)); }, none });
+		list.push_back ({ "Pool", Release::Any, true, false, [object] (void* mem, size_t size, uint8_t alignment) {
+			return single (new PoolAllocator (object (size), alignment, ARENA_SIZE, mem)); }, none });
+		list.push_back ({ "ConcurrentPool", Release::Any, true, true, [object] (void* mem, size_t size, uint8_t alignment) {
+			return single (new ConcurrentPoolAllocator (object (size), alignment, ARENA_SIZE, mem)); }, none });
+		list.push_back ({ "PagedPool", Release::Any, true, false, [object] (void* mem, size_t size, uint8_t alignment) {
+			Instance instance;
+			instance.parent.reset (new TLSFAllocator (mem, ARENA_SIZE));
+			instance.allocator.reset (new PagedPoolAllocator (object (size), alignment, 64 * 1024, instance.parent.get ()));
+			return instance; }, none });
+		list.push_back ({ "FreeList", Release::Any, false, false, [] (void* mem, size_t, uint8_t) { return single (new FreeListAllocator (mem, ARENA_SIZE)); }, none });
+		list.push_back ({ "TLSF", Release::Any, false, false, [] (void* mem, size_t, uint8_t) { return single (new TLSFAllocator (mem, ARENA_SIZE)); }, none });
+		list.push_back ({ "ThreadCache", Release::Any, false, true, [] (void* mem, size_t, uint8_t) {
+			Instance instance;
+			instance.parent.reset (new TLSFAllocator (mem, ARENA_SIZE));
+			instance.allocator.reset (new ThreadCacheAllocator (instance.parent.get ()));
+			return instance; }, none });
+		list.push_back ({ "Frame", Release::Reset, false, false, [] (void* mem, size_t, uint8_t) { return single (new FrameAllocator (mem, ARENA_SIZE)); },
+			[] (Allocator& a) { static_cast<FrameAllocator&>(a).swap (); static_cast<FrameAllocator&>(a).swap (); } });
+		list.push_back ({ "Proxy", Release::Reset, false, false, [] (void* mem, size_t, uint8_t) { return single (new ProxyAllocator (mem, ARENA_SIZE)); },
+			[] (Allocator& a) { a.deallocate (a.getStart ()); } });
+		return list;
+	}
+
+	void releaseAll (const Subject& subject, Allocator& allocator, std::vector<void*>& blocks) {
+		switch (subject.release) {
+		case Release::Any:
+			for (void*& p : blocks) allocator.deallocate (std::move (p));
+			break;
+		case Release::Lifo:
+			for (auto it = blocks.rbegin (); it != blocks.rend (); ++it) allocator.deallocate (std::move (*it));
+			break;
+		case Release::Reset:
+			subject.reset (allocator);
+			break;
+		}
+		blocks.clear ();
+	}
+
+	//Fill then empty the allocator, for every size and alignment
+	void sizes (Report& report, const Subject& subject, size_t rounds) {
+		const size_t sizes[] = { 8, 16, 32, 64, 128, 256, 512, 1024, 4096 };
+		const uint8_t alignments[] = { 8, 16, 64 };
+
+		for (size_t size : sizes) {
+			for (uint8_t alignment : alignments) {
+				Instance instance = subject.create (s_arena, size, alignment);
+				Allocator& allocator = *instance.allocator;
+
+				size_t count = std::min<size_t> (10000, ARENA_SIZE / (4 * (size + alignment + 64)));
+				std::vector<void*> blocks;
+				blocks.reserve (count);
+
+				Result result;
+				result.benchmark = "sizes";
+				result.allocator = subject.name;
+				result.size = size;
+				result.alignment = alignment;
+
+				auto start = Clock::now ();
+				for (size_t r = 0; r < rounds; r++) {
+					for (size_t i = 0; i < count; i++) {
+						void* p = allocator.allocate (size, alignment);
+						if (p == nullptr) {
+							result.failures++;
+							continue;
+						}
+						blocks.push_back (p);
+					}
+					releaseAll (subject, allocator, blocks);
+				}
+				result.operations = rounds * count;
+				result.ns_per_op = elapsedNs (start, Clock::now ()) / result.operations;
+				report.add (result);
+			}
+		}
+	}
+
+	//Random allocations and frees over a bounded live set, sizes drawn uniformly or log-uniformly
+	Result churn (const Subject& subject, Allocator& allocator, size_t slots, size_t steps, size_t min_size, size_t max_size, bool log_sizes, std::mt19937& rng, bool measure_fragmentation) {
+		std::vector<void*> live (slots, nullptr);
+		std::uniform_int_distribution<size_t> slot_dist (0, slots - 1);
+		std::uniform_int_distribution<size_t> size_dist (min_size, max_size);
+		std::uniform_real_distribution<double> log_dist (std::log2 (static_cast<double>(min_size)), std::log2 (static_cast<double>(max_size)));
+
+		Result result;
+		result.allocator = subject.name;
+		result.operations = steps;
+
+		double fragmentation_sum = 0;
+		size_t fragmentation_samples = 0;
+
+		auto start = Clock::now ();
+		for (size_t i = 0; i < steps; i++) {
+			void*& p = live[slot_dist (rng)];
+			if (p != nullptr) {
+				allocator.deallocate (std::move (p));
+				p = nullptr;
+			} else {
+				size_t size = subject.fixed_size ? min_size : (log_sizes ? static_cast<size_t>(std::exp2 (log_dist (rng))) : size_dist (rng));
+				p = allocator.allocate (size, DEFAULT_ALIGNMENT);
+				if (p == nullptr) result.failures++;
+			}
+
+			if (measure_fragmentation && (i & 1023) == 0) {
+				double fragmentation = allocator.getFragmentation ();
+				fragmentation_sum += fragmentation;
+				fragmentation_samples++;
+				result.max_fragmentation = std::max (result.max_fragmentation, fragmentation);
+			}
+		}
+		result.ns_per_op = elapsedNs (start, Clock::now ()) / steps;
+
+		if (measure_fragmentation && fragmentation_samples > 0) {
+			result.fragmentation = fragmentation_sum / fragmentation_samples;
+		}
+
+		for (void*& p : live) {
+			if (p != nullptr) allocator.deallocate (std::move (p));
+		}
+		return result;
+	}
+
+	void random (Report& report, const Subject& subject, size_t steps) {
+		if (subject.release != Release::Any) return;
+
+		const size_t size = 64;
+		Instance instance = subject.create (s_arena, size, DEFAULT_ALIGNMENT);
+		std::mt19937 rng (42);
+
+		Result result = churn (subject, *instance.allocator, 4096, steps, subject.fixed_size ? size : 16, 1024, false, rng, false);
+		result.benchmark = "random";
+		if (subject.fixed_size) result.size = size;
+		report.add (result);
+	}
+
+	//Long run of mixed sizes keeping the arena about half full, fragmentation sampled along the way
+	void soak (Report& report, const Subject& subject, size_t steps) {
+		if (subject.release != Release::Any || subject.fixed_size) return;
+
+		Instance instance = subject.create (s_arena, 0, DEFAULT_ALIGNMENT);
+		std::mt19937 rng (7);
+
+		//Mean of the log-uniform size over [16, 16K] is about 2.4K, half the arena live on average
+		size_t slots = ARENA_SIZE / 2400;
+		Result result = churn (subject, *instance.allocator, slots, steps, 16, 16 * 1024, true, rng, subject.name != "malloc");
+		result.benchmark = "fragmentation_soak";
+		report.add (result);
+	}
+
+	void threads (Report& report, const Subject& subject, unsigned int max_threads, size_t steps_per_thread) {
+		if (subject.release != Release::Any) return;
+
+		const size_t size = 64;
+		for (unsigned int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+			Instance instance = subject.create (s_arena, size, DEFAULT_ALIGNMENT);
+
+			Allocator* allocator = instance.allocator.get ();
+			std::unique_ptr<LockedAllocator> locked;
+			if (!subject.thread_safe) {
+				locked.reset (new LockedAllocator (allocator));
+				allocator = locked.get ();
+			}
+
+			std::vector<Result> results (thread_count);
+			std::vector<std::thread> workers;
+
+			auto start = Clock::now ();
+			for (unsigned int t = 0; t < thread_count; t++) {
+				workers.emplace_back ([&, t] () {
+					std::mt19937 rng (t + 1);
+					results[t] = churn (subject, *allocator, 256, steps_per_thread, size, size, false, rng, false);
+				});
+			}
+			for (auto& worker : workers) worker.join ();
+
+			Result result;
+			result.benchmark = "threads";
+			result.allocator = subject.thread_safe ? subject.name : subject.name + "+mutex";
+			result.size = size;
+			result.threads = thread_count;
+			result.operations = steps_per_thread * thread_count;
+			//Wall time per operation, lower means better throughput
+			result.ns_per_op = elapsedNs (start, Clock::now ()) / result.operations;
+			for (auto& r : results) result.failures += r.failures;
+			report.add (result);
+
+			//Give the cached blocks of the joined threads back before the parent goes
+			if (ThreadCacheAllocator* cache = dynamic_cast<ThreadCacheAllocator*>(instance.allocator.get ())) {
+				cache->flush ();
+			}
+		}
+	}
+
+	//Every thread repeatedly takes a few blocks and gives them back, the allocator is hit in bursts
+	void contention (Report& report, const Subject& subject, unsigned int max_threads, size_t iterations) {
+		if (subject.release != Release::Any) return;
+
+		const size_t size = 64;
+		for (unsigned int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+			Instance instance = subject.create (s_arena, size, DEFAULT_ALIGNMENT);
+
+			Allocator* allocator = instance.allocator.get ();
+			std::unique_ptr<LockedAllocator> locked;
+			if (!subject.thread_safe) {
+				locked.reset (new LockedAllocator (allocator));
+				allocator = locked.get ();
+			}
+
+			std::vector<size_t> failures (thread_count, 0);
+			std::vector<std::thread> workers;
+
+			auto start = Clock::now ();
+			for (unsigned int t = 0; t < thread_count; t++) {
+				workers.emplace_back ([&, t] () {
+					void* held[8];
+					for (size_t i = 0; i < iterations; i++) {
+						for (void*& p : held) {
+							p = allocator->allocate (size, DEFAULT_ALIGNMENT);
+							if (p == nullptr) failures[t]++;
+						}
+						for (void*& p : held) {
+							if (p != nullptr) allocator->deallocate (std::move (p));
+						}
+					}
+				});
+			}
+			for (auto& worker : workers) worker.join ();
+
+			Result result;
+			result.benchmark = "contention";
+			result.allocator = subject.thread_safe ? subject.name : subject.name + "+mutex";
+			result.size = size;
+			result.threads = thread_count;
+			result.operations = 2 * 8 * iterations * thread_count;
+			result.ns_per_op = elapsedNs (start, Clock::now ()) / result.operations;
+			for (size_t f : failures) result.failures += f;
+			report.add (result);
+
+			if (ThreadCacheAllocator* cache = dynamic_cast<ThreadCacheAllocator*>(instance.allocator.get ())) {
+				cache->flush ();
+			}
+		}
+	}
+
+	void usage () {
+		std::printf ("usage: Realms_Benchmarks [--out file.json] [--filter allocator] [--quick]\n");
+	}
+}
+
+int main (int argc, char** argv) {
+	std::string out = "allocator_benchmarks.json";
+	std::string filter;
+	bool quick = false;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--out" && i + 1 < argc) {
+			out = argv[++i];
+		} else if (arg == "--filter" && i + 1 < argc) {
+			filter = argv[++i];
+		} else if (arg == "--quick") {
+			quick = true;
+		} else {
+			usage ();
+			return 1;
+		}
+	}
+
+	s_arena = std::malloc (ARENA_SIZE);
+	if (s_arena == nullptr) {
+		std::fprintf (stderr, "Could not allocate the benchmark arena.\n");
+		return 1;
+	}
+
+	unsigned int hardware_threads = std::max (1u, std::thread::hardware_concurrency ());
+	size_t scale = quick ? 1 : 10;
+
+	Report report;
+	for (const Subject& subject : subjects ()) {
+		if (!filter.empty () && subject.name.find (filter) == std::string::npos) continue;
+
+		sizes (report, subject, 2 * scale);
+		random (report, subject, 200000 * scale);
+		soak (report, subject, 100000 * scale);
+		threads (report, subject, hardware_threads, 20000 * scale);
+		contention (report, subject, hardware_threads, 2000 * scale);
+	}
+	if (filter.empty () || std::string ("VirtualArena").find (filter) != std::string::npos) {
+		hugePages (report, scale);
+	}
+
+	std::free (s_arena);
+
+	if (!report.writeJson (out, hardware_threads)) {
+		std::fprintf (stderr, "Could not write %s.\n", out.c_str ());
+		return 1;
+	}
+	std::printf ("Results written to %s\n", out.c_str ());
+	return 0;
+}
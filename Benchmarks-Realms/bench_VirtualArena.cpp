@@ -0,0 +1,126 @@
+#include "Benchmark.h"
+
+#include "Base/Allocators/VirtualArena.h"
+#include "Base/Allocators/TLSFAllocator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <random>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+	//Keeps the scans from being optimized away
+	volatile uint64_t s_sink = 0;
+
+	//Same footprint as a Chunk's blocks : 16^3 4 bytes blocks
+	struct ChunkBlocks {
+		uint32_t blocks[16 * 16 * 16];
+	};
+
+	//dTLB load misses of the calling thread, -1 when the counter can't be opened
+	class TLBCounter {
+	public:
+		TLBCounter () : _fd (-1) {
+			perf_event_attr attr;
+			std::memset (&attr, 0, sizeof (attr));
+			attr.size = sizeof (attr);
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			_fd = static_cast<int>(syscall (__NR_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+
+		~TLBCounter () {
+			if (_fd >= 0) close (_fd);
+		}
+
+		void start () {
+			if (_fd < 0) return;
+			ioctl (_fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl (_fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+
+		long long stop () {
+			if (_fd < 0) return -1;
+			ioctl (_fd, PERF_EVENT_IOC_DISABLE, 0);
+			long long count = 0;
+			if (read (_fd, &count, sizeof (count)) != sizeof (count)) return -1;
+			return count;
+		}
+
+	private:
+		int _fd;
+	};
+
+	//Visit every block of chunks allocated from an arena, chunks in random order as the world does
+	void scanChunks (bench::Report& report, bool huge_pages, size_t chunk_count, size_t passes) {
+		VirtualArena arena (chunk_count * sizeof (ChunkBlocks) * 2, huge_pages);
+		if (arena.getStart () == nullptr) {
+			std::fprintf (stderr, "Could not reserve the chunk arena.\n");
+			return;
+		}
+
+		TLSFAllocator alloc (&arena, VirtualArena::HUGE_PAGE_SIZE);
+		std::vector<ChunkBlocks*> chunks;
+		chunks.reserve (chunk_count);
+
+		bench::Result result;
+		result.benchmark = "chunk_scan";
+		result.allocator = !huge_pages ? "normal_pages" : (arena.usesHugePages () ? "huge_pages" : "huge_pages(unavailable)");
+		result.size = sizeof (ChunkBlocks);
+
+		for (size_t i = 0; i < chunk_count; i++) {
+			ChunkBlocks* chunk = allocator::allocateNew<ChunkBlocks> (alloc);
+			if (chunk == nullptr) {
+				result.failures++;
+				continue;
+			}
+			std::memset (chunk, 1, sizeof (ChunkBlocks));
+			chunks.push_back (chunk);
+		}
+
+		std::vector<size_t> order (chunks.size ());
+		std::iota (order.begin (), order.end (), 0);
+		std::shuffle (order.begin (), order.end (), std::mt19937 (42));
+
+		TLBCounter counter;
+		uint64_t sum = 0;
+		auto start = bench::Clock::now ();
+		counter.start ();
+		for (size_t pass = 0; pass < passes; pass++) {
+			for (size_t i : order) {
+				//One block per cache line, as a culling or render pass reads them
+				const ChunkBlocks& chunk = *chunks[i];
+				for (size_t b = 0; b < 16 * 16 * 16; b += 16) {
+					sum += chunk.blocks[b];
+				}
+			}
+		}
+		long long misses = counter.stop ();
+		result.operations = passes * order.size ();
+		result.ns_per_op = bench::elapsedNs (start, bench::Clock::now ()) / std::max<size_t> (1, result.operations);
+		s_sink = sum;
+
+		report.add (result);
+		if (misses >= 0) std::printf ("%-20s %-22s dTLB misses %lld\n", result.benchmark.c_str (), result.allocator.c_str (), misses);
+
+		for (auto& chunk : chunks) {
+			allocator::deallocateDelete<ChunkBlocks> (alloc, chunk);
+		}
+	}
+}
+
+void bench::hugePages (Report& report, size_t scale) {
+	//256 MB of chunks, far beyond what the TLB covers with 4 KB pages
+	const size_t chunk_count = 16 * 1024;
+
+	scanChunks (report, false, chunk_count, scale);
+	scanChunks (report, true, chunk_count, scale);
+}
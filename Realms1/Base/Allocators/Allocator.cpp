@@ -1,12 +1,30 @@
 #include "Allocator.h"
 #include <cassert>
 
-Allocator::Allocator(void*& start,const size_t& size) :_start(start), _size (size), _used_memory (0), _num_allocations (0) {
+#ifdef RLMS_ALLOCATOR_STATS
+Allocator* Allocator::s_registered = nullptr;
+std::mutex Allocator::s_registry_mutex;
+#endif
+
+Allocator::Allocator(void*& start,const size_t& size) :_start(start), _size (size), _used_memory (0), _num_allocations (0), _tag (AllocTag::Untagged) {
+	assert (size > 0);
+#ifdef RLMS_ALLOCATOR_STATS
+	registerSelf ();
+#endif
+}
+
+Allocator::Allocator (void* const& start, const size_t& size) :_start (start), _size (size), _used_memory (0), _num_allocations (0), _tag (AllocTag::Untagged) {
 	assert (size > 0);
+#ifdef RLMS_ALLOCATOR_STATS
+	registerSelf ();
+#endif
 }
 
 Allocator::~Allocator () {
 	//_size = 0;
+#ifdef RLMS_ALLOCATOR_STATS
+	unregisterSelf ();
+#endif
 }
 
 void* Allocator::getStart () const {
@@ -23,4 +41,48 @@ size_t Allocator::getUsedMemory () const {
 
 size_t Allocator::getNumAllocations () const {
 	return _num_allocations;
-}
\ No newline at end of file
+}
+
+size_t Allocator::getLargestFreeBlock () const {
+	return _size - _used_memory;
+}
+
+float Allocator::getFragmentation () const {
+	size_t free_memory = getSize () - getUsedMemory ();
+	if (free_memory == 0) return 0.f;
+
+	return 1.f - static_cast<float>(getLargestFreeBlock ()) / static_cast<float>(free_memory);
+}
+
+void Allocator::setTag (AllocTag tag) {
+	_tag = tag;
+}
+
+AllocTag Allocator::getTag () const {
+	return _tag;
+}
+
+#ifdef RLMS_ALLOCATOR_STATS
+const AllocatorStats& Allocator::getStats () const {
+	return _stats;
+}
+
+void Allocator::resetStats () {
+	_stats.reset ();
+}
+
+void Allocator::registerSelf () {
+	std::lock_guard<std::mutex> lock (s_registry_mutex);
+	_prev_registered = nullptr;
+	_next_registered = s_registered;
+	if (s_registered != nullptr) s_registered->_prev_registered = this;
+	s_registered = this;
+}
+
+void Allocator::unregisterSelf () {
+	std::lock_guard<std::mutex> lock (s_registry_mutex);
+	if (_prev_registered != nullptr) _prev_registered->_next_registered = _next_registered;
+	if (_next_registered != nullptr) _next_registered->_prev_registered = _prev_registered;
+	if (s_registered == this) s_registered = _next_registered;
+}
+#endif
@@ -1,5 +1,21 @@
 #pragma once
+#include "../../_Preprocess.h"
+#include "AllocatorStats.h"
+#include "AllocatorGuard.h"
+
+#include <cassert>
 #include <cstdint>
+#include <new>
+#include <utility>
+
+#ifdef RLMS_ALLOCATOR_STATS
+#include <mutex>
+#endif
+
+namespace rlms {
+	class Logger;
+}
+
 static const uint8_t DEFAULT_ALIGNMENT = 8;
 
 class Allocator {
@@ -10,22 +26,90 @@ public:
 	virtual void* allocate (size_t size, uint8_t alignment = DEFAULT_ALIGNMENT) = 0;
 	virtual void deallocate (void*&& p) = 0;
 
-	void* getStart () const;
-	size_t getSize () const;
-	size_t getUsedMemory () const;
-	size_t getNumAllocations () const;
+	//Range the allocator hands memory out of, forwarded by front-ends so it follows a parent that grows
+	virtual void* getStart () const;
+	virtual size_t getSize () const;
+	virtual size_t getUsedMemory () const;
+	virtual size_t getNumAllocations () const;
+
+	//Largest contiguous free block, headers and alignment not deducted
+	virtual size_t getLargestFreeBlock () const;
+	//0 when the free memory is one block, close to 1 when it is scattered in small ones
+	float getFragmentation () const;
+
+	void setTag (AllocTag tag);
+	AllocTag getTag () const;
+
+#ifdef RLMS_ALLOCATOR_STATS
+	const AllocatorStats& getStats () const;
+	void resetStats ();
+
+	//Walk every living allocator, under the registry lock
+	template <class F> static void ForEach (F f);
+#endif
 
 protected:
+	//For allocators built on top of another one, where start is not an lvalue of their own
+	Allocator (void* const& start, const size_t& size);
+
 	Allocator (const Allocator&) = default;
 	Allocator& operator=(Allocator&) = default;
 
+	//Call after the counters are updated, compiled out without RLMS_ALLOCATOR_STATS
+	void recordAllocation (size_t size);
+
 	void* _start;
 	size_t _size;
 	size_t _used_memory;
 	size_t _num_allocations;
+	AllocTag _tag;
+
+#ifdef RLMS_ALLOCATOR_STATS
+	AllocatorStats _stats;
+
+private:
+	void registerSelf ();
+	void unregisterSelf ();
+
+	Allocator* _prev_registered;
+	Allocator* _next_registered;
+
+	static Allocator* s_registered;
+	static std::mutex s_registry_mutex;
+#endif
 };
 
+#ifdef RLMS_ALLOCATOR_STATS
+inline void Allocator::recordAllocation (size_t size) {
+	_stats.record (size, _used_memory, _num_allocations);
+}
+
+template <class F> void Allocator::ForEach (F f) {
+	std::lock_guard<std::mutex> lock (s_registry_mutex);
+	for (Allocator* a = s_registered; a != nullptr; a = a->_next_registered) {
+		f (*a);
+	}
+}
+#else
+inline void Allocator::recordAllocation (size_t) {}
+#endif
+
+namespace allocator {
+	//Usage, peaks, histogram and fragmentation of one allocator
+	void logStats (const Allocator& alloc, rlms::Logger& logger);
+	//Every living allocator followed by the memory used per tag
+	void logAllStats (rlms::Logger& logger);
+}
+
 namespace allocator {
+#ifdef RLMS_ALLOCATOR_GUARDS
+	//Array length header preceded by a canary, 32 bits so it fits size_t on every target
+	static const size_t ARRAY_HEADER_SIZE = 2 * sizeof (size_t);
+	static const size_t ARRAY_CANARY = 0xA77A7C0Du;
+#else
+	static const size_t ARRAY_HEADER_SIZE = sizeof (size_t);
+#endif
+
 	template <class T, class... Args>
 	T* allocateNew (Allocator& allocator, Args&& ... args) {
 		return new (allocator.allocate (sizeof (T), __alignof(T))) T (std::forward<Args> (args)...);
@@ -42,15 +126,18 @@ namespace allocator {
 	T* allocateArray (Allocator& allocator, size_t length) {
 		//assert (length != 0);
 
-		uint8_t header_size = sizeof (size_t) / sizeof (T);
+		uint8_t header_size = ARRAY_HEADER_SIZE / sizeof (T);
 
-		if (sizeof (size_t) % sizeof (T) > 0)
+		if (ARRAY_HEADER_SIZE % sizeof (T) > 0)
 			header_size += 1;
 
 		//Allocate extra space to store array length in the bytes before the array
 		T* p = static_cast<T*>(allocator.allocate (sizeof (T) * (length + header_size), __alignof(T))) + header_size;
 
-		*((static_cast<size_t*>(p)) - 1) = length;
+		*(reinterpret_cast<size_t*>(p) - 1) = length;
+#ifdef RLMS_ALLOCATOR_GUARDS
+		*(reinterpret_cast<size_t*>(p) - 2) = ARRAY_CANARY;
+#endif
 
 		for (size_t i = 0; i < length; i++)
 			new (&p[i]) T;
@@ -62,33 +149,39 @@ namespace allocator {
 	T* allocateArrayNoConstruct (Allocator& allocator, size_t length) {
 		//assert (length != 0);
 
-		uint8_t header_size = sizeof (size_t) / sizeof (T);
+		uint8_t header_size = ARRAY_HEADER_SIZE / sizeof (T);
 
-		if (sizeof (size_t) % sizeof (T) > 0)
+		if (ARRAY_HEADER_SIZE % sizeof (T) > 0)
 			header_size += 1;
 
 		//Allocate extra space to store array length in the bytes before the array
 		T* p = static_cast<T*>(allocator.allocate (sizeof (T) * (length + header_size), __alignof(T))) + header_size;
 
-		*(static_cast<size_t*>(p) - 1) = length;
+		*(reinterpret_cast<size_t*>(p) - 1) = length;
+#ifdef RLMS_ALLOCATOR_GUARDS
+		*(reinterpret_cast<size_t*>(p) - 2) = ARRAY_CANARY;
+#endif
 
 		return p;
 	}
 
 	template <class T>
 	void deallocateArray (Allocator& allocator, T* array) {
-		ASSERT (array != nullptr);
+		assert (array != nullptr);
+#ifdef RLMS_ALLOCATOR_GUARDS
+		assert (*(reinterpret_cast<size_t*>(array) - 2) == ARRAY_CANARY && "Array header overwritten");
+#endif
 
-		size_t length = *(static_cast<size_t*>(array) - 1);
+		size_t length = *(reinterpret_cast<size_t*>(array) - 1);
 
 		//should be reverse order
 		for (size_t i = 0; i < length; i++)
 			array[i].~T ();
 
 		//Calculate how much extra memory was allocated to store the length before the array
-		uint8_t header_size = sizeof (size_t) / sizeof (T);
+		uint8_t header_size = ARRAY_HEADER_SIZE / sizeof (T);
 
-		if (sizeof (size_t) % sizeof (T) > 0)
+		if (ARRAY_HEADER_SIZE % sizeof (T) > 0)
 			header_size += 1;
 
 		allocator.deallocate (array - header_size);
@@ -96,12 +189,15 @@ namespace allocator {
 
 	template <class T>
 	void deallocateArrayNoDestruct (Allocator& allocator, T* array) {
-		ASSERT (array != nullptr);
+		assert (array != nullptr);
+#ifdef RLMS_ALLOCATOR_GUARDS
+		assert (*(reinterpret_cast<size_t*>(array) - 2) == ARRAY_CANARY && "Array header overwritten");
+#endif
 
 		//Calculate how much extra memory was allocated to store the length before the array
-		uint8_t header_size = sizeof (size_t) / sizeof (T);
+		uint8_t header_size = ARRAY_HEADER_SIZE / sizeof (T);
 
-		if (sizeof (size_t) % sizeof (T) > 0)
+		if (ARRAY_HEADER_SIZE % sizeof (T) > 0)
 			header_size += 1;
 
 		allocator.deallocate (array - header_size);
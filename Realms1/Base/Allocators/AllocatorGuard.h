@@ -0,0 +1,78 @@
+#pragma once
+#include "../../_Preprocess.h"
+
+#ifdef RLMS_ALLOCATOR_GUARDS
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+//Debug only wrapping of allocations : [front canary][payload][back canary].
+//Payloads are filled on allocation, the whole block is poisoned on free so a second free is caught.
+namespace allocatorGuard {
+	static const uint32_t FRONT_CANARY = 0xF00DFACE;
+	static const uint32_t BACK_CANARY = 0xDEADC0DE;
+	static const uint8_t ALLOCATED_BYTE = 0xCD;
+	static const uint8_t POISON_BYTE = 0xDD;
+	static const uint32_t POISON_WORD = 0xDDDDDDDD;
+
+	static const size_t BACK_SIZE = sizeof (uint32_t);
+
+	//Sits right before the payload
+	struct GuardHeader {
+		size_t size;
+		uint32_t front_size;
+		uint32_t canary;
+	};
+
+	//Front guard rounded to the alignment so the payload keeps it
+	inline size_t frontSize (uint8_t alignment) {
+		return alignment > sizeof (GuardHeader) ? alignment : sizeof (GuardHeader);
+	}
+
+	//Back canary plus padding keeping the block a multiple of a pointer, for the allocators' own headers
+	inline size_t guardedSize (size_t size, uint8_t alignment) {
+		size_t back_end = (size + BACK_SIZE + sizeof (void*) - 1) & ~(sizeof (void*) - 1);
+		return frontSize (alignment) + back_end;
+	}
+
+	//Write the canaries around a block of guardedSize bytes, returns the payload
+	inline void* guard (void* block, size_t size, uint8_t alignment) {
+		size_t front_size = frontSize (alignment);
+		uint8_t* p = static_cast<uint8_t*>(block) + front_size;
+
+		GuardHeader* header = reinterpret_cast<GuardHeader*>(p - sizeof (GuardHeader));
+		header->size = size;
+		header->front_size = static_cast<uint32_t>(front_size);
+		header->canary = FRONT_CANARY;
+
+		memset (p, ALLOCATED_BYTE, size);
+		memcpy (p + size, &BACK_CANARY, BACK_SIZE);
+
+		return p;
+	}
+
+	//Check the canaries of a payload, returns the block start and its guarded size
+	inline void* unguard (void* p, size_t& guarded_size) {
+		GuardHeader* header = reinterpret_cast<GuardHeader*>(static_cast<uint8_t*>(p) - sizeof (GuardHeader));
+
+		assert (header->canary != POISON_WORD && "Double free");
+		assert (header->canary == FRONT_CANARY && "Front canary overwritten (underrun or foreign pointer)");
+
+		uint32_t back;
+		memcpy (&back, static_cast<uint8_t*>(p) + header->size, BACK_SIZE);
+		assert (back == BACK_CANARY && "Back canary overwritten (overrun)");
+
+		guarded_size = guardedSize (header->size, static_cast<uint8_t>(header->front_size > sizeof (GuardHeader) ? header->front_size : 1));
+		return static_cast<uint8_t*>(p) - header->front_size;
+	}
+
+	inline void poison (void* p, size_t size) {
+		memset (p, POISON_BYTE, size);
+	}
+
+	//Foreign pointer check
+	inline bool owns (const void* start, size_t size, const void* p) {
+		return p >= start && p < static_cast<const uint8_t*>(start) + size;
+	}
+}
+#endif // RLMS_ALLOCATOR_GUARDS
@@ -0,0 +1,51 @@
+#include "AllocatorStats.h"
+#include "Allocator.h"
+#include "../Logging/Logger.h"
+
+const char* allocTagName (AllocTag tag) {
+	switch (tag) {
+	case AllocTag::Entity: return "Entity";
+	case AllocTag::Component: return "Component";
+	case AllocTag::System: return "System";
+	case AllocTag::Chunk: return "Chunk";
+	case AllocTag::Mesh: return "Mesh";
+	case AllocTag::Event: return "Event";
+	case AllocTag::Frame: return "Frame";
+	default: return "Untagged";
+	}
+}
+
+void allocator::logStats (const Allocator& alloc, rlms::Logger& logger) {
+	logger.tag (rlms::LogTags::Info) << allocTagName (alloc.getTag ()) << " allocator at " << alloc.getStart ()
+		<< " : " << alloc.getUsedMemory () << " / " << alloc.getSize () << " bytes in " << alloc.getNumAllocations () << " allocations"
+		<< ", largest free block " << alloc.getLargestFreeBlock () << ", fragmentation " << alloc.getFragmentation () << '\n';
+
+#ifdef RLMS_ALLOCATOR_STATS
+	const AllocatorStats& stats = alloc.getStats ();
+	logger.tag (rlms::LogTags::Info) << "    peak " << stats.peak_used_memory << " bytes, " << stats.peak_num_allocations << " allocations, " << stats.total_allocations << " total" << '\n';
+
+	for (size_t i = 0; i < AllocatorStats::HISTOGRAM_BUCKETS; i++) {
+		if (stats.histogram[i] == 0) continue;
+		logger.tag (rlms::LogTags::Info) << "    " << (static_cast<size_t>(1) << i) << (i + 1 == AllocatorStats::HISTOGRAM_BUCKETS ? "+" : "") << " bytes : " << stats.histogram[i] << '\n';
+	}
+#endif
+}
+
+void allocator::logAllStats (rlms::Logger& logger) {
+#ifdef RLMS_ALLOCATOR_STATS
+	size_t used_per_tag[static_cast<size_t>(AllocTag::Count)] = {};
+	size_t peak_per_tag[static_cast<size_t>(AllocTag::Count)] = {};
+
+	Allocator::ForEach ([&logger, &used_per_tag, &peak_per_tag] (const Allocator& alloc) {
+		logStats (alloc, logger);
+		used_per_tag[static_cast<size_t>(alloc.getTag ())] += alloc.getUsedMemory ();
+		peak_per_tag[static_cast<size_t>(alloc.getTag ())] += alloc.getStats ().peak_used_memory;
+	});
+
+	for (size_t i = 0; i < static_cast<size_t>(AllocTag::Count); i++) {
+		logger.tag (rlms::LogTags::Info) << allocTagName (static_cast<AllocTag>(i)) << " : " << used_per_tag[i] << " bytes used, " << peak_per_tag[i] << " bytes peak" << '\n';
+	}
+#else
+	logger.tag (rlms::LogTags::Warning) << "Allocator stats are compiled out (RLMS_ALLOCATOR_STATS)." << '\n';
+#endif
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+//Subsystem owning an allocator's memory, used to group usage in the stats dump
+enum class AllocTag : uint8_t {
+	Untagged,
+	Entity,
+	Component,
+	System,
+	Chunk,
+	Mesh,
+	Event,
+	Frame,
+	Count
+};
+
+const char* allocTagName (AllocTag tag);
+
+//Counters recorded by every allocator when RLMS_ALLOCATOR_STATS is defined
+struct AllocatorStats {
+	//Bucket i counts requests of [2^i, 2^(i+1)) bytes, the last one everything above
+	static const size_t HISTOGRAM_BUCKETS = 16;
+
+	size_t peak_used_memory;
+	size_t peak_num_allocations;
+	size_t total_allocations;
+	size_t histogram[HISTOGRAM_BUCKETS];
+
+	AllocatorStats () {
+		reset ();
+	}
+
+	void record (size_t size, size_t used_memory, size_t num_allocations) {
+		if (used_memory > peak_used_memory) peak_used_memory = used_memory;
+		if (num_allocations > peak_num_allocations) peak_num_allocations = num_allocations;
+
+		total_allocations++;
+		histogram[bucketOf (size)]++;
+	}
+
+	void reset () {
+		peak_used_memory = 0;
+		peak_num_allocations = 0;
+		total_allocations = 0;
+		for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+			histogram[i] = 0;
+		}
+	}
+
+	static size_t bucketOf (size_t size) {
+		size_t bucket = 0;
+		while (size > 1 && bucket < HISTOGRAM_BUCKETS - 1) {
+			size >>= 1;
+			bucket++;
+		}
+		return bucket;
+	}
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include "Allocator.h"
+
+#include <map>
+#include <new>
+#include <vector>
+
+namespace rlms {
+	namespace arena {
+		//Arena picked by default constructed ArenaAllocators of the calling thread, the global heap when null
+		inline Allocator*& current () {
+			static thread_local Allocator* arena = nullptr;
+			return arena;
+		}
+	}
+
+	inline Allocator* GetDefaultArena () {
+		return arena::current ();
+	}
+
+	inline void SetDefaultArena (Allocator* arena) {
+		arena::current () = arena;
+	}
+
+	//Sets the default arena for the lifetime of the scope
+	class ArenaScope {
+	public:
+		ArenaScope (Allocator* arena) : _previous (GetDefaultArena ()) {
+			SetDefaultArena (arena);
+		}
+
+		~ArenaScope () {
+			SetDefaultArena (_previous);
+		}
+
+	private:
+		ArenaScope (const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+		Allocator* _previous;
+	};
+
+	//STL allocator over an engine Allocator, so containers are accounted in our arenas.
+	//The arena is captured on construction and follows the container on copy, move and swap.
+	template <class T>
+	class ArenaAllocator {
+	public:
+		using value_type = T;
+
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		ArenaAllocator () noexcept : _arena (GetDefaultArena ()) {}
+		ArenaAllocator (Allocator* arena) noexcept : _arena (arena) {}
+		template <class U> ArenaAllocator (const ArenaAllocator<U>& other) noexcept : _arena (other.arena ()) {}
+
+		T* allocate (size_t n) {
+			if (_arena == nullptr) {
+				return static_cast<T*>(::operator new (n * sizeof (T)));
+			}
+
+			void* p = _arena->allocate (n * sizeof (T), __alignof(T));
+			if (p == nullptr) throw std::bad_alloc ();
+			return static_cast<T*>(p);
+		}
+
+		void deallocate (T* p, size_t) noexcept {
+			if (_arena == nullptr) {
+				::operator delete (p);
+				return;
+			}
+
+			_arena->deallocate (p);
+		}
+
+		Allocator* arena () const noexcept {
+			return _arena;
+		}
+
+	private:
+		Allocator* _arena;
+	};
+
+	template <class T, class U> inline bool operator== (const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+		return a.arena () == b.arena ();
+	}
+
+	template <class T, class U> inline bool operator!= (const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+		return a.arena () != b.arena ();
+	}
+
+	template <class T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+	template <class K, class V, class Compare = std::less<K>> using ArenaMap = std::map<K, V, Compare, ArenaAllocator<std::pair<const K, V>>>;
+}
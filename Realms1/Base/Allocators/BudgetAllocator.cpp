@@ -0,0 +1,162 @@
+#include "BudgetAllocator.h"
+#include "../Logging/Logger.h"
+
+#include <cassert>
+
+BudgetAllocator::BudgetAllocator (const char* name, Allocator* const& arena, size_t limit) :
+	BudgetAllocator (name, arena, limit, nullptr, false) {}
+
+BudgetAllocator::BudgetAllocator (const char* name, Allocator* const& arena, size_t limit, BudgetAllocator* parent, bool overflow) :
+	Allocator (arena->getStart (), limit), _name (name), _arena (arena), _limit (limit), _overflow (overflow),
+	_overflow_memory (0), _overflow_allocations (0), _peak_memory (0), _parent (parent), _first_child (nullptr), _next_sibling (nullptr) {
+	assert (!overflow || parent != nullptr);
+
+	if (_parent != nullptr) {
+		_next_sibling = _parent->_first_child;
+		_parent->_first_child = this;
+	}
+	updatePeak ();
+}
+
+BudgetAllocator::~BudgetAllocator () {
+	assert (_overflow_allocations == 0 && "Overflowed memory not given back");
+
+	if (_parent != nullptr) {
+		BudgetAllocator** link = &_parent->_first_child;
+		while (*link != this) link = &(*link)->_next_sibling;
+		*link = _next_sibling;
+	}
+
+	//Children outliving their parent become roots
+	for (BudgetAllocator* child = _first_child; child != nullptr;) {
+		BudgetAllocator* next = child->_next_sibling;
+		child->_parent = nullptr;
+		child->_next_sibling = nullptr;
+		child->_overflow = false;
+		child = next;
+	}
+
+	_arena = nullptr;
+}
+
+void* BudgetAllocator::allocate (size_t size, uint8_t alignment) {
+	assert (size != 0 && alignment != 0);
+
+	//The limit caps the arena, overflowed memory is counted against the parent's
+	void* p = nullptr;
+	if (_arena->getUsedMemory () + size <= _limit) {
+		p = _arena->allocate (size, alignment);
+	}
+
+	if (p == nullptr && _overflow) {
+		p = allocateOverflow (size, alignment);
+	}
+	if (p == nullptr) return nullptr;
+
+	_used_memory = getUsedMemory ();
+	_num_allocations = getNumAllocations ();
+	recordAllocation (size);
+	updatePeak ();
+
+	return p;
+}
+
+void BudgetAllocator::deallocate (void*&& p) {
+	assert (p != nullptr);
+
+	if (ownsInArena (p)) {
+		_arena->deallocate (std::move (p));
+	} else {
+		OverflowHeader* header = (OverflowHeader*)pointerMath::subtract (p, sizeof (OverflowHeader));
+		assert (_overflow_allocations > 0 && "Pointer not from this budget");
+
+		_overflow_memory -= header->size;
+		_overflow_allocations--;
+		_parent->deallocate (pointerMath::subtract (p, header->adjustment));
+	}
+
+	_used_memory = getUsedMemory ();
+	_num_allocations = getNumAllocations ();
+	p = nullptr;
+}
+
+size_t BudgetAllocator::getUsedMemory () const {
+	return _arena->getUsedMemory () + _overflow_memory;
+}
+
+size_t BudgetAllocator::getNumAllocations () const {
+	return _arena->getNumAllocations () + _overflow_allocations;
+}
+
+size_t BudgetAllocator::getLargestFreeBlock () const {
+	size_t free_memory = getFreeMemory ();
+	size_t largest = _arena->getLargestFreeBlock ();
+	return largest < free_memory ? largest : free_memory;
+}
+
+const char* BudgetAllocator::getName () const {
+	return _name;
+}
+
+size_t BudgetAllocator::getLimit () const {
+	return _limit;
+}
+
+size_t BudgetAllocator::getPeakMemory () const {
+	updatePeak ();
+	return _peak_memory;
+}
+
+size_t BudgetAllocator::getFreeMemory () const {
+	size_t used = getUsedMemory ();
+	return used < _limit ? _limit - used : 0;
+}
+
+size_t BudgetAllocator::getOverflowMemory () const {
+	return _overflow_memory;
+}
+
+Allocator* BudgetAllocator::getArena () const {
+	return _arena;
+}
+
+BudgetAllocator* BudgetAllocator::getParent () const {
+	return _parent;
+}
+
+void* BudgetAllocator::allocateOverflow (size_t size, uint8_t alignment) {
+	//Header rounded to the alignment so the returned address stays aligned, as in ThreadCacheAllocator
+	size_t adjustment = alignment > sizeof (OverflowHeader) ? alignment : sizeof (OverflowHeader);
+	uint8_t parent_alignment = alignment > DEFAULT_ALIGNMENT ? alignment : DEFAULT_ALIGNMENT;
+
+	void* raw = _parent->allocate (size + adjustment, parent_alignment);
+	if (raw == nullptr) return nullptr;
+
+	void* p = pointerMath::add (raw, adjustment);
+	OverflowHeader* header = (OverflowHeader*)pointerMath::subtract (p, sizeof (OverflowHeader));
+	header->size = size + adjustment;
+	header->adjustment = adjustment;
+
+	_overflow_memory += header->size;
+	_overflow_allocations++;
+
+	return p;
+}
+
+bool BudgetAllocator::ownsInArena (void* p) const {
+	return p >= _arena->getStart () && p < pointerMath::add (_arena->getStart (), _arena->getSize ());
+}
+
+void BudgetAllocator::updatePeak () const {
+	size_t used = getUsedMemory ();
+	if (used > _peak_memory) _peak_memory = used;
+}
+
+void allocator::logBudget (const BudgetAllocator& budget, rlms::Logger& logger, size_t depth) {
+	logger.tag (rlms::LogTags::Info) << std::string (2 * depth, ' ') << budget.getName () << " : " << budget.getUsedMemory () << " / " << budget.getLimit ()
+		<< " bytes, peak " << budget.getPeakMemory () << ", free " << budget.getFreeMemory () << ", overflowed " << budget.getOverflowMemory () << '\n';
+
+	budget.forEachChild ([&logger, depth] (const BudgetAllocator& child) {
+		logBudget (child, logger, depth + 1);
+	});
+}
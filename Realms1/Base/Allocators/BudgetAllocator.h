@@ -0,0 +1,73 @@
+#pragma once
+#include "Allocator.h"
+
+//Node of a memory budget tree : wraps the arena of a subsystem, caps it to a limit and reports it under its parent.
+//Usage is read from the arena, so memory taken from it directly is accounted for too.
+//With overflow, requests the arena can't serve are taken from the parent, within the parent's own limit.
+//Not thread-safe, like the arenas it wraps.
+class BudgetAllocator : public Allocator {
+public:
+	//Root of a tree
+	BudgetAllocator (const char* name, Allocator* const& arena, size_t limit);
+	BudgetAllocator (const char* name, Allocator* const& arena, size_t limit, BudgetAllocator* parent, bool overflow = false);
+	~BudgetAllocator ();
+
+	void* allocate (size_t size, uint8_t alignment = DEFAULT_ALIGNMENT) override;
+	void deallocate (void*&& p) override;
+
+	//Arena usage and what overflowed to the parent
+	size_t getUsedMemory () const override;
+	size_t getNumAllocations () const override;
+	size_t getLargestFreeBlock () const override;
+
+	const char* getName () const;
+	size_t getLimit () const;
+	size_t getPeakMemory () const;
+	size_t getFreeMemory () const;
+	size_t getOverflowMemory () const;
+
+	Allocator* getArena () const;
+	BudgetAllocator* getParent () const;
+
+	template <class F> void forEachChild (F f) const;
+
+private:
+	//Stored before overflowed blocks
+	struct OverflowHeader {
+		size_t size;
+		size_t adjustment;
+	};
+
+	//Prevent copies because it might cause errors
+	BudgetAllocator (const BudgetAllocator&);
+	BudgetAllocator& operator=(const BudgetAllocator&) = delete;
+
+	void* allocateOverflow (size_t size, uint8_t alignment);
+	bool ownsInArena (void* p) const;
+	void updatePeak () const;
+
+	const char* _name;
+	Allocator* _arena;
+	size_t _limit;
+	bool _overflow;
+
+	size_t _overflow_memory;
+	size_t _overflow_allocations;
+	//Refreshed whenever the usage is looked at
+	mutable size_t _peak_memory;
+
+	BudgetAllocator* _parent;
+	BudgetAllocator* _first_child;
+	BudgetAllocator* _next_sibling;
+};
+
+template <class F> void BudgetAllocator::forEachChild (F f) const {
+	for (const BudgetAllocator* child = _first_child; child != nullptr; child = child->_next_sibling) {
+		f (*child);
+	}
+}
+
+namespace allocator {
+	//Used, peak, free and overflowed memory of a budget and everything under it
+	void logBudget (const BudgetAllocator& budget, rlms::Logger& logger, size_t depth = 0);
+}
@@ -0,0 +1,77 @@
+#include "ConcurrentPoolAllocator.h"
+
+#include <cassert>
+
+ConcurrentPoolAllocator::ConcurrentPoolAllocator (size_t objectSize, uint8_t objectAlignment, size_t size, void* mem) : Allocator (mem, size), _objectSize (objectSize), _objectAlignment (objectAlignment), _head (0), _allocated (0) {
+	assert (objectSize >= sizeof (std::atomic<uint32_t>));
+
+	//Calculate adjustment needed to keep object correctly aligned
+	uint8_t adjustment = pointerMath::alignForwardAdjustment (mem, objectAlignment);
+	_first = pointerMath::add (mem, adjustment);
+	_numObjects = (size - adjustment) / objectSize;
+	assert (_numObjects > 0 && _numObjects < UINT32_MAX);
+
+	//Initialize free blocks list
+	for (uint32_t i = 1; i <= _numObjects; i++) {
+		uint32_t next = (i == _numObjects) ? NULL_INDEX : i + 1;
+		new (&nextOf (i)) std::atomic<uint32_t> (next);
+	}
+
+	_head.store (pack (1, 0));
+}
+
+ConcurrentPoolAllocator::~ConcurrentPoolAllocator () {
+	_first = nullptr;
+}
+
+void* ConcurrentPoolAllocator::allocate (size_t size, uint8_t alignment) {
+	assert (size <= _objectSize && alignment <= _objectAlignment);
+
+	uint64_t head = _head.load (std::memory_order_acquire);
+	uint64_t new_head;
+
+	do {
+		if (indexOf (head) == NULL_INDEX) return nullptr;
+
+		//The block may be taken by another thread meanwhile, the tag will then make the exchange fail
+		uint32_t next = nextOf (indexOf (head)).load (std::memory_order_relaxed);
+		new_head = pack (next, tagOf (head) + 1);
+	} while (!_head.compare_exchange_weak (head, new_head, std::memory_order_acquire, std::memory_order_acquire));
+
+	_allocated.fetch_add (1, std::memory_order_relaxed);
+
+	return pointerMath::add (_first, (indexOf (head) - 1) * _objectSize);
+}
+
+void ConcurrentPoolAllocator::deallocate (void*&& p) {
+	assert (p != nullptr);
+	assert (p >= _first && p < pointerMath::add (_first, _numObjects * _objectSize));
+
+	uint32_t index = static_cast<uint32_t>(((uintptr_t)p - (uintptr_t)_first) / _objectSize) + 1;
+	std::atomic<uint32_t>& next = nextOf (index);
+
+	uint64_t head = _head.load (std::memory_order_relaxed);
+	do {
+		next.store (indexOf (head), std::memory_order_relaxed);
+	} while (!_head.compare_exchange_weak (head, pack (index, tagOf (head) + 1), std::memory_order_release, std::memory_order_relaxed));
+
+	_allocated.fetch_sub (1, std::memory_order_relaxed);
+
+	p = nullptr;
+}
+
+size_t ConcurrentPoolAllocator::getUsedMemory () const {
+	return _allocated.load (std::memory_order_relaxed) * _objectSize;
+}
+
+size_t ConcurrentPoolAllocator::getNumAllocations () const {
+	return _allocated.load (std::memory_order_relaxed);
+}
+
+size_t ConcurrentPoolAllocator::getLargestFreeBlock () const {
+	return indexOf (_head.load (std::memory_order_relaxed)) != NULL_INDEX ? _objectSize : 0;
+}
+
+std::atomic<uint32_t>& ConcurrentPoolAllocator::nextOf (uint32_t index) const {
+	return *(std::atomic<uint32_t>*)pointerMath::add (_first, (index - 1) * _objectSize);
+}
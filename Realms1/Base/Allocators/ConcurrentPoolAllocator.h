@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Allocator.h"
+
+#include <atomic>
+
+//Thread-safe PoolAllocator : the free list is a lock-free stack of block indices.
+//The head packs a modification tag next to the index so a block popped and pushed back
+//between a read and its compare-exchange (ABA) is detected.
+//Only the atomic counters are kept, the allocator stats are not recorded here.
+class ConcurrentPoolAllocator : public Allocator {
+public:
+
+	ConcurrentPoolAllocator (size_t objectSize, uint8_t objectAlignment, size_t size, void* mem);
+	~ConcurrentPoolAllocator ();
+	void* allocate (size_t size, uint8_t alignment) override;
+	void deallocate (void*&& p) override;
+
+	size_t getUsedMemory () const override;
+	size_t getNumAllocations () const override;
+	size_t getLargestFreeBlock () const override;
+
+private:
+
+	//Index 0 marks the end of the list, block i is stored as i + 1
+	static const uint32_t NULL_INDEX = 0;
+
+	//Prevent copies because it might cause errors
+	ConcurrentPoolAllocator (const ConcurrentPoolAllocator&);
+	ConcurrentPoolAllocator& operator=(const ConcurrentPoolAllocator&) = delete;
+
+	std::atomic<uint32_t>& nextOf (uint32_t index) const;
+
+	static uint64_t pack (uint32_t index, uint32_t tag) {
+		return (static_cast<uint64_t>(tag) << 32) | index;
+	}
+
+	static uint32_t indexOf (uint64_t head) {
+		return static_cast<uint32_t>(head);
+	}
+
+	static uint32_t tagOf (uint64_t head) {
+		return static_cast<uint32_t>(head >> 32);
+	}
+
+	size_t _objectSize;
+	uint8_t _objectAlignment;
+
+	void* _first;
+	size_t _numObjects;
+
+	std::atomic<uint64_t> _head;
+	std::atomic<size_t> _allocated;
+};
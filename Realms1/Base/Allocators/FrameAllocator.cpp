@@ -0,0 +1,52 @@
+#include "FrameAllocator.h"
+#include <cassert>
+
+FrameAllocator::FrameAllocator (void* start, const size_t size) : Allocator (start, size),
+	_buffer_a (start, size / 2),
+	_buffer_b (pointerMath::add (start, size / 2), size - size / 2),
+	_current (&_buffer_a), _previous (&_buffer_b), _frame (0) {
+	assert (size > 1);
+}
+
+FrameAllocator::~FrameAllocator () {
+	_current = nullptr;
+	_previous = nullptr;
+}
+
+void* FrameAllocator::allocate (size_t size, uint8_t alignment) {
+	assert (size != 0);
+
+	size_t used_before = _current->getUsedMemory ();
+	void* p = _current->allocate (size, alignment);
+	if (p == nullptr) return nullptr;
+
+	_used_memory += _current->getUsedMemory () - used_before;
+	_num_allocations++;
+	recordAllocation (size);
+
+	return p;
+}
+
+void FrameAllocator::deallocate (void*&& p) {
+	p = nullptr;
+}
+
+size_t FrameAllocator::getLargestFreeBlock () const {
+	return _current->getSize () - _current->getUsedMemory ();
+}
+
+void FrameAllocator::swap () {
+	LinearAllocator* next = _previous;
+
+	_used_memory -= next->getUsedMemory ();
+	_num_allocations -= next->getNumAllocations ();
+	next->clear ();
+
+	_previous = _current;
+	_current = next;
+	_frame++;
+}
+
+size_t FrameAllocator::getFrame () const {
+	return _frame;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "Allocator.h"
+#include "LinearAllocator.h"
+
+//Two LinearAllocators used in turn, one per frame or tick : swap() is called once per frame
+//and clears the buffer of two frames ago, so what was allocated in frame N stays valid during N+1.
+//Deallocation does nothing, memory only comes back on swap.
+class FrameAllocator : public Allocator {
+public:
+	FrameAllocator (void* start, const size_t size);
+	~FrameAllocator ();
+
+	void* allocate (size_t size, uint8_t alignment) override;
+	void deallocate (void*&& p) override;
+
+	size_t getLargestFreeBlock () const override;
+
+	//Start a new frame
+	void swap ();
+
+	//Frames swapped since creation
+	size_t getFrame () const;
+
+private:
+	//Prevent copies because it might cause errors
+	FrameAllocator (const FrameAllocator&);
+	FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+	LinearAllocator _buffer_a;
+	LinearAllocator _buffer_b;
+	LinearAllocator* _current;
+	LinearAllocator* _previous;
+	size_t _frame;
+};
@@ -14,6 +14,10 @@ FreeListAllocator::~FreeListAllocator () {
 
 void* FreeListAllocator::allocate (size_t size, uint8_t alignment) {
 	assert (size != 0 && alignment != 0);
+#ifdef RLMS_ALLOCATOR_GUARDS
+	const size_t user_size = size;
+	size = allocatorGuard::guardedSize (size, alignment);
+#endif
 	FreeBlock* prev_free_block = nullptr;
 	FreeBlock* free_block = _free_blocks;
 
@@ -59,10 +63,15 @@ void* FreeListAllocator::allocate (size_t size, uint8_t alignment) {
 		header->adjustment = adjustment;
 		_used_memory += total_size;
 		_num_allocations++;
+		recordAllocation (size);
 
 		assert (pointerMath::alignForwardAdjustment ((void*)aligned_address, alignment) == 0);
 
+#ifdef RLMS_ALLOCATOR_GUARDS
+		return allocatorGuard::guard ((void*)aligned_address, user_size, alignment);
+#else
 		return (void*)aligned_address;
+#endif
 	}
 
 	//ASSERT(false && "Couldn't find free block large enough!"); 
@@ -71,6 +80,12 @@ void* FreeListAllocator::allocate (size_t size, uint8_t alignment) {
 
 void FreeListAllocator::deallocate (void*&& p) {
 	assert (p != nullptr);
+#ifdef RLMS_ALLOCATOR_GUARDS
+	assert (allocatorGuard::owns (_start, _size, p) && "Pointer not from this allocator");
+	size_t guarded_size = 0;
+	p = allocatorGuard::unguard (p, guarded_size);
+	allocatorGuard::poison (p, guarded_size);
+#endif
 
 	AllocationHeader* header = (AllocationHeader*)pointerMath::subtract (p, sizeof (AllocationHeader));
 	uintptr_t  block_start = reinterpret_cast<uintptr_t>(p) - header->adjustment;
@@ -109,3 +124,11 @@ void FreeListAllocator::deallocate (void*&& p) {
 	_used_memory -= block_size;
 	p = nullptr;
 }
+
+size_t FreeListAllocator::getLargestFreeBlock () const {
+	size_t largest = 0;
+	for (FreeBlock* free_block = _free_blocks; free_block != nullptr; free_block = free_block->next) {
+		if (free_block->size > largest) largest = free_block->size;
+	}
+	return largest;
+}
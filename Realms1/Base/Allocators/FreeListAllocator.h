@@ -9,6 +9,8 @@ public:
 	void* allocate (size_t size, uint8_t alignment) override;
 	void deallocate (void*&& p) override;
 
+	size_t getLargestFreeBlock () const override;
+
 private:
 
 	struct AllocationHeader {
@@ -0,0 +1,64 @@
+#include "HandleTable.h"
+
+#include <cassert>
+
+const uint32_t HandleTable::NO_FREE;
+
+HandleTable::HandleTable () : _entries (), _free_head (NO_FREE), _count (0) {}
+
+HandleTable::~HandleTable () {
+	_free_head = NO_FREE;
+}
+
+Handle HandleTable::create (void* p) {
+	Handle handle;
+
+	if (_free_head != NO_FREE) {
+		handle.index = _free_head;
+		_free_head = _entries[handle.index].next_free;
+	} else {
+		assert (_entries.size () < NO_FREE && "Handle table full");
+		handle.index = static_cast<uint32_t>(_entries.size ());
+		_entries.push_back ({ nullptr, 1, NO_FREE });
+	}
+
+	Entry& entry = _entries[handle.index];
+	entry.pointer = p;
+	entry.next_free = NO_FREE;
+	handle.generation = entry.generation;
+
+	_count++;
+	return handle;
+}
+
+void HandleTable::destroy (const Handle& handle) {
+	assert (isValid (handle) && "Stale or null handle");
+
+	Entry& entry = _entries[handle.index];
+	entry.pointer = nullptr;
+
+	//Invalidate every copy of the handle, 0 is kept for null handles
+	entry.generation++;
+	if (entry.generation == 0) entry.generation = 1;
+
+	entry.next_free = _free_head;
+	_free_head = handle.index;
+	_count--;
+}
+
+void* HandleTable::get (const Handle& handle) const {
+	return isValid (handle) ? _entries[handle.index].pointer : nullptr;
+}
+
+bool HandleTable::isValid (const Handle& handle) const {
+	return !handle.isNull () && handle.index < _entries.size () && _entries[handle.index].generation == handle.generation && _entries[handle.index].pointer != nullptr;
+}
+
+void HandleTable::relocate (uint32_t index, void* p) {
+	assert (index < _entries.size () && _entries[index].pointer != nullptr);
+	_entries[index].pointer = p;
+}
+
+size_t HandleTable::getCount () const {
+	return _count;
+}
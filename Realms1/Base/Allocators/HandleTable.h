@@ -0,0 +1,60 @@
+#pragma once
+#include "ArenaAllocator.h"
+
+#include <cstdint>
+
+//Stable reference to something that can move : the index of a table slot and the generation it was created with.
+//A handle goes stale once its slot is released, even if the slot is reused.
+struct Handle {
+	uint32_t index = 0;
+	//0 is never given out, a default constructed handle is null
+	uint32_t generation = 0;
+
+	bool isNull () const {
+		return generation == 0;
+	}
+
+	bool operator== (const Handle& other) const {
+		return index == other.index && generation == other.generation;
+	}
+
+	bool operator!= (const Handle& other) const {
+		return !(*this == other);
+	}
+};
+
+//Maps handles to the current address of what they reference
+class HandleTable {
+public:
+	HandleTable ();
+	~HandleTable ();
+
+	Handle create (void* p);
+	void destroy (const Handle& handle);
+
+	//nullptr for null or stale handles
+	void* get (const Handle& handle) const;
+	bool isValid (const Handle& handle) const;
+
+	//Point a live slot to a new address, for whoever moved it
+	void relocate (uint32_t index, void* p);
+
+	size_t getCount () const;
+
+private:
+	struct Entry {
+		void* pointer;
+		uint32_t generation;
+		uint32_t next_free;
+	};
+
+	static const uint32_t NO_FREE = UINT32_MAX;
+
+	//Prevent copies because it might cause errors
+	HandleTable (const HandleTable&);
+	HandleTable& operator=(const HandleTable&) = delete;
+
+	rlms::ArenaVector<Entry> _entries;
+	uint32_t _free_head;
+	size_t _count;
+};
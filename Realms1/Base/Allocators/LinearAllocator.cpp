@@ -19,6 +19,7 @@ void* LinearAllocator::allocate (size_t size, uint8_t alignment) {
 	_current_pos = (void*)(aligned_address + size);
 	_used_memory += size + adjustment;
 	_num_allocations++;
+	recordAllocation (size);
 
 	return (void*)aligned_address;
 }
@@ -0,0 +1,158 @@
+#include "PagedPoolAllocator.h"
+
+#include <cassert>
+
+PagedPoolAllocator::PagedPoolAllocator (size_t objectSize, uint8_t objectAlignment, size_t pageSize, Allocator* const& parent, size_t slackPages)
+	: Allocator (nullptr, pageSize), _parent (parent), _objectSize (objectSize), _objectAlignment (objectAlignment), _pageSize (pageSize), _slackPages (slackPages),
+	_pages (nullptr), _available (nullptr), _pageCount (0), _emptyPages (0) {
+	assert (parent != nullptr);
+
+	uint8_t alignment = objectAlignment > sizeof (void*) ? objectAlignment : sizeof (void*);
+	size_t object_size = objectSize > sizeof (void*) ? objectSize : sizeof (void*);
+
+	//Header and object both rounded to the alignment so every slot stays aligned
+	_slotHeader = alignment;
+	_slotSize = _slotHeader + ((object_size + alignment - 1) & ~(size_t)(alignment - 1));
+
+	size_t first_slot = sizeof (PageHeader) + alignment;
+	assert (pageSize > first_slot + _slotSize && "Page too small for a single object");
+	_objectsPerPage = (pageSize - first_slot) / _slotSize;
+
+	_size = 0;
+}
+
+PagedPoolAllocator::~PagedPoolAllocator () {
+	while (_pages != nullptr) {
+		destroyPage (_pages);
+	}
+}
+
+void* PagedPoolAllocator::allocate (size_t size, uint8_t alignment) {
+	assert (size <= _objectSize && alignment <= _objectAlignment);
+
+	if (_available == nullptr) {
+		if (createPage () == nullptr) return nullptr;
+	}
+
+	PageHeader* page = _available;
+	if (page->used == 0) _emptyPages--;
+
+	void** slot = page->free_list;
+	page->free_list = (void**)(*slot);
+	page->used++;
+
+	//Page is full
+	if (page->free_list == nullptr) {
+		removeAvailable (page);
+	}
+
+	*slot = page;
+	_used_memory += _objectSize;
+	_num_allocations++;
+	recordAllocation (size);
+
+	return pointerMath::add (slot, _slotHeader);
+}
+
+void PagedPoolAllocator::deallocate (void*&& p) {
+	assert (p != nullptr);
+
+	void** slot = (void**)pointerMath::subtract (p, _slotHeader);
+	PageHeader* page = (PageHeader*)(*slot);
+	assert (page->used > 0);
+
+	//Page was full
+	if (page->free_list == nullptr) {
+		pushAvailable (page);
+	}
+
+	*slot = page->free_list;
+	page->free_list = slot;
+	page->used--;
+
+	_used_memory -= _objectSize;
+	_num_allocations--;
+
+	if (page->used == 0) {
+		//Enough empty pages kept around, this one goes back to the parent
+		if (_emptyPages >= _slackPages) {
+			destroyPage (page);
+		} else {
+			_emptyPages++;
+		}
+	}
+
+	p = nullptr;
+}
+
+size_t PagedPoolAllocator::getPageCount () const {
+	return _pageCount;
+}
+
+size_t PagedPoolAllocator::getObjectsPerPage () const {
+	return _objectsPerPage;
+}
+
+PagedPoolAllocator::PageHeader* PagedPoolAllocator::createPage () {
+	void* mem = _parent->allocate (_pageSize, __alignof(PageHeader));
+	if (mem == nullptr) return nullptr;
+
+	PageHeader* page = (PageHeader*)mem;
+	page->prev = nullptr;
+	page->next = _pages;
+	if (_pages != nullptr) _pages->prev = page;
+	_pages = page;
+
+	//Initialize free slots list, objects start after the page header
+	uint8_t alignment = static_cast<uint8_t>(_slotHeader);
+	void* first = pointerMath::alignForward (pointerMath::add (mem, sizeof (PageHeader)), alignment);
+	page->free_list = (void**)first;
+	page->used = 0;
+
+	void** p = page->free_list;
+	for (size_t i = 0; i < _objectsPerPage - 1; i++) {
+		*p = pointerMath::add (p, _slotSize);
+		p = (void**)*p;
+	}
+	*p = nullptr;
+
+	pushAvailable (page);
+
+	_pageCount++;
+	_emptyPages++;
+	_size += _pageSize;
+
+	return page;
+}
+
+void PagedPoolAllocator::destroyPage (PageHeader* page) {
+	//Full pages are not in the available list
+	if (page->free_list != nullptr) {
+		removeAvailable (page);
+	}
+
+	if (page->prev != nullptr) page->prev->next = page->next;
+	if (page->next != nullptr) page->next->prev = page->prev;
+	if (_pages == page) _pages = page->next;
+
+	_pageCount--;
+	_size -= _pageSize;
+
+	_parent->deallocate (page);
+}
+
+void PagedPoolAllocator::pushAvailable (PageHeader* page) {
+	page->prev_available = nullptr;
+	page->next_available = _available;
+	if (_available != nullptr) _available->prev_available = page;
+	_available = page;
+}
+
+void PagedPoolAllocator::removeAvailable (PageHeader* page) {
+	if (page->prev_available != nullptr) page->prev_available->next_available = page->next_available;
+	if (page->next_available != nullptr) page->next_available->prev_available = page->prev_available;
+	if (_available == page) _available = page->next_available;
+
+	page->prev_available = nullptr;
+	page->next_available = nullptr;
+}
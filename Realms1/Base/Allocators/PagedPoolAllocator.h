@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Allocator.h"
+
+//PoolAllocator growing by fixed-size pages taken from a parent Allocator when every slot is used.
+//Pages left completely free are given back to the parent, except for a slack kept to absorb the next peak.
+//Size is the memory currently held in pages, there is no single start.
+class PagedPoolAllocator : public Allocator {
+public:
+
+	PagedPoolAllocator (size_t objectSize, uint8_t objectAlignment, size_t pageSize, Allocator* const& parent, size_t slackPages = 1);
+	~PagedPoolAllocator ();
+	void* allocate (size_t size, uint8_t alignment) override;
+	void deallocate (void*&& p) override;
+
+	size_t getPageCount () const;
+	size_t getObjectsPerPage () const;
+
+private:
+
+	struct PageHeader {
+		//Every page
+		PageHeader* prev;
+		PageHeader* next;
+
+		//Pages with at least one free slot
+		PageHeader* prev_available;
+		PageHeader* next_available;
+
+		void** free_list;
+		size_t used;
+	};
+
+	//Prevent copies because it might cause errors
+	PagedPoolAllocator (const PagedPoolAllocator&);
+	PagedPoolAllocator& operator=(const PagedPoolAllocator&) = delete;
+
+	PageHeader* createPage ();
+	void destroyPage (PageHeader* page);
+
+	void pushAvailable (PageHeader* page);
+	void removeAvailable (PageHeader* page);
+
+	Allocator* _parent;
+
+	size_t _objectSize;
+	uint8_t _objectAlignment;
+	size_t _pageSize;
+	size_t _slackPages;
+
+	//Each slot stores its page before the object so deallocate finds it in constant time
+	size_t _slotHeader;
+	size_t _slotSize;
+	size_t _objectsPerPage;
+
+	PageHeader* _pages;
+	PageHeader* _available;
+	size_t _pageCount;
+	size_t _emptyPages;
+};
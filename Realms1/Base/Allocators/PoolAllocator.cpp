@@ -29,15 +29,38 @@ void* PoolAllocator::allocate (size_t size, uint8_t alignment) {
 	if (_free_list == nullptr) return nullptr;
 	void* p = _free_list;
 	_free_list = (void**)(*_free_list);
+#ifdef RLMS_ALLOCATOR_GUARDS
+	memset (pointerMath::add (p, sizeof (void*)), allocatorGuard::ALLOCATED_BYTE, _objectSize > sizeof (void*) ? _objectSize - sizeof (void*) : 0);
+#endif
 	_used_memory += _objectSize;
 	_num_allocations++;
+	recordAllocation (size);
 	return p;
 }
 
 void PoolAllocator::deallocate (void* &&p) {
+#ifdef RLMS_ALLOCATOR_GUARDS
+	assert (allocatorGuard::owns (_start, _size, p) && "Pointer not from this allocator");
+	assert (((uintptr_t)p - (uintptr_t)pointerMath::alignForward (_start, _objectAlignment)) % _objectSize == 0 && "Pointer is not the start of an object");
+
+	//Freed objects are poisoned past their free list link
+	if (_objectSize > sizeof (void*)) {
+		uint8_t* tail = (uint8_t*)pointerMath::add (p, sizeof (void*));
+		bool poisoned = true;
+		for (size_t i = 0; i < _objectSize - sizeof (void*) && poisoned; i++) {
+			poisoned = tail[i] == allocatorGuard::POISON_BYTE;
+		}
+		assert (!poisoned && "Double free");
+		allocatorGuard::poison (tail, _objectSize - sizeof (void*));
+	}
+#endif
 	*((void**)p) = _free_list;
 	_free_list = (void**)p;
 	_used_memory -= _objectSize;
 	_num_allocations--;
 	p = nullptr;
 }
+
+size_t PoolAllocator::getLargestFreeBlock () const {
+	return _free_list != nullptr ? _objectSize : 0;
+}
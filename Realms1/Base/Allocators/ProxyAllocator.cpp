@@ -14,6 +14,7 @@ void* ProxyAllocator::allocate (size_t size, uint8_t alignment) {
 	uintptr_t  aligned_address = (uintptr_t)_start + adjustment;
 	_used_memory += size + adjustment;
 	_num_allocations++;
+	recordAllocation (size);
 
 	return (void*)aligned_address;
 }
@@ -0,0 +1,172 @@
+#include "RelocatingAllocator.h"
+
+#include <cassert>
+#include <cstring>
+
+const size_t RelocatingAllocator::BLOCK_ALIGNMENT;
+const size_t RelocatingAllocator::HEADER_SIZE;
+
+RelocatingAllocator::RelocatingAllocator (void* start, size_t size) : Allocator (start, size), _handles (),
+	_base (pointerMath::alignForward (start, BLOCK_ALIGNMENT)), _end (pointerMath::add (start, size)),
+	_top (nullptr), _cursor (nullptr), _free_bytes (0), _scratch (nullptr), _scratch_size (0) {
+	assert (size > HEADER_SIZE + BLOCK_ALIGNMENT);
+	_top = _base;
+	_cursor = _base;
+}
+
+RelocatingAllocator::~RelocatingAllocator () {
+	::operator delete (_scratch);
+	_scratch = nullptr;
+	_top = nullptr;
+	_cursor = nullptr;
+}
+
+void* RelocatingAllocator::allocate (size_t size, uint8_t alignment) {
+	(void)size;
+	(void)alignment;
+	return nullptr;
+}
+
+void RelocatingAllocator::deallocate (void*&& p) {
+	p = nullptr;
+}
+
+Handle RelocatingAllocator::allocateHandle (size_t size, RelocateFunction relocate) {
+	assert (size != 0);
+
+	size_t block_size = HEADER_SIZE + ((size + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1));
+
+	//Not enough room on top, but enough once fully compacted
+	if (getLargestFreeBlock () < block_size && getLargestFreeBlock () + _free_bytes >= block_size) {
+		defragment (SIZE_MAX);
+	}
+	if (getLargestFreeBlock () < block_size) return Handle ();
+
+	BlockHeader* block = (BlockHeader*)_top;
+	block->size = block_size;
+	block->relocate = relocate;
+	block->free = 0;
+
+	Handle handle = _handles.create (pointerMath::add (block, HEADER_SIZE));
+	block->handle_index = handle.index;
+
+	_top = pointerMath::add (_top, block_size);
+	_used_memory += block_size;
+	_num_allocations++;
+	recordAllocation (size);
+
+	return handle;
+}
+
+void RelocatingAllocator::deallocateHandle (Handle& handle) {
+	assert (_handles.isValid (handle) && "Stale or null handle");
+
+	BlockHeader* block = (BlockHeader*)pointerMath::subtract (_handles.get (handle), HEADER_SIZE);
+	block->free = 1;
+	_handles.destroy (handle);
+
+	_used_memory -= block->size;
+	_num_allocations--;
+
+	if (pointerMath::add (block, block->size) == _top) {
+		_top = block;
+	} else {
+		_free_bytes += block->size;
+		if (block < _cursor) _cursor = block;
+	}
+
+	//A freed block right under the cursor must be seen by the next compaction
+	if (_top < _cursor) _cursor = _top;
+
+	handle = Handle ();
+}
+
+void* RelocatingAllocator::get (const Handle& handle) const {
+	return _handles.get (handle);
+}
+
+bool RelocatingAllocator::isValid (const Handle& handle) const {
+	return _handles.isValid (handle);
+}
+
+size_t RelocatingAllocator::defragment (size_t maxBytes) {
+	size_t moved = 0;
+	void* p = _cursor;
+
+	while (p < _top && moved < maxBytes) {
+		BlockHeader* block = (BlockHeader*)p;
+		if (!block->free) {
+			p = pointerMath::add (p, block->size);
+			_cursor = p;
+			continue;
+		}
+
+		//Gather the contiguous free blocks
+		void* gap_start = p;
+		size_t gap_size = 0;
+		while (p < _top && ((BlockHeader*)p)->free) {
+			gap_size += ((BlockHeader*)p)->size;
+			p = pointerMath::add (p, ((BlockHeader*)p)->size);
+		}
+
+		//Nothing left above, the gap is now free space on top
+		if (p >= _top) {
+			_top = gap_start;
+			_cursor = _top;
+			_free_bytes -= gap_size;
+			break;
+		}
+
+		//Slide the next used block down, the gap ends up right after it
+		size_t block_size = ((BlockHeader*)p)->size;
+		moveBlock ((BlockHeader*)p, gap_start);
+		moved += block_size;
+
+		BlockHeader* gap = (BlockHeader*)pointerMath::add (gap_start, block_size);
+		gap->size = gap_size;
+		gap->relocate = nullptr;
+		gap->handle_index = 0;
+		gap->free = 1;
+
+		_cursor = gap;
+		p = gap;
+	}
+
+	return moved;
+}
+
+size_t RelocatingAllocator::getLargestFreeBlock () const {
+	return (uintptr_t)_end - (uintptr_t)_top;
+}
+
+void RelocatingAllocator::moveBlock (BlockHeader* block, void* dst) {
+	BlockHeader header = *block;
+	void* src_payload = pointerMath::add (block, HEADER_SIZE);
+	void* dst_payload = pointerMath::add (dst, HEADER_SIZE);
+	size_t payload_size = header.size - HEADER_SIZE;
+
+	if (header.relocate == nullptr) {
+		memmove (dst, block, header.size);
+	} else {
+		//Objects can't be moved onto themselves, go through the scratch memory
+		if (pointerMath::add (dst_payload, payload_size) > src_payload) {
+			void* scratch = reserveScratch (payload_size);
+			header.relocate (scratch, src_payload);
+			header.relocate (dst_payload, scratch);
+		} else {
+			header.relocate (dst_payload, src_payload);
+		}
+		*(BlockHeader*)dst = header;
+	}
+
+	_handles.relocate (header.handle_index, dst_payload);
+}
+
+void* RelocatingAllocator::reserveScratch (size_t size) {
+	if (size > _scratch_size) {
+		::operator delete (_scratch);
+		_scratch = ::operator new (size);
+		_scratch_size = size;
+	}
+	return _scratch;
+}
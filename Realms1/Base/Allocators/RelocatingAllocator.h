@@ -0,0 +1,96 @@
+#pragma once
+#include "Allocator.h"
+#include "HandleTable.h"
+
+#include <type_traits>
+
+//Allocator whose blocks can move : they are reached through handles, allocated by bumping a top pointer and
+//slid down over freed space by defragment(), a bounded amount at a time, so memory stays dense.
+//Pointers from get() are only valid until the next defragment() or allocateHandle().
+class RelocatingAllocator : public Allocator {
+public:
+	//Moves an object from src to dst and ends the lifetime of the one at src
+	using RelocateFunction = void (*)(void* dst, void* src);
+
+	//Alignment of every block, and so the largest alignment an object can need
+	static const size_t BLOCK_ALIGNMENT = 16;
+
+	RelocatingAllocator (void* start, size_t size);
+	~RelocatingAllocator ();
+
+	//Raw pointers would be left dangling by the first compaction, allocate always fails, use allocateHandle ()
+	void* allocate (size_t size, uint8_t alignment) override;
+	void deallocate (void*&& p) override;
+
+	//relocate is nullptr for data that can be moved as plain bytes, a null handle when out of memory
+	Handle allocateHandle (size_t size, RelocateFunction relocate = nullptr);
+	void deallocateHandle (Handle& handle);
+
+	void* get (const Handle& handle) const;
+	bool isValid (const Handle& handle) const;
+
+	//Slide blocks down over free space until at most maxBytes were moved, returns the bytes moved
+	size_t defragment (size_t maxBytes);
+
+	//Free space above the last block, what can be allocated without compacting
+	size_t getLargestFreeBlock () const override;
+
+private:
+	struct BlockHeader {
+		//Whole block, header included
+		size_t size;
+		RelocateFunction relocate;
+		uint32_t handle_index;
+		uint32_t free;
+	};
+
+	static const size_t HEADER_SIZE = (sizeof (BlockHeader) + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+
+	//Prevent copies because it might cause errors
+	RelocatingAllocator (const RelocatingAllocator&);
+	RelocatingAllocator& operator=(const RelocatingAllocator&) = delete;
+
+	void moveBlock (BlockHeader* block, void* dst);
+	void* reserveScratch (size_t size);
+
+	HandleTable _handles;
+
+	void* _base;
+	void* _end;
+	//End of the last block
+	void* _top;
+	//Every block under it is in use
+	void* _cursor;
+	//Freed blocks still under the top
+	size_t _free_bytes;
+
+	//Intermediate copy when a block overlaps its destination
+	void* _scratch;
+	size_t _scratch_size;
+};
+
+namespace allocator {
+	template <class T>
+	void relocateObject (void* dst, void* src) {
+		T* object = static_cast<T*>(src);
+		new (dst) T (std::move (*object));
+		object->~T ();
+	}
+
+	template <class T, class... Args>
+	Handle allocateRelocatable (RelocatingAllocator& allocator, Args&& ... args) {
+		static_assert (__alignof(T) <= RelocatingAllocator::BLOCK_ALIGNMENT, "Over-aligned type");
+
+		Handle handle = allocator.allocateHandle (sizeof (T), std::is_trivially_copyable<T>::value ? nullptr : &relocateObject<T>);
+		if (!handle.isNull ()) {
+			new (allocator.get (handle)) T (std::forward<Args> (args)...);
+		}
+		return handle;
+	}
+
+	template <class T>
+	void deallocateRelocatable (RelocatingAllocator& allocator, Handle& handle) {
+		static_cast<T*>(allocator.get (handle))->~T ();
+		allocator.deallocateHandle (handle);
+	}
+}
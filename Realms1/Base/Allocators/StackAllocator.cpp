@@ -1,6 +1,9 @@
 #include "StackAllocator.h"
+#include "VirtualArena.h"
 #include <cassert>
 
+const size_t StackAllocator::SCRATCH_SIZE;
+
 StackAllocator::StackAllocator (void* start, size_t size) : Allocator (start, size), _current_pos (start) {
 	assert (size > 0);
 }
@@ -11,6 +14,10 @@ StackAllocator::~StackAllocator () {
 
 void* StackAllocator::allocate (size_t size, uint8_t alignment) {
 	assert (size != 0);
+#ifdef RLMS_ALLOCATOR_GUARDS
+	const size_t user_size = size;
+	size = allocatorGuard::guardedSize (size, alignment);
+#endif
 	uint8_t adjustment = pointerMath::alignForwardAdjustmentWithHeader (_current_pos, alignment, sizeof (AllocationHeader));
 
 	if (_used_memory + adjustment + size > _size) return nullptr;
@@ -24,12 +31,24 @@ void* StackAllocator::allocate (size_t size, uint8_t alignment) {
 	_current_pos = pointerMath::add (aligned_address, size);
 	_used_memory += size + adjustment;
 	_num_allocations++;
+	recordAllocation (size);
 
+#ifdef RLMS_ALLOCATOR_GUARDS
+	return allocatorGuard::guard (aligned_address, user_size, alignment);
+#else
 	return aligned_address;
+#endif
 }
 
 void StackAllocator::deallocate (void* &&p) {
 	//assert (p == _prev_position);
+#ifdef RLMS_ALLOCATOR_GUARDS
+	assert (allocatorGuard::owns (_start, _size, p) && "Pointer not from this allocator");
+	assert (p < _current_pos && "Already freed (stack unwound past it)");
+	size_t guarded_size = 0;
+	p = allocatorGuard::unguard (p, guarded_size);
+	allocatorGuard::poison (p, (uintptr_t)_current_pos - (uintptr_t)p);
+#endif
 
 	//Access the AllocationHeader in the bytes before p 
 	AllocationHeader* header = (AllocationHeader*)(pointerMath::subtract (p, sizeof (AllocationHeader)));
@@ -38,4 +57,34 @@ void StackAllocator::deallocate (void* &&p) {
 
 	p = nullptr;
 	_num_allocations--;
-}
\ No newline at end of file
+}
+
+StackAllocator::Marker StackAllocator::getMarker () const {
+	return { _current_pos, _used_memory, _num_allocations };
+}
+
+void StackAllocator::rewind (const Marker& marker) {
+	assert (marker.position <= _current_pos && "Stack already rewound past the marker");
+#ifdef RLMS_ALLOCATOR_GUARDS
+	allocatorGuard::poison (marker.position, (uintptr_t)_current_pos - (uintptr_t)marker.position);
+#endif
+
+	_current_pos = marker.position;
+	_used_memory = marker.used_memory;
+	_num_allocations = marker.num_allocations;
+}
+
+StackAllocator& StackAllocator::ThreadScratch () {
+	//Only reserved and committed, pages are backed once a scope reaches them
+	struct Scratch {
+		VirtualArena arena;
+		StackAllocator stack;
+
+		Scratch () : arena (SCRATCH_SIZE), stack (arena.commit (SCRATCH_SIZE) ? arena.getStart () : nullptr, SCRATCH_SIZE) {
+			assert (arena.getStart () != nullptr && "Could not reserve the scratch stack");
+		}
+	};
+
+	thread_local Scratch scratch;
+	return scratch.stack;
+}
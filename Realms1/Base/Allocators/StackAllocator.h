@@ -1,14 +1,30 @@
+#pragma once
 #include "Allocator.h" 
 
 class StackAllocator : public Allocator {
 public:
+	//Top of the stack at some point, everything allocated after it is freed at once by rewind ()
+	struct Marker {
+		void* position;
+		size_t used_memory;
+		size_t num_allocations;
+	};
+
+	//Per thread scratch stack size, enough for the occlusion grid of the largest (256^3) model
+	static const size_t SCRATCH_SIZE = 32 * 1024 * 1024;
 
 	StackAllocator (void* start, size_t size);
 	~StackAllocator ();
 
-	void* allocate (size_t size, uint8_t alignment) override;
+	void* allocate (size_t size, uint8_t alignment = DEFAULT_ALIGNMENT) override;
 	void deallocate (void*&& p) override;
 
+	Marker getMarker () const;
+	void rewind (const Marker& marker);
+
+	//Scratch memory of the calling thread, only meant to be used through a StackScope
+	static StackAllocator& ThreadScratch ();
+
 private:
 	//Prevent copies because it might cause errors 
 	StackAllocator (const StackAllocator&);
@@ -18,4 +34,25 @@ private:
 		uint8_t adjustment;
 	};
 	void* _current_pos;
-};
\ No newline at end of file
+};
+
+//Frees everything allocated on the stack during its lifetime
+class StackScope {
+public:
+	StackScope (StackAllocator& stack) : _stack (stack), _marker (stack.getMarker ()) {}
+	~StackScope () {
+		_stack.rewind (_marker);
+	}
+
+	StackAllocator& stack () {
+		return _stack;
+	}
+
+private:
+	//Prevent copies because it might cause errors
+	StackScope (const StackScope&);
+	StackScope& operator=(const StackScope&) = delete;
+
+	StackAllocator& _stack;
+	StackAllocator::Marker _marker;
+};
@@ -0,0 +1,417 @@
+#include "TLSFAllocator.h"
+#include "VirtualArena.h"
+
+#include <algorithm>
+#include <cassert>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+	//index of the most significant set bit (x != 0)
+	inline size_t fls (size_t x) {
+#if defined(_MSC_VER) && defined(_WIN64)
+		unsigned long index;
+		_BitScanReverse64 (&index, x);
+		return index;
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse (&index, x);
+		return index;
+#else
+		return 63 - __builtin_clzll (static_cast<unsigned long long>(x));
+#endif
+	}
+
+	//index of the least significant set bit (x != 0)
+	inline size_t ffs (uint32_t x) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward (&index, x);
+		return index;
+#else
+		return __builtin_ctz (x);
+#endif
+	}
+
+	inline size_t alignUp (size_t x, size_t align) {
+		return (x + (align - 1)) & ~(align - 1);
+	}
+}
+
+namespace {
+	inline size_t commitInitial (VirtualArena* arena, size_t size) {
+		assert (arena != nullptr && arena->getStart () != nullptr);
+		bool committed = arena->commit (size);
+		assert (committed && "Could not commit the initial size");
+		(void)committed;
+		return arena->getCommittedSize ();
+	}
+}
+
+const size_t TLSFAllocator::DECOMMIT_THRESHOLD;
+
+TLSFAllocator::TLSFAllocator (void* start, size_t size) : Allocator (start, size), _fl_bitmap (0), _sentinel (nullptr), _arena (nullptr) {
+	for (size_t i = 0; i < FL_INDEX_COUNT; i++) {
+		_sl_bitmap[i] = 0;
+		for (size_t j = 0; j < SL_INDEX_COUNT; j++) {
+			_blocks[i][j] = nullptr;
+		}
+	}
+
+	uint8_t adjustment = pointerMath::alignForwardAdjustment (start, ALIGN_SIZE);
+	assert (size > adjustment + 2 * BLOCK_OVERHEAD + BLOCK_SIZE_MIN);
+
+	//One free block spanning the whole memory, followed by an empty used sentinel
+	size_t pool_size = (size - adjustment - 2 * BLOCK_OVERHEAD) & ~(ALIGN_SIZE - 1);
+	assert (pool_size >= BLOCK_SIZE_MIN && pool_size < BLOCK_SIZE_MAX);
+
+	BlockHeader* block = (BlockHeader*)pointerMath::add (start, adjustment);
+	block->prev_physical = nullptr;
+	block->size = pool_size;
+	block->setFree ();
+	block->setPrevUsed ();
+	insertBlock (block);
+
+	BlockHeader* sentinel = block->linkNext ();
+	sentinel->size = 0;
+	sentinel->setUsed ();
+	sentinel->setPrevFree ();
+	_sentinel = sentinel;
+}
+
+TLSFAllocator::TLSFAllocator (VirtualArena* arena, size_t initialSize) : TLSFAllocator (arena->getStart (), commitInitial (arena, initialSize)) {
+	_arena = arena;
+
+	//Freshly committed, nothing to hand back yet
+	_sentinel->prev_physical->setDecommitted ();
+}
+
+TLSFAllocator::~TLSFAllocator () {
+	_fl_bitmap = 0;
+}
+
+void* TLSFAllocator::allocate (size_t size, uint8_t alignment) {
+	assert (size != 0 && alignment != 0);
+#ifdef RLMS_ALLOCATOR_GUARDS
+	void* block = allocateBlock (allocatorGuard::guardedSize (size, alignment), alignment);
+	return block == nullptr ? nullptr : allocatorGuard::guard (block, size, alignment);
+}
+
+void* TLSFAllocator::allocateBlock (size_t size, uint8_t alignment) {
+#endif
+
+	size_t adjusted_size = alignUp (size < BLOCK_SIZE_MIN ? BLOCK_SIZE_MIN : size, ALIGN_SIZE);
+	if (adjusted_size >= BLOCK_SIZE_MAX) return nullptr;
+
+	//Blocks are always ALIGN_SIZE aligned
+	if (alignment <= ALIGN_SIZE) {
+		return prepareUsed (locateFree (adjusted_size), adjusted_size);
+	}
+
+	//Over-allocate so a leading gap big enough to become a free block can be trimmed off
+	const size_t gap_minimum = sizeof (BlockHeader);
+	size_t size_with_gap = alignUp (adjusted_size + alignment + gap_minimum, ALIGN_SIZE);
+
+	BlockHeader* block = locateFree (size_with_gap);
+	if (block == nullptr) return nullptr;
+
+	void* ptr = block->payload ();
+	void* aligned = pointerMath::alignForward (ptr, alignment);
+	size_t gap = (uintptr_t)aligned - (uintptr_t)ptr;
+
+	//The gap is too small to hold a block header, move to the next aligned address
+	if (gap != 0 && gap < gap_minimum) {
+		size_t gap_remain = gap_minimum - gap;
+		size_t offset = gap_remain > alignment ? gap_remain : alignment;
+		aligned = pointerMath::alignForward (pointerMath::add (aligned, offset), alignment);
+		gap = (uintptr_t)aligned - (uintptr_t)ptr;
+	}
+
+	if (gap != 0) {
+		block = trimFreeLeading (block, gap);
+	}
+
+	void* p = prepareUsed (block, adjusted_size);
+	assert (pointerMath::alignForwardAdjustment (p, alignment) == 0);
+	return p;
+}
+
+void TLSFAllocator::deallocate (void*&& p) {
+	assert (p != nullptr);
+
+#ifdef RLMS_ALLOCATOR_GUARDS
+	assert (allocatorGuard::owns (_start, _size, p) && "Pointer not from this allocator");
+	size_t guarded_size = 0;
+	p = allocatorGuard::unguard (p, guarded_size);
+	allocatorGuard::poison (p, guarded_size);
+#endif
+
+	BlockHeader* block = BlockHeader::fromPayload (p);
+	assert (!block->isFree () && "Block already freed");
+
+	_used_memory -= block->getSize () + BLOCK_OVERHEAD;
+	_num_allocations--;
+
+	BlockHeader* next = block->linkNext ();
+	next->setPrevFree ();
+	block->setFree ();
+
+	//Neighbours already handed back only need the pages this block makes whole
+	void* begin = block->isPrevFree () && !block->prev_physical->isDecommitted () ? (void*)block->prev_physical : (void*)block;
+	void* end = next->isFree () && !next->isDecommitted () ? (void*)next->next () : (void*)next;
+
+	block = mergePrev (block);
+	block = mergeNext (block);
+	insertBlock (block);
+
+	if (_arena != nullptr && block->getSize () >= DECOMMIT_THRESHOLD) {
+		decommitFree (block, begin, end);
+	}
+
+	p = nullptr;
+}
+
+size_t TLSFAllocator::getLargestFreeBlock () const {
+	if (_fl_bitmap == 0) return 0;
+
+	//Only the highest non empty list can hold the largest block
+	size_t fl = fls (_fl_bitmap);
+	size_t sl = fls (_sl_bitmap[fl]);
+
+	size_t largest = 0;
+	for (BlockHeader* block = _blocks[fl][sl]; block != nullptr; block = block->next_free) {
+		if (block->getSize () > largest) largest = block->getSize ();
+	}
+	return largest;
+}
+
+void TLSFAllocator::mappingInsert (size_t size, size_t& fl, size_t& sl) const {
+	if (size < SMALL_BLOCK_SIZE) {
+		//Small blocks are linearly spread in the first list
+		fl = 0;
+		sl = size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+	} else {
+		size_t f = fls (size);
+		sl = (size >> (f - SL_INDEX_COUNT_LOG2)) ^ (static_cast<size_t>(1) << SL_INDEX_COUNT_LOG2);
+		fl = f - (FL_INDEX_SHIFT - 1);
+	}
+}
+
+void TLSFAllocator::mappingSearch (size_t size, size_t& fl, size_t& sl) const {
+	//Round up to the next list so any block found there is large enough
+	if (size >= SMALL_BLOCK_SIZE) {
+		size_t round = (static_cast<size_t>(1) << (fls (size) - SL_INDEX_COUNT_LOG2)) - 1;
+		size += round;
+	}
+	mappingInsert (size, fl, sl);
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::searchSuitableBlock (size_t& fl, size_t& sl) const {
+	//Search for a non empty list in the same first level, above the requested second level
+	uint32_t sl_map = _sl_bitmap[fl] & (~0u << sl);
+
+	if (sl_map == 0) {
+		//Fallback on the next non empty first level
+		if (fl + 1 >= FL_INDEX_COUNT) return nullptr;
+		uint32_t fl_map = _fl_bitmap & (~0u << (fl + 1));
+		if (fl_map == 0) return nullptr;
+
+		fl = ffs (fl_map);
+		sl_map = _sl_bitmap[fl];
+	}
+
+	sl = ffs (sl_map);
+	return _blocks[fl][sl];
+}
+
+void TLSFAllocator::removeFreeBlock (BlockHeader* block, size_t fl, size_t sl) {
+	BlockHeader* prev = block->prev_free;
+	BlockHeader* next = block->next_free;
+
+	if (next != nullptr) next->prev_free = prev;
+	if (prev != nullptr) prev->next_free = next;
+
+	if (_blocks[fl][sl] == block) {
+		_blocks[fl][sl] = next;
+
+		//List is now empty, clear its bits
+		if (next == nullptr) {
+			_sl_bitmap[fl] &= ~(1u << sl);
+			if (_sl_bitmap[fl] == 0) {
+				_fl_bitmap &= ~(1u << fl);
+			}
+		}
+	}
+}
+
+void TLSFAllocator::insertFreeBlock (BlockHeader* block, size_t fl, size_t sl) {
+	BlockHeader* current = _blocks[fl][sl];
+
+	block->next_free = current;
+	block->prev_free = nullptr;
+	if (current != nullptr) current->prev_free = block;
+
+	_blocks[fl][sl] = block;
+	_fl_bitmap |= (1u << fl);
+	_sl_bitmap[fl] |= (1u << sl);
+}
+
+void TLSFAllocator::removeBlock (BlockHeader* block) {
+	size_t fl, sl;
+	mappingInsert (block->getSize (), fl, sl);
+	removeFreeBlock (block, fl, sl);
+}
+
+void TLSFAllocator::insertBlock (BlockHeader* block) {
+	size_t fl, sl;
+	mappingInsert (block->getSize (), fl, sl);
+	insertFreeBlock (block, fl, sl);
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::split (BlockHeader* block, size_t size) {
+	//Remaining memory becomes a new free block right after the payload
+	BlockHeader* remaining = (BlockHeader*)pointerMath::add (block->payload (), size);
+	size_t remaining_size = block->getSize () - (size + BLOCK_OVERHEAD);
+
+	//Pages handed back before stay so in what is left
+	remaining->size = remaining_size | (block->size & BlockHeader::DECOMMITTED_BIT);
+	block->setSize (size);
+
+	BlockHeader* next = remaining->linkNext ();
+	next->setPrevFree ();
+	remaining->setFree ();
+
+	return remaining;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::absorb (BlockHeader* prev, BlockHeader* block) {
+	if (!block->isDecommitted ()) prev->size &= ~BlockHeader::DECOMMITTED_BIT;
+	prev->setSize (prev->getSize () + block->getSize () + BLOCK_OVERHEAD);
+	prev->linkNext ();
+	return prev;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::mergePrev (BlockHeader* block) {
+	if (block->isPrevFree ()) {
+		BlockHeader* prev = block->prev_physical;
+		removeBlock (prev);
+		block = absorb (prev, block);
+	}
+	return block;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::mergeNext (BlockHeader* block) {
+	BlockHeader* next = block->next ();
+	if (next->isFree ()) {
+		removeBlock (next);
+		block = absorb (block, next);
+	}
+	return block;
+}
+
+void TLSFAllocator::trimFree (BlockHeader* block, size_t size) {
+	//If allocations in the remaining memory will be possible, give it back to the free lists
+	if (block->getSize () >= sizeof (BlockHeader) + size) {
+		BlockHeader* remaining = split (block, size);
+		block->linkNext ();
+		remaining->setPrevFree ();
+		insertBlock (remaining);
+	}
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::trimFreeLeading (BlockHeader* block, size_t size) {
+	BlockHeader* remaining = block;
+	if (block->getSize () >= sizeof (BlockHeader) + size - BLOCK_OVERHEAD) {
+		remaining = split (block, size - BLOCK_OVERHEAD);
+		block->linkNext ();
+		remaining->setPrevFree ();
+		insertBlock (block);
+	}
+	return remaining;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::locateFree (size_t size) {
+	size_t fl = 0, sl = 0;
+	mappingSearch (size, fl, sl);
+
+	//Requested size is beyond the largest list
+	if (fl >= FL_INDEX_COUNT) return nullptr;
+
+	BlockHeader* block = searchSuitableBlock (fl, sl);
+
+	//Out of committed memory, take more from the arena and search again
+	if (block == nullptr && _arena != nullptr && grow (size)) {
+		mappingSearch (size, fl, sl);
+		block = searchSuitableBlock (fl, sl);
+	}
+
+	if (block != nullptr) {
+		assert (block->getSize () >= size);
+		removeFreeBlock (block, fl, sl);
+	}
+	return block;
+}
+
+void* TLSFAllocator::prepareUsed (BlockHeader* block, size_t size) {
+	if (block == nullptr) return nullptr;
+
+	trimFree (block, size);
+
+	block->next ()->setPrevUsed ();
+	block->setUsed ();
+
+	_used_memory += block->getSize () + BLOCK_OVERHEAD;
+	_num_allocations++;
+	recordAllocation (size);
+
+	return block->payload ();
+}
+
+bool TLSFAllocator::grow (size_t size) {
+	//Searches round the size up to the next list, the new block must reach it
+	size_t required = size + (size >> SL_INDEX_COUNT_LOG2) + 2 * BLOCK_OVERHEAD;
+
+	//At least double so growing stays rare, the new pages cost nothing until touched
+	size_t new_size = _size + (required > _size ? required : _size);
+	if (new_size > _arena->getReservedSize ()) new_size = _arena->getReservedSize ();
+	if (new_size < _size + required || !_arena->commit (new_size)) return false;
+
+	//The sentinel becomes a free block spanning the new memory, followed by a new sentinel
+	uintptr_t end = (uintptr_t)_start + _arena->getCommittedSize ();
+	size_t block_size = (end - (uintptr_t)_sentinel->payload () - BLOCK_OVERHEAD) & ~(ALIGN_SIZE - 1);
+	if (block_size < BLOCK_SIZE_MIN || block_size >= BLOCK_SIZE_MAX) return false;
+
+	BlockHeader* block = _sentinel;
+	block->size = block_size | (block->size & BlockHeader::PREV_FREE_BIT);
+	block->setFree ();
+	block->setDecommitted ();
+
+	BlockHeader* sentinel = block->linkNext ();
+	sentinel->size = 0;
+	sentinel->setUsed ();
+	sentinel->setPrevFree ();
+	_sentinel = sentinel;
+
+	_size = end - (uintptr_t)_start;
+
+	block = mergePrev (block);
+	insertBlock (block);
+	return true;
+}
+
+void TLSFAllocator::decommitFree (BlockHeader* block, void* begin, void* end) {
+	//Keep the header and free list links, the rest of the payload is never read while free
+	//Pages straddling begin and end are only now whole, widen to them
+	uintptr_t granularity = _arena->getGranularity ();
+	uintptr_t unused_begin = (uintptr_t)block->payload () + sizeof (BlockHeader) - BLOCK_OVERHEAD;
+	uintptr_t unused_end = (uintptr_t)block->next ();
+	uintptr_t decommit_begin = std::max (unused_begin, (uintptr_t)begin & ~(granularity - 1));
+	uintptr_t decommit_end = std::min (unused_end, ((uintptr_t)end + granularity - 1) & ~(granularity - 1));
+
+	if (decommit_begin < decommit_end) {
+		_arena->decommit ((void*)decommit_begin, decommit_end - decommit_begin);
+	}
+	block->setDecommitted ();
+}
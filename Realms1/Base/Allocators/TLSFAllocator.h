@@ -0,0 +1,120 @@
+#pragma once
+#include "Allocator.h"
+
+class VirtualArena;
+
+//Two-Level Segregated Fit allocator : constant time allocate, deallocate and coalescing
+class TLSFAllocator : public Allocator {
+public:
+
+	//Free blocks at least this large have their pages handed back to the arena, once : a free next to one
+	//only hands back the pages it makes whole
+	static const size_t DECOMMIT_THRESHOLD = 256 * 1024;
+
+	TLSFAllocator (void* start, size_t size);
+	//Starts with initialSize committed and commits more of the arena when it runs out
+	TLSFAllocator (VirtualArena* arena, size_t initialSize);
+	~TLSFAllocator ();
+
+	void* allocate (size_t size, uint8_t alignment) override;
+	void deallocate (void*&& p) override;
+
+	size_t getLargestFreeBlock () const override;
+
+private:
+
+	static const size_t ALIGN_SIZE_LOG2 = 3;
+	static const size_t ALIGN_SIZE = 1 << ALIGN_SIZE_LOG2;
+
+	//Number of second level subdivisions of each first level (power of two) range
+	static const size_t SL_INDEX_COUNT_LOG2 = 5;
+	static const size_t SL_INDEX_COUNT = 1 << SL_INDEX_COUNT_LOG2;
+
+	//Blocks under SMALL_BLOCK_SIZE all go in the first level, linearly subdivided
+	static const size_t FL_INDEX_SHIFT = SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2;
+	static const size_t FL_INDEX_MAX = (sizeof (size_t) == 8) ? 38 : 30;
+	static const size_t FL_INDEX_COUNT = FL_INDEX_MAX - FL_INDEX_SHIFT + 1;
+	static const size_t SMALL_BLOCK_SIZE = 1 << FL_INDEX_SHIFT;
+
+	struct BlockHeader {
+		//Only meaningful while the previous physical block is free
+		BlockHeader* prev_physical;
+		//Payload size, the three lowest bits are the free / prev free / decommitted flags
+		size_t size;
+
+		//Only used while the block is free, overlaps the payload otherwise
+		BlockHeader* next_free;
+		BlockHeader* prev_free;
+
+		static const size_t FREE_BIT = 1 << 0;
+		static const size_t PREV_FREE_BIT = 1 << 1;
+		//Free block whose unused pages were all handed back, or never touched
+		static const size_t DECOMMITTED_BIT = 1 << 2;
+		static const size_t FLAG_BITS = FREE_BIT | PREV_FREE_BIT | DECOMMITTED_BIT;
+
+		size_t getSize () const { return size & ~FLAG_BITS; }
+		void setSize (size_t s) { size = s | (size & FLAG_BITS); }
+
+		bool isFree () const { return (size & FREE_BIT) != 0; }
+		void setFree () { size |= FREE_BIT; }
+		void setUsed () { size &= ~(FREE_BIT | DECOMMITTED_BIT); }
+
+		bool isDecommitted () const { return (size & DECOMMITTED_BIT) != 0; }
+		void setDecommitted () { size |= DECOMMITTED_BIT; }
+
+		bool isPrevFree () const { return (size & PREV_FREE_BIT) != 0; }
+		void setPrevFree () { size |= PREV_FREE_BIT; }
+		void setPrevUsed () { size &= ~PREV_FREE_BIT; }
+
+		void* payload () { return reinterpret_cast<uint8_t*>(this) + BLOCK_OVERHEAD; }
+		BlockHeader* next () { return reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(payload ()) + getSize ()); }
+		BlockHeader* linkNext () {
+			BlockHeader* n = next ();
+			n->prev_physical = this;
+			return n;
+		}
+
+		static BlockHeader* fromPayload (void* p) { return reinterpret_cast<BlockHeader*>(reinterpret_cast<uint8_t*>(p) - BLOCK_OVERHEAD); }
+	};
+
+	static const size_t BLOCK_OVERHEAD = sizeof (BlockHeader*) + sizeof (size_t);
+	static const size_t BLOCK_SIZE_MIN = sizeof (BlockHeader) - BLOCK_OVERHEAD;
+	static const size_t BLOCK_SIZE_MAX = static_cast<size_t>(1) << FL_INDEX_MAX;
+
+	//Prevent copies because it might cause errors
+	TLSFAllocator (const TLSFAllocator&);
+	TLSFAllocator& operator=(const TLSFAllocator&) = delete;
+
+	void mappingInsert (size_t size, size_t& fl, size_t& sl) const;
+	void mappingSearch (size_t size, size_t& fl, size_t& sl) const;
+	BlockHeader* searchSuitableBlock (size_t& fl, size_t& sl) const;
+
+	void removeFreeBlock (BlockHeader* block, size_t fl, size_t sl);
+	void insertFreeBlock (BlockHeader* block, size_t fl, size_t sl);
+	void removeBlock (BlockHeader* block);
+	void insertBlock (BlockHeader* block);
+
+	BlockHeader* split (BlockHeader* block, size_t size);
+	BlockHeader* absorb (BlockHeader* prev, BlockHeader* block);
+	BlockHeader* mergePrev (BlockHeader* block);
+	BlockHeader* mergeNext (BlockHeader* block);
+
+	void trimFree (BlockHeader* block, size_t size);
+	BlockHeader* trimFreeLeading (BlockHeader* block, size_t size);
+	BlockHeader* locateFree (size_t size);
+	//Commit enough of the arena for a block of size and append it to the pool
+	bool grow (size_t size);
+	//Hand back the unused pages of block touching [begin, end), the rest already was
+	void decommitFree (BlockHeader* block, void* begin, void* end);
+#ifdef RLMS_ALLOCATOR_GUARDS
+	void* allocateBlock (size_t size, uint8_t alignment);
+#endif
+	void* prepareUsed (BlockHeader* block, size_t size);
+
+	uint32_t _fl_bitmap;
+	uint32_t _sl_bitmap[FL_INDEX_COUNT];
+	BlockHeader* _blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+
+	BlockHeader* _sentinel;
+	VirtualArena* _arena;
+};
@@ -0,0 +1,228 @@
+#include "ThreadCacheAllocator.h"
+
+#include <cassert>
+
+const size_t ThreadCacheAllocator::SIZE_CLASS_GRANULARITY;
+const size_t ThreadCacheAllocator::SIZE_CLASS_COUNT;
+const size_t ThreadCacheAllocator::MAX_CACHED_SIZE;
+const size_t ThreadCacheAllocator::BATCH_SIZE;
+const size_t ThreadCacheAllocator::MAX_INSTANCES;
+
+std::mutex ThreadCacheAllocator::s_registry_mutex;
+ThreadCacheAllocator* ThreadCacheAllocator::s_registry[ThreadCacheAllocator::MAX_INSTANCES];
+uint64_t ThreadCacheAllocator::s_next_id = 1;
+
+ThreadCacheAllocator::ThreadCacheAllocator (Allocator* const& parent) : Allocator (parent->getStart (), parent->getSize ()), _parent (parent), _parent_mutex (), _slot (MAX_INSTANCES), _id (0) {
+	std::lock_guard<std::mutex> lock (s_registry_mutex);
+
+	for (size_t i = 0; i < MAX_INSTANCES; i++) {
+		if (s_registry[i] == nullptr) {
+			s_registry[i] = this;
+			_slot = i;
+			break;
+		}
+	}
+	assert (_slot < MAX_INSTANCES && "Too many ThreadCacheAllocator alive");
+
+	_id = s_next_id++;
+}
+
+ThreadCacheAllocator::~ThreadCacheAllocator () {
+	//The destroying thread's blocks go back to the parent, so its accounting drops to what is still in use
+	flush ();
+
+	//Blocks still cached by other threads belong to the parent's memory, they are dropped with it
+	std::lock_guard<std::mutex> lock (s_registry_mutex);
+	s_registry[_slot] = nullptr;
+	_parent = nullptr;
+}
+
+void* ThreadCacheAllocator::allocate (size_t size, uint8_t alignment) {
+	assert (size != 0 && alignment != 0);
+
+	if (size > MAX_CACHED_SIZE || alignment > sizeof (AllocationHeader)) {
+		return allocateLarge (size, alignment);
+	}
+
+	size_t size_class = (size - 1) / SIZE_CLASS_GRANULARITY;
+	ThreadCache& cache = getCache ();
+
+	if (cache.free_lists[size_class] == nullptr && !refill (cache, size_class)) {
+		return nullptr;
+	}
+
+	FreeBlock* block = cache.free_lists[size_class];
+	cache.free_lists[size_class] = block->next;
+	cache.counts[size_class]--;
+
+	return block;
+}
+
+void ThreadCacheAllocator::deallocate (void*&& p) {
+	assert (p != nullptr);
+
+	AllocationHeader* header = (AllocationHeader*)pointerMath::subtract (p, sizeof (AllocationHeader));
+
+	if (header->size_class == LARGE_CLASS) {
+		void* raw = pointerMath::subtract (p, header->adjustment);
+		size_t total_size = *(size_t*)pointerMath::subtract (header, sizeof (size_t)) + header->adjustment;
+
+		std::lock_guard<std::mutex> lock (_parent_mutex);
+		_parent->deallocate (std::move (raw));
+		_num_allocations--;
+		_used_memory -= total_size;
+		p = nullptr;
+		return;
+	}
+
+	size_t size_class = header->size_class;
+	ThreadCache& cache = getCache ();
+
+	FreeBlock* block = (FreeBlock*)p;
+	block->next = cache.free_lists[size_class];
+	cache.free_lists[size_class] = block;
+	cache.counts[size_class]++;
+
+	//Too many blocks kept by this thread, give a batch back
+	if (cache.counts[size_class] >= 2 * BATCH_SIZE) {
+		release (cache, size_class, BATCH_SIZE);
+	}
+
+	p = nullptr;
+}
+
+void ThreadCacheAllocator::flush () {
+	ThreadCache& cache = getCache ();
+	for (size_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+		release (cache, i, cache.counts[i]);
+	}
+}
+
+void* ThreadCacheAllocator::getStart () const {
+	return _parent->getStart ();
+}
+
+size_t ThreadCacheAllocator::getSize () const {
+	return _parent->getSize ();
+}
+
+size_t ThreadCacheAllocator::getLargestFreeBlock () const {
+	return _parent->getLargestFreeBlock ();
+}
+
+Allocator* ThreadCacheAllocator::getParent () const {
+	return _parent;
+}
+
+void ThreadCacheAllocator::ThreadCache::reset (uint64_t id) {
+	owner_id = id;
+	for (size_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+		free_lists[i] = nullptr;
+		counts[i] = 0;
+	}
+}
+
+ThreadCacheAllocator::ThreadCaches::ThreadCaches () {
+	for (size_t i = 0; i < MAX_INSTANCES; i++) {
+		caches[i].reset (0);
+	}
+}
+
+ThreadCacheAllocator::ThreadCaches::~ThreadCaches () {
+	std::lock_guard<std::mutex> lock (s_registry_mutex);
+
+	for (size_t i = 0; i < MAX_INSTANCES; i++) {
+		ThreadCacheAllocator* owner = s_registry[i];
+
+		//Cache of an allocator that has since been destroyed
+		if (owner == nullptr || owner->_id != caches[i].owner_id) continue;
+
+		for (size_t c = 0; c < SIZE_CLASS_COUNT; c++) {
+			owner->release (caches[i], c, caches[i].counts[c]);
+		}
+	}
+}
+
+ThreadCacheAllocator::ThreadCaches& ThreadCacheAllocator::threadCaches () {
+	thread_local ThreadCaches caches;
+	return caches;
+}
+
+ThreadCacheAllocator::ThreadCache& ThreadCacheAllocator::getCache () {
+	ThreadCache& cache = threadCaches ().caches[_slot];
+
+	//Slot was used by a previous allocator, its blocks are not ours
+	if (cache.owner_id != _id) {
+		cache.reset (_id);
+	}
+
+	return cache;
+}
+
+bool ThreadCacheAllocator::refill (ThreadCache& cache, size_t size_class) {
+	size_t block_size = (size_class + 1) * SIZE_CLASS_GRANULARITY + sizeof (AllocationHeader);
+
+	std::lock_guard<std::mutex> lock (_parent_mutex);
+
+	for (size_t i = 0; i < BATCH_SIZE; i++) {
+		void* raw = _parent->allocate (block_size, sizeof (AllocationHeader));
+		if (raw == nullptr) break;
+
+		AllocationHeader* header = (AllocationHeader*)raw;
+		header->size_class = static_cast<uint32_t>(size_class);
+		header->adjustment = sizeof (AllocationHeader);
+
+		FreeBlock* block = (FreeBlock*)pointerMath::add (raw, sizeof (AllocationHeader));
+		block->next = cache.free_lists[size_class];
+		cache.free_lists[size_class] = block;
+		cache.counts[size_class]++;
+
+		_used_memory += block_size;
+		_num_allocations++;
+		recordAllocation (block_size);
+	}
+
+	return cache.free_lists[size_class] != nullptr;
+}
+
+void ThreadCacheAllocator::release (ThreadCache& cache, size_t size_class, size_t count) {
+	if (count == 0) return;
+
+	size_t block_size = (size_class + 1) * SIZE_CLASS_GRANULARITY + sizeof (AllocationHeader);
+
+	std::lock_guard<std::mutex> lock (_parent_mutex);
+
+	for (size_t i = 0; i < count && cache.free_lists[size_class] != nullptr; i++) {
+		FreeBlock* block = cache.free_lists[size_class];
+		cache.free_lists[size_class] = block->next;
+		cache.counts[size_class]--;
+
+		_parent->deallocate (pointerMath::subtract (block, sizeof (AllocationHeader)));
+		_used_memory -= block_size;
+		_num_allocations--;
+	}
+}
+
+void* ThreadCacheAllocator::allocateLarge (size_t size, uint8_t alignment) {
+	//Header and requested size stored before the block, rounded to the alignment so the returned address stays aligned
+	const size_t header_size = sizeof (size_t) + sizeof (AllocationHeader);
+	size_t adjustment = alignment > header_size ? alignment : header_size;
+	uint8_t parent_alignment = alignment > sizeof (AllocationHeader) ? alignment : sizeof (AllocationHeader);
+
+	std::lock_guard<std::mutex> lock (_parent_mutex);
+
+	void* raw = _parent->allocate (size + adjustment, parent_alignment);
+	if (raw == nullptr) return nullptr;
+
+	void* p = pointerMath::add (raw, adjustment);
+	AllocationHeader* header = (AllocationHeader*)pointerMath::subtract (p, sizeof (AllocationHeader));
+	header->size_class = LARGE_CLASS;
+	header->adjustment = static_cast<uint32_t>(adjustment);
+	*(size_t*)pointerMath::subtract (header, sizeof (size_t)) = size;
+
+	_used_memory += size + adjustment;
+	_num_allocations++;
+	recordAllocation (size);
+
+	return p;
+}
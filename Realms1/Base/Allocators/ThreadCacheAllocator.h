@@ -0,0 +1,83 @@
+#pragma once
+#include "Allocator.h"
+
+#include <mutex>
+
+//Thread-safe front-end for any Allocator : each thread keeps small free lists per size class,
+//the parent is only touched under a lock, in batches, to refill or flush them.
+//Used memory and allocation count are what is currently taken from the parent, cached blocks included.
+class ThreadCacheAllocator : public Allocator {
+public:
+
+	static const size_t SIZE_CLASS_GRANULARITY = 16;
+	static const size_t SIZE_CLASS_COUNT = 16;
+	static const size_t MAX_CACHED_SIZE = SIZE_CLASS_GRANULARITY * SIZE_CLASS_COUNT;
+	static const size_t BATCH_SIZE = 32;
+	static const size_t MAX_INSTANCES = 8;
+
+	ThreadCacheAllocator (Allocator* const& parent);
+	~ThreadCacheAllocator ();
+
+	void* allocate (size_t size, uint8_t alignment) override;
+	void deallocate (void*&& p) override;
+
+	//The parent's, which may grow after construction
+	void* getStart () const override;
+	size_t getSize () const override;
+	size_t getLargestFreeBlock () const override;
+
+	//Give the calling thread's cached blocks back to the parent
+	void flush ();
+
+	Allocator* getParent () const;
+
+private:
+
+	static const uint32_t LARGE_CLASS = SIZE_CLASS_COUNT;
+
+	struct AllocationHeader {
+		uint32_t size_class;
+		uint32_t adjustment;
+	};
+
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	struct ThreadCache {
+		uint64_t owner_id;
+		FreeBlock* free_lists[SIZE_CLASS_COUNT];
+		size_t counts[SIZE_CLASS_COUNT];
+
+		void reset (uint64_t id);
+	};
+
+	//Every cache of one thread, flushed back to their (still alive) owners when the thread exits
+	struct ThreadCaches {
+		ThreadCache caches[MAX_INSTANCES];
+
+		ThreadCaches ();
+		~ThreadCaches ();
+	};
+
+	//Prevent copies because it might cause errors
+	ThreadCacheAllocator (const ThreadCacheAllocator&);
+	ThreadCacheAllocator& operator=(const ThreadCacheAllocator&) = delete;
+
+	static ThreadCaches& threadCaches ();
+
+	ThreadCache& getCache ();
+	bool refill (ThreadCache& cache, size_t size_class);
+	void release (ThreadCache& cache, size_t size_class, size_t count);
+
+	void* allocateLarge (size_t size, uint8_t alignment);
+
+	static std::mutex s_registry_mutex;
+	static ThreadCacheAllocator* s_registry[MAX_INSTANCES];
+	static uint64_t s_next_id;
+
+	Allocator* _parent;
+	std::mutex _parent_mutex;
+	size_t _slot;
+	uint64_t _id;
+};
@@ -0,0 +1,153 @@
+#include "VirtualArena.h"
+
+#include <cassert>
+#include <fstream>
+#include <string>
+
+#ifdef RLMS_PLATFORM_WIN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	inline uintptr_t alignDown (uintptr_t x, size_t align) {
+		return x & ~(static_cast<uintptr_t>(align) - 1);
+	}
+
+	inline uintptr_t alignUp (uintptr_t x, size_t align) {
+		return alignDown (x + align - 1, align);
+	}
+}
+
+const size_t VirtualArena::HUGE_PAGE_SIZE;
+
+VirtualArena::VirtualArena (size_t reserve_size, bool huge_pages) : _start (nullptr), _reserved_size (0), _committed_size (0), _huge_pages (huge_pages && HugePagesAvailable ()) {
+	assert (reserve_size > 0);
+	size_t size = alignUp (reserve_size, getGranularity ());
+
+#ifdef RLMS_PLATFORM_WIN
+	void* p = VirtualAlloc (nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+	if (p == nullptr) return;
+#else
+	//Address space only, no swap or overcommit accounting until pages are made accessible
+	size_t map_size = _huge_pages ? size + HUGE_PAGE_SIZE : size;
+	void* p = mmap (nullptr, map_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (p == MAP_FAILED) return;
+
+	if (_huge_pages) {
+		//Trim the extra mapping so the range starts on a huge page
+		uintptr_t begin = reinterpret_cast<uintptr_t>(p);
+		uintptr_t aligned = alignUp (begin, HUGE_PAGE_SIZE);
+		if (aligned > begin) munmap (p, aligned - begin);
+		if (aligned + size < begin + map_size) munmap (reinterpret_cast<void*>(aligned + size), begin + map_size - (aligned + size));
+		p = reinterpret_cast<void*>(aligned);
+
+#ifdef MADV_HUGEPAGE
+		//Flag kept by the parts of the range later made accessible
+		if (madvise (p, size, MADV_HUGEPAGE) != 0) _huge_pages = false;
+#endif
+	}
+#endif
+
+	_start = p;
+	_reserved_size = size;
+}
+
+VirtualArena::~VirtualArena () {
+	if (_start == nullptr) return;
+
+#ifdef RLMS_PLATFORM_WIN
+	VirtualFree (_start, 0, MEM_RELEASE);
+#else
+	munmap (_start, _reserved_size);
+#endif
+	_start = nullptr;
+}
+
+void* VirtualArena::getStart () const {
+	return _start;
+}
+
+size_t VirtualArena::getReservedSize () const {
+	return _reserved_size;
+}
+
+size_t VirtualArena::getCommittedSize () const {
+	return _committed_size;
+}
+
+bool VirtualArena::commit (size_t size) {
+	if (_start == nullptr || size > _reserved_size) return false;
+
+	size_t new_size = alignUp (size, getGranularity ());
+	if (new_size > _reserved_size) new_size = _reserved_size;
+	if (new_size <= _committed_size) return true;
+
+	void* p = reinterpret_cast<uint8_t*>(_start) + _committed_size;
+	size_t grow = new_size - _committed_size;
+
+	//Pages are still only backed on first touch
+#ifdef RLMS_PLATFORM_WIN
+	if (VirtualAlloc (p, grow, MEM_COMMIT, PAGE_READWRITE) == nullptr) return false;
+#else
+	if (mprotect (p, grow, PROT_READ | PROT_WRITE) != 0) return false;
+#endif
+
+	_committed_size = new_size;
+	return true;
+}
+
+void VirtualArena::decommit (void* p, size_t size) {
+	//Whole huge pages only, dropping part of one would split it
+	uintptr_t begin = alignUp (reinterpret_cast<uintptr_t>(p), getGranularity ());
+	uintptr_t end = alignDown (reinterpret_cast<uintptr_t>(p) + size, getGranularity ());
+	if (begin >= end) return;
+
+	assert (begin >= reinterpret_cast<uintptr_t>(_start) && end <= reinterpret_cast<uintptr_t>(_start) + _committed_size);
+
+	//The range stays committed, reading it back gives zeroes (Linux) or undefined content (Windows)
+#ifdef RLMS_PLATFORM_WIN
+	VirtualAlloc (reinterpret_cast<void*>(begin), end - begin, MEM_RESET, PAGE_READWRITE);
+#else
+	madvise (reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+#endif
+}
+
+bool VirtualArena::usesHugePages () const {
+	return _huge_pages;
+}
+
+size_t VirtualArena::getGranularity () const {
+	return _huge_pages ? HUGE_PAGE_SIZE : PageSize ();
+}
+
+size_t VirtualArena::PageSize () {
+	static const size_t page_size = [] () {
+#ifdef RLMS_PLATFORM_WIN
+		SYSTEM_INFO info;
+		GetSystemInfo (&info);
+		return static_cast<size_t>(info.dwPageSize);
+#else
+		return static_cast<size_t>(sysconf (_SC_PAGESIZE));
+#endif
+	} ();
+	return page_size;
+}
+
+bool VirtualArena::HugePagesAvailable () {
+#if defined RLMS_PLATFORM_LINUX && defined MADV_HUGEPAGE
+	static const bool available = [] () {
+		//"always [madvise] never", only the selected mode is bracketed
+		std::ifstream file ("/sys/kernel/mm/transparent_hugepage/enabled");
+		std::string modes;
+		if (!std::getline (file, modes)) return false;
+		return modes.find ("[never]") == std::string::npos;
+	} ();
+	return available;
+#else
+	//Windows large pages need the lock memory privilege and are committed up front, not worth it here
+	return false;
+#endif
+}
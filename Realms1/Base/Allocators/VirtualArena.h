@@ -0,0 +1,46 @@
+#pragma once
+#include "../../_Preprocess.h"
+
+#include <cstddef>
+#include <cstdint>
+
+//Range of address space reserved up front and backed by physical memory only as it is committed and touched,
+//so large budgets cost nothing until used. Committed memory stays usable until the arena is destroyed,
+//decommit() only hands the physical pages of an unused range back to the system.
+//With huge pages the range is 2 MB aligned and committed / decommitted by whole huge pages, so the system
+//can back it with transparent huge pages, falling back on normal pages when they are unavailable.
+class VirtualArena {
+public:
+	static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+	//Start is nullptr if the address space could not be reserved
+	VirtualArena (size_t reserve_size, bool huge_pages = false);
+	~VirtualArena ();
+
+	void* getStart () const;
+	size_t getReservedSize () const;
+	size_t getCommittedSize () const;
+
+	//False if huge pages were not requested or are not available
+	bool usesHugePages () const;
+	//Commit and decommit unit
+	size_t getGranularity () const;
+
+	//Make [start, start + size) usable, rounded up to whole pages, false if beyond the reservation or refused
+	bool commit (size_t size);
+	//Give back the physical pages fully inside [p, p + size), their content is lost
+	void decommit (void* p, size_t size);
+
+	static size_t PageSize ();
+	static bool HugePagesAvailable ();
+
+private:
+	//Prevent copies because it might cause errors
+	VirtualArena (const VirtualArena&);
+	VirtualArena& operator=(const VirtualArena&) = delete;
+
+	void* _start;
+	size_t _reserved_size;
+	size_t _committed_size;
+	bool _huge_pages;
+};
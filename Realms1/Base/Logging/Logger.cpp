@@ -5,6 +5,12 @@
 
 using namespace rlms;
 
+std::atomic<int> Logger::_level (LogTags::levelOf (LogTags::Debug));
+
+void Logger::SetLevel (const char& tag) {
+	_level.store (LogTags::levelOf (tag), std::memory_order_relaxed);
+}
+
 void Logger::check_line_ended () {
 	size_t found = _current_line.find ('\n');
 	if (found != std::string::npos) {
@@ -1,4 +1,7 @@
 #pragma once
+#include "../../_Preprocess.h"
+
+#include <atomic>
 #include <string>
 #include <sstream>
 
@@ -10,6 +13,16 @@ namespace rlms {
 		constexpr char Dev = 'O';
 		constexpr char Error = 'X';
 		constexpr char Warning = '!';
+
+		//Order of the tags for RLMS_LOG_LEVEL and Logger::SetLevel, None is always logged
+		constexpr int levelOf (char tag) {
+			return tag == Debug ? 0 : tag == Dev ? 1 : tag == Info ? 2 : tag == Warning ? 3 : tag == Error ? 4 : 5;
+		}
+
+		//Tag as a template argument so the level is checked at compile time
+		template<char Tag> struct CompiledIn {
+			static constexpr bool value = levelOf (Tag) >= RLMS_LOG_LEVEL;
+		};
 	}
 
 	class Logger {
@@ -20,6 +33,7 @@ namespace rlms {
 
 		void check_line_ended ();
 		Logger& endl ();
+		static std::atomic<int> _level;
 	protected:
 		bool _is_handler;
 	public:
@@ -47,6 +61,12 @@ namespace rlms {
 			return _disp_name;
 		}
 
+		//Lowest tag logged through RLMS_LOG at runtime, above what is compiled in
+		static void SetLevel (const char& tag);
+		static bool IsEnabled (const char& tag) {
+			return LogTags::levelOf (tag) >= _level.load (std::memory_order_relaxed);
+		}
+
 		void reset ();
 		template<typename T> Logger& operator<<(T data) {
 			std::ostringstream oss;
@@ -56,4 +76,18 @@ namespace rlms {
 			return *this;
 		}
 	};
-}
\ No newline at end of file
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Logs through logger (a pointer) with log_tag, the
+///        arguments streamed after it are only evaluated
+///        when the tag is compiled in and enabled.
+///
+/// Usage example:
+/// \code
+/// RLMS_LOG (logger, LogTags::Debug) << "Getting Component at ID " << c_id << "." << '\n';
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+#define RLMS_LOG(logger, log_tag) \
+	if (!::rlms::LogTags::CompiledIn<log_tag>::value || !::rlms::Logger::IsEnabled (log_tag)) {} else (logger)->tag (log_tag)
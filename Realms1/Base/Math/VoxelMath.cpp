@@ -36,32 +36,33 @@ uint8_t rlms::VoxelMath::BackfacesCulling (glm::vec3 cameraPos) {
 	return backfaces_Culling;
 }
 
-void rlms::VoxelMath::OcclusionCulling (std::vector<std::vector<std::vector<IVoxel>>>& chunk, uint8_t flags) {
-	for (size_t x = 0; x < chunk.size (); x++) {
-		for (size_t y = 0; y < chunk[x].size (); y++) {
-			for (size_t z = 0; z < chunk[x][y].size (); z++) {
+void rlms::VoxelMath::OcclusionCulling (VoxelGrid& chunk, uint8_t flags) {
+	for (size_t x = 0; x < chunk.dim_x; x++) {
+		for (size_t y = 0; y < chunk.dim_y; y++) {
+			for (size_t z = 0; z < chunk.dim_z; z++) {
+				IVoxel& voxel = chunk.at (x, y, z);
 
-				IVoxel::BitSet (chunk[x][y][z], IVoxel::Faces);
+				IVoxel::BitSet (voxel, IVoxel::Faces);
 
-				if (x + 1L < chunk.size ()) {
-					IVoxel::BitReset (chunk[x][y][z], (IVoxel::isTransparent (chunk[x + 1L][y][z]) ? 0 : IVoxel::Xp));
+				if (x + 1L < chunk.dim_x) {
+					IVoxel::BitReset (voxel, (IVoxel::isTransparent (chunk.at (x + 1L, y, z)) ? 0 : IVoxel::Xp));
 				}
 				if (x > 0) {
-					IVoxel::BitReset (chunk[x][y][z], (IVoxel::isTransparent (chunk[x - 1][y][z]) ? 0 : IVoxel::Xn));
+					IVoxel::BitReset (voxel, (IVoxel::isTransparent (chunk.at (x - 1, y, z)) ? 0 : IVoxel::Xn));
 				}
 
-				if (y + 1L < chunk[x].size ()) {
-					IVoxel::BitReset (chunk[x][y][z], (IVoxel::isTransparent (chunk[x][y + 1L][z]) ? 0 : IVoxel::Yp));
+				if (y + 1L < chunk.dim_y) {
+					IVoxel::BitReset (voxel, (IVoxel::isTransparent (chunk.at (x, y + 1L, z)) ? 0 : IVoxel::Yp));
 				}
 				if (y > 0) {
-					IVoxel::BitReset (chunk[x][y][z], (IVoxel::isTransparent (chunk[x][y - 1][z]) ? 0 : IVoxel::Yn));
+					IVoxel::BitReset (voxel, (IVoxel::isTransparent (chunk.at (x, y - 1, z)) ? 0 : IVoxel::Yn));
 				}
 
-				if (z + 1L < chunk[x][y].size ()) {
-					IVoxel::BitReset (chunk[x][y][z], (IVoxel::isTransparent (chunk[x][y][z + 1L]) ? 0 : IVoxel::Zp));
+				if (z + 1L < chunk.dim_z) {
+					IVoxel::BitReset (voxel, (IVoxel::isTransparent (chunk.at (x, y, z + 1L)) ? 0 : IVoxel::Zp));
 				}
 				if (z > 0) {
-					IVoxel::BitReset (chunk[x][y][z], (IVoxel::isTransparent (chunk[x][y][z - 1]) ? 0 : IVoxel::Zn));
+					IVoxel::BitReset (voxel, (IVoxel::isTransparent (chunk.at (x, y, z - 1)) ? 0 : IVoxel::Zn));
 				}
 
 				/*
@@ -2,14 +2,35 @@
 #include "../../CoreTypes.h"
 #include "../../Constants.h"
 #include "IVoxel.h"
+#include "../Allocators/StackAllocator.h"
 
 #include "glm/glm.hpp"
-#include <vector>
+#include <cassert>
 
 namespace rlms {
+	//Dense grid of voxels taken from a stack, released with the enclosing StackScope
+	struct VoxelGrid {
+		IVoxel* data;
+		size_t dim_x, dim_y, dim_z;
+
+		VoxelGrid (StackAllocator& stack, size_t x, size_t y, size_t z) : data (nullptr), dim_x (x), dim_y (y), dim_z (z) {
+			data = static_cast<IVoxel*>(stack.allocate (x * y * z * sizeof (IVoxel), __alignof(IVoxel)));
+			assert (data != nullptr && "Scratch stack exhausted");
+
+			for (size_t i = 0; i < x * y * z; i++) {
+				new (&data[i]) IVoxel ();
+			}
+		}
+
+		//z is contiguous
+		IVoxel& at (size_t x, size_t y, size_t z) {
+			return data[(x * dim_y + y) * dim_z + z];
+		}
+	};
+
 	class VoxelMath {
 	public:
 		static uint8_t BackfacesCulling (glm::vec3 cameraPos);
-		static void OcclusionCulling (std::vector<std::vector<std::vector<IVoxel>>>& chunk, uint8_t flags = IVoxel::Faces);
+		static void OcclusionCulling (VoxelGrid& chunk, uint8_t flags = IVoxel::Faces);
 	};
 }
@@ -7,8 +7,9 @@ namespace rlms {
 
 	using OWNER_ID_TYPE = uint8_t;
 
-	using ENTITY_ID = uint16_t;
-	using COMPONENT_ID = uint16_t;
+	//Generational handles, see IdTable
+	using ENTITY_ID = uint32_t;
+	using COMPONENT_ID = uint32_t;
 	using EVENT_ID = uint16_t;
 
 	using GAME_TICK_TYPE = uint16_t;
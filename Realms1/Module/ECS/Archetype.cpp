@@ -0,0 +1,181 @@
+#include "Archetype.h"
+#include "Entity.h"
+
+using namespace rlms;
+
+const size_t Archetype::CHUNK_SIZE;
+const size_t Archetype::CHUNK_ALIGNMENT;
+const uint16_t Archetype::NO_COLUMN;
+
+Archetype::Archetype (Allocator* const& arena, const ComponentType* const* types, size_t type_count) :
+	_arena (arena),
+	_types (ArenaAllocator<const ComponentType*> (arena)),
+	_signature (),
+	_columns (ArenaAllocator<uint16_t> (arena)),
+	_offsets (ArenaAllocator<size_t> (arena)),
+	_chunks (ArenaAllocator<void*> (arena)),
+	_add_edges (ArenaAllocator<Archetype*> (arena)),
+	_remove_edges (ArenaAllocator<Archetype*> (arena)),
+	_chunk_size (CHUNK_SIZE), _rows_per_chunk (0), _count (0) {
+	assert (type_count < NO_COLUMN);
+
+	size_t row_size = sizeof (ENTITY_ID);
+	for (size_t i = 0; i < type_count; i++) {
+		assert ((i == 0 || types[i - 1]->id < types[i]->id) && "Types must be sorted");
+
+		_types.push_back (types[i]);
+		_signature.set (types[i]->id);
+		row_size += types[i]->size;
+
+		if (types[i]->id >= _columns.size ()) {
+			_columns.resize (types[i]->id + 1, NO_COLUMN);
+		}
+		_columns[types[i]->id] = static_cast<uint16_t>(i);
+	}
+
+	//Columns are padded to their alignment, drop rows until everything fits
+	_rows_per_chunk = CHUNK_SIZE / row_size > 0 ? CHUNK_SIZE / row_size : 1;
+	_offsets.resize (type_count);
+
+	for (;;) {
+		size_t end = sizeof (ENTITY_ID) * _rows_per_chunk;
+		for (size_t i = 0; i < type_count; i++) {
+			end = (end + _types[i]->alignment - 1) & ~(_types[i]->alignment - 1);
+			_offsets[i] = end;
+			end += _types[i]->size * _rows_per_chunk;
+		}
+
+		if (end <= CHUNK_SIZE) break;
+
+		//A single row larger than a chunk gets chunks of its own size
+		if (_rows_per_chunk == 1) {
+			_chunk_size = end;
+			break;
+		}
+		_rows_per_chunk--;
+	}
+}
+
+Archetype::~Archetype () {
+	for (uint32_t row = 0; row < _count; row++) {
+		destroyRow (row);
+	}
+
+	for (auto it = _chunks.begin (); it != _chunks.end (); it++) {
+		_arena->deallocate (std::move (*it));
+	}
+}
+
+bool Archetype::has (uint32_t type_id) const {
+	return type_id < MAX_COMPONENT_TYPES && _signature.test (type_id);
+}
+
+bool Archetype::matches (ComponentSignature const& query) const {
+	return (_signature & query) == query;
+}
+
+const ArenaVector<const ComponentType*>& Archetype::getTypes () const {
+	return _types;
+}
+
+const ComponentSignature& Archetype::getSignature () const {
+	return _signature;
+}
+
+size_t Archetype::getCount () const {
+	return _count;
+}
+
+size_t Archetype::getChunkCount () const {
+	return (_count + _rows_per_chunk - 1) / _rows_per_chunk;
+}
+
+size_t Archetype::getChunkRows (size_t chunk) const {
+	size_t first = chunk * _rows_per_chunk;
+	if (first >= _count) return 0;
+	return _count - first < _rows_per_chunk ? _count - first : _rows_per_chunk;
+}
+
+uint32_t Archetype::pushRow (ENTITY_ID const& e_id) {
+	if (_count == _chunks.size () * _rows_per_chunk) {
+		void* chunk = _arena->allocate (_chunk_size, CHUNK_ALIGNMENT);
+		assert (chunk != nullptr && "Out of memory for archetype chunks");
+		_chunks.push_back (chunk);
+	}
+
+	uint32_t row = static_cast<uint32_t>(_count++);
+	entities (row / _rows_per_chunk)[row % _rows_per_chunk] = e_id;
+	return row;
+}
+
+ENTITY_ID Archetype::removeRow (uint32_t row) {
+	assert (row < _count);
+
+	uint32_t last = static_cast<uint32_t>(_count - 1);
+	ENTITY_ID moved = Entity::NULL_ID;
+
+	if (row != last) {
+		for (uint16_t i = 0; i < _types.size (); i++) {
+			_types[i]->relocate (at (row, i), at (last, i));
+		}
+		moved = getEntity (last);
+		entities (row / _rows_per_chunk)[row % _rows_per_chunk] = moved;
+	}
+	_count--;
+
+	//One spare chunk is kept so rows added and removed around a chunk boundary don't churn the arena
+	if (_chunks.size () * _rows_per_chunk - _count >= 2 * _rows_per_chunk) {
+		_arena->deallocate (std::move (_chunks.back ()));
+		_chunks.pop_back ();
+	}
+
+	return moved;
+}
+
+void Archetype::destroyRow (uint32_t row) {
+	assert (row < _count);
+
+	for (uint16_t i = 0; i < _types.size (); i++) {
+		_types[i]->destroy (at (row, i));
+	}
+}
+
+ENTITY_ID Archetype::getEntity (uint32_t row) const {
+	assert (row < _count);
+	return static_cast<const ENTITY_ID*>(_chunks[row / _rows_per_chunk])[row % _rows_per_chunk];
+}
+
+void* Archetype::get (uint32_t row, uint32_t type_id) {
+	assert (has (type_id));
+	return at (row, _columns[type_id]);
+}
+
+ENTITY_ID* Archetype::entities (size_t chunk) {
+	return static_cast<ENTITY_ID*>(_chunks[chunk]);
+}
+
+Archetype* Archetype::getAddEdge (uint32_t type_id) const {
+	return type_id < _add_edges.size () ? _add_edges[type_id] : nullptr;
+}
+
+Archetype* Archetype::getRemoveEdge (uint32_t type_id) const {
+	return type_id < _remove_edges.size () ? _remove_edges[type_id] : nullptr;
+}
+
+void Archetype::setAddEdge (uint32_t type_id, Archetype* archetype) {
+	if (type_id >= _add_edges.size ()) {
+		_add_edges.resize (type_id + 1, nullptr);
+	}
+	_add_edges[type_id] = archetype;
+}
+
+void Archetype::setRemoveEdge (uint32_t type_id, Archetype* archetype) {
+	if (type_id >= _remove_edges.size ()) {
+		_remove_edges.resize (type_id + 1, nullptr);
+	}
+	_remove_edges[type_id] = archetype;
+}
+
+void* Archetype::at (uint32_t row, uint16_t column) {
+	return pointerMath::add (_chunks[row / _rows_per_chunk], _offsets[column] + (row % _rows_per_chunk) * _types[column]->size);
+}
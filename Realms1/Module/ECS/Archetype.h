@@ -0,0 +1,112 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Memory/ArenaAllocator.h"
+#include "Memory/RelocatingAllocator.h"
+#include "CoreTypes.h"
+#include "IComponent.h"
+#include "TypeId.h"
+
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+
+namespace rlms {
+	////////////////////////////////////////////////////////////
+	/// \brief Type erased description of a component type
+	///        stored in archetypes
+	///
+	////////////////////////////////////////////////////////////
+	struct ComponentType {
+		typedef IComponent* (*AsComponent)(void* p);
+
+		uint32_t id; ///< TypeId<IComponent>, shared with the signatures and pools
+		size_t size;
+		size_t alignment;
+		RelocatingAllocator::RelocateFunction relocate; ///< moves a component and ends the lifetime of the source
+		void (*destroy)(void* p);
+		AsComponent as_component; ///< nullptr for the types not derived from IComponent
+		const char* name;
+
+		//Throws std::length_error for a type past MAX_COMPONENT_TYPES, the first time it is used
+		template<class C> static const ComponentType* of ();
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Every entity with one set of component types
+	///
+	/// Rows live in fixed size chunks, each chunk holding one
+	/// column per component type plus the entity ids. Every
+	/// chunk but the last is full, removing a row moves the
+	/// last one in its place.
+	///
+	////////////////////////////////////////////////////////////
+	class Archetype {
+	public:
+		static const size_t CHUNK_SIZE = 16 * 1024;
+		static const size_t CHUNK_ALIGNMENT = 64;
+		static const uint16_t NO_COLUMN = 0xFFFF;
+
+		//types must be sorted by id
+		Archetype (Allocator* const& arena, const ComponentType* const* types, size_t type_count);
+		~Archetype ();
+
+		bool has (uint32_t type_id) const;
+		//True when every type of query is stored here
+		bool matches (ComponentSignature const& query) const;
+
+		const ArenaVector<const ComponentType*>& getTypes () const;
+		const ComponentSignature& getSignature () const;
+		size_t getCount () const;
+		//Chunks holding at least one row
+		size_t getChunkCount () const;
+		//Rows held by a chunk
+		size_t getChunkRows (size_t chunk) const;
+
+		//Appends a row for e_id, its components are left unconstructed
+		uint32_t pushRow (ENTITY_ID const& e_id);
+		//Components of the row must have been destroyed or moved out, the last row is moved in its place
+		//Returns the entity moved, Entity::NULL_ID if the row was the last
+		ENTITY_ID removeRow (uint32_t row);
+		void destroyRow (uint32_t row);
+
+		ENTITY_ID getEntity (uint32_t row) const;
+		void* get (uint32_t row, uint32_t type_id);
+
+		ENTITY_ID* entities (size_t chunk);
+		template<class C> C* column (size_t chunk);
+
+		//Cached neighbours in the archetype graph, nullptr until first used
+		Archetype* getAddEdge (uint32_t type_id) const;
+		Archetype* getRemoveEdge (uint32_t type_id) const;
+		void setAddEdge (uint32_t type_id, Archetype* archetype);
+		void setRemoveEdge (uint32_t type_id, Archetype* archetype);
+
+	private:
+		//Prevent copies because it might cause errors
+		Archetype (const Archetype&);
+		Archetype& operator=(const Archetype&) = delete;
+
+		void* at (uint32_t row, uint16_t column);
+
+		Allocator* _arena;
+		ArenaVector<const ComponentType*> _types;
+		ComponentSignature _signature;
+		//Column of each type id, NO_COLUMN when absent
+		ArenaVector<uint16_t> _columns;
+		//Offset of each column in a chunk, the entity ids are at 0
+		ArenaVector<size_t> _offsets;
+		ArenaVector<void*> _chunks;
+		ArenaVector<Archetype*> _add_edges;
+		ArenaVector<Archetype*> _remove_edges;
+
+		size_t _chunk_size;
+		size_t _rows_per_chunk;
+		size_t _count;
+	};
+} //namespace rlms
+
+#include "Archetype.inl"
@@ -0,0 +1,38 @@
+#pragma once
+
+namespace rlms {
+	template<class C> inline void destroyComponentType (void* p) {
+		static_cast<C*>(p)->~C ();
+	}
+
+	template<class C> inline IComponent* asComponentType (void* p) {
+		return static_cast<C*>(p);
+	}
+
+	template<class C> inline ComponentType::AsComponent asComponentFunction (std::true_type) {
+		return &asComponentType<C>;
+	}
+
+	template<class C> inline ComponentType::AsComponent asComponentFunction (std::false_type) {
+		return nullptr;
+	}
+
+	template<class C> inline const ComponentType* ComponentType::of () {
+		static_assert (__alignof(C) <= Archetype::CHUNK_ALIGNMENT, "Over-aligned component");
+		uint32_t type_id = TypeId<IComponent>::of<C> ();
+		//Checked in every build, the signatures have no bit for it
+		if (type_id >= MAX_COMPONENT_TYPES) {
+			throw std::length_error ("Too many component types, raise MAX_COMPONENT_TYPES");
+		}
+
+		static const ComponentType type = { type_id, sizeof (C), __alignof(C), &allocator::relocateObject<C>, &destroyComponentType<C>, asComponentFunction<C> (std::is_base_of<IComponent, C> ()), typeid(C).name () };
+		return &type;
+	}
+
+	template<class C> inline C* Archetype::column (size_t chunk) {
+		uint32_t type_id = ComponentType::of<C> ()->id;
+		assert (has (type_id));
+
+		return static_cast<C*>(pointerMath::add (_chunks[chunk], _offsets[_columns[type_id]]));
+	}
+}
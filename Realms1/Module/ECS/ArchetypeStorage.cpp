@@ -0,0 +1,186 @@
+#include "ArchetypeStorage.h"
+
+using namespace rlms;
+
+ArchetypeStorage::ArchetypeStorage (Allocator* const& arena) :
+	_arena (arena),
+	_archetypes (ArenaAllocator<Archetype*> (arena)),
+	_locations (arena, Location{ nullptr, 0 }),
+	_queries (ArenaAllocator<ArchetypeQuery*> (arena)),
+	_queries_mutex () {
+	_archetypes.push_back (allocator::allocateNew<Archetype> (*_arena, _arena, nullptr, 0));
+}
+
+ArchetypeStorage::~ArchetypeStorage () {
+	for (auto it = _queries.begin (); it != _queries.end (); it++) {
+		allocator::deallocateDelete (*_arena, *it);
+	}
+
+	for (auto it = _archetypes.begin (); it != _archetypes.end (); it++) {
+		allocator::deallocateDelete (*_arena, *it);
+	}
+}
+
+void ArchetypeStorage::destroy (ENTITY_ID const& e_id) {
+	Location location = locate (e_id);
+	if (location.archetype == nullptr) return;
+
+	location.archetype->destroyRow (location.row);
+	removeRow (location);
+	_locations.reset (e_id);
+}
+
+void ArchetypeStorage::remove (ENTITY_ID const& e_id, const ComponentType* type) {
+	Location location = locate (e_id);
+
+	if (location.archetype == nullptr || !location.archetype->has (type->id)) return;
+
+	Archetype* to = removeEdge (location.archetype, type);
+
+	//Last component of the entity
+	if (to == _archetypes[0]) {
+		destroy (e_id);
+		return;
+	}
+
+	uint32_t row = move (e_id, location, to);
+	_locations.set (e_id, Location{ to, row });
+}
+
+void* ArchetypeStorage::get (ENTITY_ID const& e_id, const ComponentType* type) {
+	Location location = locate (e_id);
+
+	if (location.archetype == nullptr || !location.archetype->has (type->id)) return nullptr;
+	return location.archetype->get (location.row, type->id);
+}
+
+size_t ArchetypeStorage::getArchetypeCount () const {
+	return _archetypes.size ();
+}
+
+Archetype* ArchetypeStorage::findOrCreate (const ComponentType* const* types, size_t count) {
+	ComponentSignature signature;
+	for (size_t i = 0; i < count; i++) {
+		signature.set (types[i]->id);
+	}
+
+	for (auto it = _archetypes.begin (); it != _archetypes.end (); it++) {
+		if ((*it)->getSignature () == signature) {
+			return *it;
+		}
+	}
+
+	Archetype* archetype = allocator::allocateNew<Archetype> (*_arena, _arena, types, count);
+	_archetypes.push_back (archetype);
+
+	//Cached queries only ever gain archetypes
+	for (auto it = _queries.begin (); it != _queries.end (); it++) {
+		if (archetype->matches ((*it)->signature)) {
+			(*it)->archetypes.push_back (archetype);
+		}
+	}
+
+	return archetype;
+}
+
+ArchetypeQuery* ArchetypeStorage::findOrCreateQuery (ComponentSignature const& signature) {
+	//The archetypes themselves are only created by structural changes, never alongside a parallel phase
+	std::lock_guard<std::mutex> lock (_queries_mutex);
+
+	for (auto it = _queries.begin (); it != _queries.end (); it++) {
+		if ((*it)->signature == signature) {
+			return *it;
+		}
+	}
+
+	ArchetypeQuery* query = allocator::allocateNew<ArchetypeQuery> (*_arena, _arena, signature);
+	for (auto it = _archetypes.begin (); it != _archetypes.end (); it++) {
+		if ((*it)->matches (signature)) {
+			query->archetypes.push_back (*it);
+		}
+	}
+	_queries.push_back (query);
+
+	return query;
+}
+
+Archetype* ArchetypeStorage::addEdge (Archetype* from, const ComponentType* type) {
+	Archetype* to = from->getAddEdge (type->id);
+	if (to != nullptr) return to;
+
+	//Types stay sorted by id
+	const ArenaVector<const ComponentType*>& types = from->getTypes ();
+	ArenaVector<const ComponentType*> with { ArenaAllocator<const ComponentType*> (_arena) };
+	with.reserve (types.size () + 1);
+
+	auto it = types.begin ();
+	for (; it != types.end () && (*it)->id < type->id; it++) {
+		with.push_back (*it);
+	}
+	with.push_back (type);
+	with.insert (with.end (), it, types.end ());
+
+	to = findOrCreate (with.data (), with.size ());
+	from->setAddEdge (type->id, to);
+	to->setRemoveEdge (type->id, from);
+	return to;
+}
+
+Archetype* ArchetypeStorage::removeEdge (Archetype* from, const ComponentType* type) {
+	Archetype* to = from->getRemoveEdge (type->id);
+	if (to != nullptr) return to;
+
+	const ArenaVector<const ComponentType*>& types = from->getTypes ();
+	ArenaVector<const ComponentType*> without { ArenaAllocator<const ComponentType*> (_arena) };
+	without.reserve (types.size ());
+
+	for (auto it = types.begin (); it != types.end (); it++) {
+		if (*it != type) without.push_back (*it);
+	}
+
+	to = findOrCreate (without.data (), without.size ());
+	from->setRemoveEdge (type->id, to);
+	to->setAddEdge (type->id, from);
+	return to;
+}
+
+uint32_t ArchetypeStorage::move (ENTITY_ID const& e_id, Location const& from, Archetype* to) {
+	uint32_t row = to->pushRow (e_id);
+
+	const ArenaVector<const ComponentType*>& types = from.archetype->getTypes ();
+	for (auto it = types.begin (); it != types.end (); it++) {
+		void* src = from.archetype->get (from.row, (*it)->id);
+
+		if (to->has ((*it)->id)) {
+			(*it)->relocate (to->get (row, (*it)->id), src);
+		}
+		else {
+			(*it)->destroy (src);
+		}
+	}
+
+	removeRow (from);
+	return row;
+}
+
+void ArchetypeStorage::removeRow (Location const& location) {
+	ENTITY_ID moved = location.archetype->removeRow (location.row);
+
+	//The archetype's last row took the place of the removed one, unless its slot was reused by a newer entity since
+	if (moved != Entity::NULL_ID) {
+		Location previous = _locations.get (moved);
+		if (previous.archetype == location.archetype && previous.row == location.archetype->getCount ()) {
+			_locations.set (moved, location);
+		}
+	}
+}
+
+ArchetypeStorage::Location ArchetypeStorage::locate (ENTITY_ID const& e_id) const {
+	Location location = _locations.get (e_id);
+
+	//Rows left by a destroyed entity whose slot got reused
+	if (location.archetype == nullptr || location.row >= location.archetype->getCount () || location.archetype->getEntity (location.row) != e_id) {
+		return Location{ nullptr, 0 };
+	}
+	return location;
+}
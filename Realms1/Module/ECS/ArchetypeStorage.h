@@ -0,0 +1,104 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Archetype.h"
+#include "View.h"
+#include "ComponentPool.h"
+#include "Entity.h"
+
+#include <mutex>
+
+namespace rlms {
+	////////////////////////////////////////////////////////////
+	/// \brief Stores the components of each entity in the
+	///        archetype matching its set of component types
+	///
+	/// Adding or removing a component moves the entity's row
+	/// to the neighbouring archetype, found through the edges
+	/// cached on the archetypes after the first move.
+	///
+	////////////////////////////////////////////////////////////
+	class ArchetypeStorage {
+	public:
+		ArchetypeStorage (Allocator* const& arena);
+		~ArchetypeStorage ();
+
+		//Brace-initializes C from args so plain structs work, a C the entity already has is replaced
+		template<class C, class... Args> C* add (ENTITY_ID const& e_id, Args&&... args);
+		template<class C> void remove (ENTITY_ID const& e_id);
+		void remove (ENTITY_ID const& e_id, const ComponentType* type);
+		template<class C> bool has (ENTITY_ID const& e_id) const;
+		//Only valid until the next add, remove or destroy
+		template<class C> C* get (ENTITY_ID const& e_id);
+		void* get (ENTITY_ID const& e_id, const ComponentType* type);
+
+		//Drops every component of the entity
+		void destroy (ENTITY_ID const& e_id);
+
+		//Entities having all of Cs, the matching archetypes are looked up once per set of types
+		//Can be called by systems running in parallel, unlike the structural changes
+		template<class... Cs> View<Cs...> view ();
+
+		//Calls f (ENTITY_ID, Cs&...) for every entity having all of Cs, walking the columns chunk by chunk
+		template<class... Cs, class F> void each (F f);
+
+		size_t getArchetypeCount () const;
+
+	private:
+		struct Location {
+			Archetype* archetype;
+			uint32_t row;
+		};
+
+		//Prevent copies because it might cause errors
+		ArchetypeStorage (const ArchetypeStorage&);
+		ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+		Archetype* findOrCreate (const ComponentType* const* types, size_t count);
+		ArchetypeQuery* findOrCreateQuery (ComponentSignature const& signature);
+		Archetype* addEdge (Archetype* from, const ComponentType* type);
+		Archetype* removeEdge (Archetype* from, const ComponentType* type);
+		//Moves the components both archetypes have, destroys the others and returns the new row
+		uint32_t move (ENTITY_ID const& e_id, Location const& from, Archetype* to);
+		void removeRow (Location const& location);
+		//Location of e_id, no archetype for stale ids
+		Location locate (ENTITY_ID const& e_id) const;
+
+		Allocator* _arena;
+		//The first one has no component type, no entity is ever stored in it
+		ArenaVector<Archetype*> _archetypes;
+		SparseArray<ENTITY_ID, Location> _locations;
+		ArenaVector<ArchetypeQuery*> _queries;
+		//Held while looking up or creating a query
+		std::mutex _queries_mutex;
+	};
+} //namespace rlms
+
+#include "ArchetypeStorage.inl"
+
+////////////////////////////////////////////////////////////
+/// \class rlms::ArchetypeStorage
+/// \ingroup RealmsCore
+///
+/// The ComponentManager keeps the components attached to
+/// entities in one, reached through ComponentManager::GetView.
+/// Used on its own, components don't need to inherit
+/// IComponent : plain structs keep the columns free of vtable
+/// pointers.
+///
+/// Usage example:
+/// \code
+/// ArchetypeStorage storage (arena);
+/// storage.add<Position> (e_id, 0.f, 0.f, 0.f);
+/// storage.add<Velocity> (e_id, 1.f, 0.f, 0.f);
+///
+/// storage.view<Position, Velocity> ().parallelEach ([dt](ENTITY_ID e, Position& p, Velocity& v) {
+/// 	p.x += v.x * dt;
+/// });
+/// \endcode
+///
+/// \see rlms::ComponentManager, rlms::Archetype
+///
+////////////////////////////////////////////////////////////
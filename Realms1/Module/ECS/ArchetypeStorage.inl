@@ -0,0 +1,51 @@
+#pragma once
+
+namespace rlms {
+	template<class C, class... Args> inline C* ArchetypeStorage::add (ENTITY_ID const& e_id, Args&&... args) {
+		assert (e_id != Entity::NULL_ID);
+
+		const ComponentType* type = ComponentType::of<C> ();
+		Location location = locate (e_id);
+
+		if (location.archetype != nullptr && location.archetype->has (type->id)) {
+			C* component = static_cast<C*>(location.archetype->get (location.row, type->id));
+			*component = C{ std::forward<Args> (args)... };
+			return component;
+		}
+
+		Archetype* to = addEdge (location.archetype != nullptr ? location.archetype : _archetypes[0], type);
+		uint32_t row = location.archetype != nullptr ? move (e_id, location, to) : to->pushRow (e_id);
+		_locations.set (e_id, Location{ to, row });
+
+		return new (to->get (row, type->id)) C{ std::forward<Args> (args)... };
+	}
+
+	template<class C> inline void ArchetypeStorage::remove (ENTITY_ID const& e_id) {
+		remove (e_id, ComponentType::of<C> ());
+	}
+
+	template<class C> inline bool ArchetypeStorage::has (ENTITY_ID const& e_id) const {
+		Location location = locate (e_id);
+		return location.archetype != nullptr && location.archetype->has (ComponentType::of<C> ()->id);
+	}
+
+	template<class C> inline C* ArchetypeStorage::get (ENTITY_ID const& e_id) {
+		return static_cast<C*>(get (e_id, ComponentType::of<C> ()));
+	}
+
+	template<class... Cs> inline View<Cs...> ArchetypeStorage::view () {
+		static_assert (sizeof...(Cs) > 0, "View at least one component type");
+
+		const uint32_t type_ids[] = { ComponentType::of<Cs> ()->id... };
+		ComponentSignature signature;
+		for (size_t i = 0; i < sizeof...(Cs); i++) {
+			signature.set (type_ids[i]);
+		}
+
+		return View<Cs...> (findOrCreateQuery (signature));
+	}
+
+	template<class... Cs, class F> inline void ArchetypeStorage::each (F f) {
+		view<Cs...> ().each (f);
+	}
+}
@@ -2,16 +2,16 @@
 
 using namespace rlms;
 
-int ComponentManager::n_errors;
+std::atomic<int> ComponentManager::n_errors (0);
 std::unique_ptr<ComponentManagerImpl> ComponentManager::instance;
 
 std::shared_ptr<LoggerHandler> ComponentManager::GetLogger () {
 	return instance->getLogger();
 }
 
-bool ComponentManager::Initialize (Allocator* const& alloc, size_t entity_pool_size, std::shared_ptr<Logger> funnel) {
+bool ComponentManager::Initialize (BudgetAllocator* const& budget, size_t entity_pool_size, std::shared_ptr<Logger> funnel) {
 	instance = std::make_unique<ComponentManagerImpl> ();
-	return instance->start (alloc, entity_pool_size, funnel);
+	return instance->start (budget, entity_pool_size, funnel);
 }
 
 void ComponentManager::Terminate () {
@@ -19,7 +19,7 @@ void ComponentManager::Terminate () {
 	instance.reset ();
 }
 
-const ENTITY_ID& ComponentManager::GetEntity (COMPONENT_ID c_id) {
+const ENTITY_ID ComponentManager::GetEntity (COMPONENT_ID c_id) {
 	return instance->getEntity (c_id);
 }
 
@@ -36,123 +36,168 @@ IComponent* ComponentManager::GetComponent (COMPONENT_ID c_id) {
 }
 
 void ComponentManager::DestroyComponent (COMPONENT_ID c_id) {
+	assert (!ThreadPool::InParallel () && "Structural changes are not allowed from a parallel phase");
 	instance->destroyComponent (c_id);
 }
 
+void ComponentManager::DestroyComponents (Entity* entity) {
+	assert (!ThreadPool::InParallel () && "Structural changes are not allowed from a parallel phase");
+	instance->destroyComponents (entity);
+}
+
 //////
 
-ComponentManagerImpl::ComponentManagerImpl () : _id_iter (1), _lookup_table() {}
+ComponentManagerImpl::ComponentManagerImpl () : _pools (), _lookup_table (nullptr), _archetypes (nullptr) {}
 
 ComponentManagerImpl::~ComponentManagerImpl () {}
 
-bool ComponentManagerImpl::start (Allocator* const& alloc, size_t component_pool_size, std::shared_ptr<Logger> funnel) {
+bool ComponentManagerImpl::start (BudgetAllocator* const& budget, size_t component_pool_size, std::shared_ptr<Logger> funnel) {
 	startLogger (funnel);
-	logger->tag (LogTags::None) << "Initializing !" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Initializing !" << '\n';
 
-	m_object_Allocator = std::unique_ptr<FreeListAllocator> (new FreeListAllocator (alloc->allocate (component_pool_size), component_pool_size));
+	m_object_Allocator = std::unique_ptr<TLSFAllocator> (new TLSFAllocator (budget->allocate (component_pool_size), component_pool_size));
+	m_object_Allocator->setTag (AllocTag::Component);
+	m_object_Budget = std::make_unique<BudgetAllocator> ("Component", m_object_Allocator.get (), component_pool_size, budget, true);
+	_pools = ArenaVector<IComponentPool*> (ArenaAllocator<IComponentPool*> (m_object_Budget.get ()));
+	_lookup_table = allocator::allocateNew<IdTable<ComponentSlot>> (*m_object_Budget.get (), m_object_Budget.get ());
+	_archetypes = allocator::allocateNew<ArchetypeStorage> (*m_object_Budget.get (), m_object_Budget.get ());
 
-	_id_iter = 1;
 	ComponentManager::n_errors = 0;
-	logger->tag (LogTags::None) << "Initialized correctly !" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Initialized correctly !" << '\n';
 	return true;
 }
 
 void ComponentManagerImpl::stop () {
-	logger->tag (LogTags::None) << "Stopping !" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Stopping !" << '\n';
+
+	//Pools destroy their components
+	for (auto it = _pools.begin (); it != _pools.end (); it++) {
+		if (*it != nullptr) {
+			allocator::deallocateDelete (*m_object_Budget.get (), *it);
+		}
+	}
+	_pools.clear ();
 
-	for (auto it = _lookup_table.begin (); it != _lookup_table.end (); it++) {
-		it->second->~IComponent ();
-		m_object_Allocator->deallocate (it->second);
+	if (_lookup_table != nullptr) {
+		allocator::deallocateDelete (*m_object_Budget.get (), _lookup_table);
 	}
 
-	logger->tag (LogTags::None) << "Stopped correctly !" << '\n';
+	if (_archetypes != nullptr) {
+		allocator::deallocateDelete (*m_object_Budget.get (), _archetypes);
+	}
+
+	RLMS_LOG (logger, LogTags::None) << "Stopped correctly !" << '\n';
 }
 
 const bool ComponentManagerImpl::hasEntity (COMPONENT_ID c_id) {
-	auto it = _lookup_table.find (c_id);
+	ComponentSlot* slot = _lookup_table->get (c_id);
 
-	//Component id is taken
-	if (it == _lookup_table.end ()) {
-		return IComponent::NULL_ID;
+	//Component doesn't exists, or was destroyed since
+	if (slot == nullptr) {
+		return false;
 	}
 
-	return it->second->entity_id();
+	return slot->e_id != Entity::NULL_ID;
 }
 
 const bool ComponentManagerImpl::hasComponent (COMPONENT_ID c_id) {
-	return _lookup_table.find (c_id) != _lookup_table.end ();
+	return _lookup_table->isValid (c_id);
 }
 
-const ENTITY_ID& ComponentManagerImpl::getEntity (COMPONENT_ID const& c_id) {
-	logger->tag (LogTags::Debug) << "Getting Entity ID from Component at ID " << c_id << "." << '\n';
+const ENTITY_ID ComponentManagerImpl::getEntity (COMPONENT_ID const& c_id) {
+	RLMS_LOG (logger, LogTags::Debug) << "Getting Entity ID from Component at ID " << c_id << "." << '\n';
 
 	//Id is invalid
 	if (!ComponentManager::isValid (c_id)) {
-		logger->tag (LogTags::Error) << "ID is invalid !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "ID is invalid !" << '\n';
 		ComponentManager::n_errors++;
 		return Entity::NULL_ID;
 	}
 
-	auto it = _lookup_table.find (c_id);
+	ComponentSlot* slot = _lookup_table->get (c_id);
 
-   //Component doesn't exists
-	if (it == _lookup_table.end ()) {
-		logger->tag (LogTags::Error) << "ID is not taken by a Component !" << '\n';
+	//Component doesn't exists, or was destroyed since
+	if (slot == nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "ID is not taken by a Component !" << '\n';
 		ComponentManager::n_errors++;
 		return Entity::NULL_ID;
 	}
 
-	return it->second->entity_id ();
+	return slot->e_id;
 }
 
 IComponent* ComponentManagerImpl::getComponent (COMPONENT_ID const& c_id) {
-	logger->tag (LogTags::Debug) << "Getting Component at ID " << c_id << "." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "Getting Component at ID " << c_id << "." << '\n';
 
 	//Id is invalid
 	if (!ComponentManager::isValid (c_id)) {
-		logger->tag (LogTags::Error) << "ID is invalid !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "ID is invalid !" << '\n';
 		ComponentManager::n_errors++;
 		return nullptr;
 	}
 
-	auto it = _lookup_table.find (c_id);
+	ComponentSlot* slot = _lookup_table->get (c_id);
 
-   //Component doesn't exists
-	if (it == _lookup_table.end ()) {
-		logger->tag (LogTags::Error) << "ID is not taken by a Component !" << '\n';
+	//Component doesn't exists, or was destroyed since
+	if (slot == nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "ID is not taken by a Component !" << '\n';
 		ComponentManager::n_errors++;
 		return nullptr;
 	}
 
-	return it->second;
+	if (slot->pool != nullptr) {
+		return slot->pool->getById (c_id);
+	}
+	return slot->type->as_component (_archetypes->get (slot->e_id, slot->type));
 }
 
 void ComponentManagerImpl::destroyComponent (COMPONENT_ID c_id) {
-	logger->tag (LogTags::Debug) << "Destroying Component at ID " << c_id << "." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "Destroying Component at ID " << c_id << "." << '\n';
 
 	//Id is invalid
 	if (!ComponentManager::isValid (c_id)) {
-		logger->tag (LogTags::Error) << "ID is invalid !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "ID is invalid !" << '\n';
 		ComponentManager::n_errors++;
 		return;
 	}
 
-	auto it = _lookup_table.find (c_id);
+	ComponentSlot* slot = _lookup_table->get (c_id);
 
-   //Component doesn't exists
-	if (it == _lookup_table.end ()) {
-		logger->tag (LogTags::Error) << "ID is not taken by a Component !" << '\n';
+	//Component doesn't exists, or was destroyed since
+	if (slot == nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "ID is not taken by a Component !" << '\n';
 		ComponentManager::n_errors++;
 		return;
 	}
 
+	if (slot->pool != nullptr) {
+		slot->pool->remove (c_id);
+	}
+	else {
+		if (EntityManager::HasEntity (slot->e_id)) {
+			EntityManager::GetEntity (slot->e_id)->remComponent (c_id);
+		}
+		_archetypes->remove (slot->e_id, slot->type);
+	}
+	_lookup_table->destroy (c_id);
+}
+
+void ComponentManagerImpl::destroyComponents (Entity* entity) {
+	RLMS_LOG (logger, LogTags::Debug) << "Destroying the Components of Entity at : " << std::hex << entity << "." << '\n';
+
+	//Entity doesn't exists
+	if (entity == nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "Entity ref is null !" << '\n';
+		ComponentManager::n_errors++;
+		return;
+	}
 
-	it->second->~IComponent ();
-	m_object_Allocator->deallocate (it->second);
-	
-	if (EntityManager::HasEntity (it->second->entity_id ())) {
-		EntityManager::GetEntity (it->second->entity_id ())->remComponent (it->second);
+	std::vector<COMPONENT_ID> components = entity->getComponents ();
+	for (auto it = components.begin (); it != components.end (); it++) {
+		entity->remComponent (*it);
+		_lookup_table->destroy (*it);
 	}
-	
-	_lookup_table.erase (c_id);
+
+	//Rather than moving the row to a smaller archetype once per component
+	_archetypes->destroy (entity->id ());
 }
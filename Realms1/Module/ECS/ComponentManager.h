@@ -3,14 +3,22 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
-#include "Memory/FreeListAllocator.h"
+#include "Memory/TLSFAllocator.h"
+#include "Memory/ArenaAllocator.h"
+#include "Memory/BudgetAllocator.h"
 #include "IO/ILogged.h"
 #include "EntityManager.h"
 #include "IComponent.h"
+#include "ComponentPool.h"
+#include "ArchetypeStorage.h"
 #include "Entity.h"
+#include "IdTable.h"
+#include "../../Utility/MultiThreading/ThreadPool.h"
 
-#include <map>
+#include <atomic>
+#include <cassert>
 #include <memory>
+#include <type_traits>
 
 namespace rlms {
 	////////////////////////////////////////////////////////////
@@ -37,7 +45,7 @@ namespace rlms {
 		////////////////////////////////////////////////////////////
 		// Static member data
 		////////////////////////////////////////////////////////////
-		static int n_errors; ///< Public simple var to check how many errors happenned.
+		static std::atomic<int> n_errors; ///< Public simple var to check how many errors happenned.
 
 
 		////////////////////////////////////////////////////////////
@@ -54,7 +62,7 @@ namespace rlms {
 		/// \return bool saying rather or not the start was 
 		///
 		////////////////////////////////////////////////////////////
-		static bool Initialize (Allocator* const& alloc, size_t entity_pool_size, std::shared_ptr<Logger> funnel = nullptr);
+		static bool Initialize (BudgetAllocator* const& budget, size_t entity_pool_size, std::shared_ptr<Logger> funnel = nullptr);
 
 		////////////////////////////////////////////////////////////
 		/// \brief End the ComponentManager in the expected manner.
@@ -66,24 +74,70 @@ namespace rlms {
 			return c_id != IComponent::NULL_ID;
 		}
 
+		////////////////////////////////////////////////////////////
+		/// \brief Create the pool of C now, so the systems running
+		///        in parallel never add one (see ISystem)
+		///
+		/// Only the components created without an entity are in
+		/// a pool, nothing is done for types not derived from
+		/// IComponent.
+		///
+		////////////////////////////////////////////////////////////
+		template<class C> static void ReservePool ();
+
+		//Creating and destroying components is only allowed from the tick's thread (see ISystem)
 		template<class C> static const COMPONENT_ID CreateComponent ();
 		template<class C> static const COMPONENT_ID CreateComponent (Entity* entity);
-		template<class C> static const COMPONENT_ID CreateComponent (Entity* entity, COMPONENT_ID c_id);
-		template<class C> static const COMPONENT_ID CreateComponent (COMPONENT_ID c_id);
 
 		static const bool HasEntity (COMPONENT_ID c_id);
 		template<class C> static const bool HasComponent (Entity* entity);
 		template<class C> static const bool HasComponent (COMPONENT_ID c_id);
 		static const bool HasComponent (COMPONENT_ID c_id);
 
-		static const ENTITY_ID& GetEntity (COMPONENT_ID c_id);
+		static const ENTITY_ID GetEntity (COMPONENT_ID c_id);
 		template<class C> static C* GetComponent (Entity* entity);
 		template<class C> static C* GetComponent (COMPONENT_ID c_id);
-		template<class C> static std::vector<C*> GetComponents ();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Every C type component created without an
+		///        entity, packed contiguously
+		///
+		/// Those attached to an entity are stored with its other
+		/// components, reach them with GetView.
+		///
+		/// \return the pool of C, iterate it with a range for
+		///
+		////////////////////////////////////////////////////////////
+		template<class C> static ComponentPool<C>& GetComponents ();
+
+		////////////////////////////////////////////////////////////
+		/// \brief Entities having a component of each of Cs
+		///
+		/// The archetypes matching Cs are cached by the storage
+		/// and completed as new ones are created, the view walks
+		/// their columns in order.
+		///
+		/// \return a view to iterate with each or parallelEach
+		///
+		////////////////////////////////////////////////////////////
+		template<class... Cs> static View<Cs...> GetView ();
+
 		static IComponent* GetComponent (COMPONENT_ID c_id);
 
 		template<class C> static void DestroyComponent (Entity* entity);
 		static void DestroyComponent (COMPONENT_ID c_id);
+		//Every component attached to the entity, its archetype row is dropped at once
+		static void DestroyComponents (Entity* entity);
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Where the component of an id is stored
+	///
+	////////////////////////////////////////////////////////////
+	struct ComponentSlot {
+		IComponentPool* pool; ///< nullptr for a component attached to an entity, stored in its archetype
+		ENTITY_ID e_id;
+		const ComponentType* type;
 	};
 
 	class ComponentManagerImpl : public ILogged {
@@ -94,35 +148,41 @@ namespace rlms {
 			return "ComponentManager";
 		};
 
-		std::map<ENTITY_ID, IComponent*> _lookup_table;
-		std::unique_ptr<FreeListAllocator> m_object_Allocator;
-
-		bool start (Allocator* const& alloc, size_t entity_pool_size, std::shared_ptr<Logger> funnel);
+		//Declared first so the pools are released before their arena
+		std::unique_ptr<TLSFAllocator> m_object_Allocator;
+		//Pools and the lookup table are allocated through it, spilling to the game budget once the pool is full
+		std::unique_ptr<BudgetAllocator> m_object_Budget;
+		//Components created without an entity, one sparse set per component type at TypeId<IComponent>::of<C> ()
+		ArenaVector<IComponentPool*> _pools;
+		//Hands out the component ids, with where each one is stored
+		IdTable<ComponentSlot>* _lookup_table;
+		//Components attached to an entity, grouped by the entity's set of types
+		ArchetypeStorage* _archetypes;
+
+		template<class C> ComponentPool<C>& getPool ();
+		template<class C> void reservePool (std::true_type);
+		template<class C> void reservePool (std::false_type);
+
+		bool start (BudgetAllocator* const& budget, size_t entity_pool_size, std::shared_ptr<Logger> funnel);
 		void stop ();
 
 		template<class C> const COMPONENT_ID createComponent ();
 		template<class C> const COMPONENT_ID createComponent (Entity* entity);
-		template<class C> const COMPONENT_ID createComponent (Entity* entity, COMPONENT_ID c_id);
-		template<class C> const COMPONENT_ID createComponent (COMPONENT_ID c_id);
 
 		const bool hasEntity (COMPONENT_ID c_id);
 		template<class C> const bool hasComponent (Entity* entity);
 		template<class C> const bool hasComponent (COMPONENT_ID c_id);
 		const bool hasComponent (COMPONENT_ID c_id);
 
-		const ENTITY_ID& getEntity (COMPONENT_ID const& c_id);
+		const ENTITY_ID getEntity (COMPONENT_ID const& c_id);
 		template<class C> C* getComponent (Entity* entity);
 		template<class C> C* getComponent (COMPONENT_ID const& c_id);
-		template<class C> static std::vector<C*> getComponents ();
+		template<class C> ComponentPool<C>& getComponents ();
 		IComponent* getComponent (COMPONENT_ID const& c_id);
 
 		template<class C> void destroyComponent (Entity* entity);
 		void destroyComponent (COMPONENT_ID c_id);
-
-		COMPONENT_ID _id_iter;
-		inline COMPONENT_ID procedural_id_iter () {
-			return _id_iter++;
-		}
+		void destroyComponents (Entity* entity);
 	public:
 
 		ComponentManagerImpl ();
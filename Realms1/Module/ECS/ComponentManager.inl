@@ -1,248 +1,219 @@
 #include "ComponentManager.h"
 
+template<class C> inline void ComponentManager::ReservePool () {
+	//Systems can be built before the manager, in tests
+	if (instance != nullptr) {
+		instance->reservePool<C> (std::is_base_of<IComponent, C> ());
+	}
+}
+
 template<class C> const COMPONENT_ID ComponentManager::CreateComponent () {
+	assert (!ThreadPool::InParallel () && "Structural changes are not allowed from a parallel phase");
 	return instance->createComponent<C> ();
 }
 
 template<class C> const COMPONENT_ID ComponentManager::CreateComponent (Entity* entity) {
+	assert (!ThreadPool::InParallel () && "Structural changes are not allowed from a parallel phase");
 	return instance->createComponent<C> (entity);
 }
 
-template<class C> const COMPONENT_ID ComponentManager::CreateComponent (Entity* entity, COMPONENT_ID c_id) {
-	return instance->createComponent<C> (entity, c_id);
-}
-
-template<class C> const COMPONENT_ID ComponentManager::CreateComponent (COMPONENT_ID c_id) {
-	return instance->createComponent<C> (c_id);
-}
-
 template<class C> const bool ComponentManager::HasComponent (Entity* entity) {
 	return instance->hasComponent<C> (entity);
 }
 
+template<class C> const bool ComponentManager::HasComponent (COMPONENT_ID c_id) {
+	return instance->hasComponent<C> (c_id);
+}
+
 template<class C> C* ComponentManager::GetComponent (Entity* entity) {
 	return instance->getComponent<C> (entity);
 }
 
-template<class C> inline C* ComponentManager::GetComponent (ENTITY_ID e_id) {
-	return instance->getComponent<C> (e_id);
+template<class C> inline C* ComponentManager::GetComponent (COMPONENT_ID c_id) {
+	return instance->getComponent<C> (c_id);
+}
+
+template<class C> ComponentPool<C>& ComponentManager::GetComponents () {
+	return instance->getComponents<C> ();
 }
 
-template<class C> std::vector<C*> ComponentManager::GetComponents () {
-	return;
+template<class... Cs> View<Cs...> ComponentManager::GetView () {
+	return instance->_archetypes->view<Cs...> ();
 }
 
 template<class C> void ComponentManager::DestroyComponent (Entity* entity) {
+	assert (!ThreadPool::InParallel () && "Structural changes are not allowed from a parallel phase");
 	instance->destroyComponent<C> (entity);
 }
 
 ///////
 
-template<class C> inline const COMPONENT_ID ComponentManagerImpl::createComponent () {
-	COMPONENT_ID c_id = procedural_id_iter();
-	logger->tag (LogTags::Debug) << "Creating " << typeid(C).name () << " with procedural ID : " << c_id << "." << '\n';
+template<class C> inline ComponentPool<C>& ComponentManagerImpl::getPool () {
+	uint32_t index = TypeId<IComponent>::of<C> ();
 
-	auto it = _lookup_table.find (c_id);
+	if (index >= _pools.size ()) {
+		_pools.resize (index + 1, nullptr);
+	}
 
-   //Component id isn't taken
-	if (it != _lookup_table.end ()) {
-		ComponentManager::n_errors++;
-		logger->tag (LogTags::Error) << "ID already taken by a Component !" << '\n';
-		return IComponent::NULL_ID;
+	//First component of that type
+	if (_pools[index] == nullptr) {
+		_pools[index] = allocator::allocateNew<ComponentPool<C>> (*m_object_Budget.get (), m_object_Budget.get ());
 	}
 
-	//Valid
+	return *static_cast<ComponentPool<C>*>(_pools[index]);
+}
 
-	C* new_component = new (m_object_Allocator->allocate (sizeof (C), __alignof(C))) C (Entity::NULL_ID, c_id);
-	_lookup_table.insert (std::pair<COMPONENT_ID, IComponent*> (c_id, new_component));
-	return c_id;
+template<class C> inline void ComponentManagerImpl::reservePool (std::true_type) {
+	getPool<C> ();
 }
 
-template<class C> inline const COMPONENT_ID ComponentManagerImpl::createComponent (COMPONENT_ID c_id) {
-	logger->tag (LogTags::Debug) << "Creating " << typeid(C).name () << " with predefined ID : " << c_id << "." << '\n';
+template<class C> inline void ComponentManagerImpl::reservePool (std::false_type) {}
 
-	//Id is invalid
-	if (!ComponentManager::isValid (c_id)) {
+template<class C> inline const COMPONENT_ID ComponentManagerImpl::createComponent () {
+	//The lookup table keeps its ComponentType
+	if (TypeId<IComponent>::of<C> () >= MAX_COMPONENT_TYPES) {
+		RLMS_LOG (logger, LogTags::Error) << "Too many component types for " << typeid(C).name () << ", raise MAX_COMPONENT_TYPES !" << '\n';
 		ComponentManager::n_errors++;
-		logger->tag (LogTags::Error) << "ID is invalid !" << '\n';
 		return IComponent::NULL_ID;
 	}
 
-	auto it = _lookup_table.find (c_id);
+	ComponentPool<C>& pool = getPool<C> ();
+	COMPONENT_ID c_id = _lookup_table->create (ComponentSlot{ &pool, Entity::NULL_ID, ComponentType::of<C> () });
 
-   //Component id isn't taken
-	if (it != _lookup_table.end ()) {
+	//Every slot is taken
+	if (!ComponentManager::isValid (c_id)) {
 		ComponentManager::n_errors++;
-		logger->tag (LogTags::Error) << "ID already taken by a Component !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "No component id left !" << '\n';
 		return IComponent::NULL_ID;
 	}
 
 	//Valid
-
-	C* new_component = new (m_object_Allocator->allocate (sizeof (C), __alignof(C))) C (Entity::NULL_ID, c_id);
-	_lookup_table.insert (std::pair<COMPONENT_ID, IComponent*> (c_id, new_component));
+	RLMS_LOG (logger, LogTags::Debug) << "Created " << typeid(C).name () << " with ID : " << c_id << "." << '\n';
+	pool.add (Entity::NULL_ID, c_id);
 	return c_id;
 }
 
 template<class C> inline const COMPONENT_ID ComponentManagerImpl::createComponent (Entity* entity) {
-	COMPONENT_ID c_id = procedural_id_iter();
-	logger->tag (LogTags::Debug) << "Creating " << typeid(C).name () << " with procedural ID : " << c_id << "." << '\n';
-
 	//Entity doesn't exists
 	if (entity == nullptr) {
-		logger->tag (LogTags::Error) << "Entity ref is null !" << '\n';
-		ComponentManager::n_errors++;
-		return IComponent::NULL_ID;
-	}
-
-	//Component is not duplicate
-	if (entity->hasComponent<C> ()) {
-		logger->tag (LogTags::Error) << "Component already exists for this Entity!" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "Entity ref is null !" << '\n';
 		ComponentManager::n_errors++;
 		return IComponent::NULL_ID;
 	}
 
-	auto it = _lookup_table.find (c_id);
-
-   //Component id isn't taken
-	if (it != _lookup_table.end ()) {
-		logger->tag (LogTags::Error) << "ID already taken by a Component !" << '\n';
-		ComponentManager::n_errors++;
-		return IComponent::NULL_ID;
-	}
-
-	//Valid
-
-	C* new_component = allocator::allocateNew<C,ENTITY_ID, COMPONENT_ID> (*m_object_Allocator.get (), std::move(entity->id()), std::move (c_id));
-	_lookup_table.insert (std::pair<COMPONENT_ID, IComponent*> (c_id, new_component));
-	entity->addComponent<C> (new_component);
-	return c_id;
-}
-
-template<class C> inline const COMPONENT_ID ComponentManagerImpl::createComponent (Entity* entity, COMPONENT_ID c_id) {
-	logger->tag (LogTags::Debug) << "creating " << typeid(C).name() << " with predefined ID : " << c_id << "." << '\n';
-
-	//Id is invalid
-	if (!ComponentManager::isValid(c_id)) {
-		logger->tag (LogTags::Error) << "ID is invalid !" << '\n';
-		ComponentManager::n_errors++;
-		return IComponent::NULL_ID;
-	}
-
-	//Entity doesn't exists
-	if (entity == nullptr) {
-		logger->tag (LogTags::Error) << "Entity ref is null !" << '\n';
+	//The entity's signature has no bit for it
+	if (TypeId<IComponent>::of<C> () >= MAX_COMPONENT_TYPES) {
+		RLMS_LOG (logger, LogTags::Error) << "Too many component types for " << typeid(C).name () << ", raise MAX_COMPONENT_TYPES !" << '\n';
 		ComponentManager::n_errors++;
 		return IComponent::NULL_ID;
 	}
 
 	//Component is not duplicate
-	if (entity->hasComponent<C> ()) {
-		logger->tag (LogTags::Error) << "Component already exists for this Entity!" << '\n';
+	if (_archetypes->has<C> (entity->id ())) {
+		RLMS_LOG (logger, LogTags::Error) << "Component already exists for this Entity!" << '\n';
 		ComponentManager::n_errors++;
 		return IComponent::NULL_ID;
 	}
 
-	auto it = _lookup_table.find (c_id);
+	COMPONENT_ID c_id = _lookup_table->create (ComponentSlot{ nullptr, entity->id (), ComponentType::of<C> () });
 
-   //Component id isn't taken
-	if (it != _lookup_table.end ()) {
-		logger->tag (LogTags::Error) << "ID already taken by a Component !" << '\n';
+	//Every slot is taken
+	if (!ComponentManager::isValid (c_id)) {
+		RLMS_LOG (logger, LogTags::Error) << "No component id left !" << '\n';
 		ComponentManager::n_errors++;
 		return IComponent::NULL_ID;
 	}
 
 	//Valid
-	C* new_component = new (m_object_Allocator->allocate (sizeof (C), __alignof(C))) C (entity->id(), c_id);
-	_lookup_table.insert (std::pair<COMPONENT_ID, IComponent*> (c_id, new_component));
-	entity->addComponent<C> (new_component);
+	RLMS_LOG (logger, LogTags::Debug) << "Created " << typeid(C).name () << " with ID : " << c_id << "." << '\n';
+	//Moves the entity's other components to the archetype with C
+	_archetypes->add<C> (entity->id (), entity->id (), c_id);
+	entity->addComponent<C> (c_id);
 	return c_id;
 }
 
 template<class C> inline const bool ComponentManagerImpl::hasComponent (Entity* entity) {
-	return entity->hasComponent<C>();
+	return entity != nullptr && entity->hasComponent<C> ();
 }
 
 template<class C>inline const bool ComponentManagerImpl::hasComponent (COMPONENT_ID c_id) {
-	return _lookup_table.find (c_id) != _lookup_table.end ();
+	ComponentSlot* slot = _lookup_table->get (c_id);
+	return slot != nullptr && slot->type->id == TypeId<IComponent>::of<C> ();
 }
 
 template<class C> inline C* ComponentManagerImpl::getComponent (Entity* entity) {
-	logger->tag (LogTags::Debug) << "Getting " << typeid(C).name () << " from Entity at : " << std::hex << entity << "." << '\n';
-	COMPONENT_ID c_id = IComponent::NULL_ID;
+	RLMS_LOG (logger, LogTags::Debug) << "Getting " << typeid(C).name () << " from Entity at : " << std::hex << entity << "." << '\n';
 
 	//Entity doesn't exists
 	if (entity == nullptr) {
-		logger->tag (LogTags::Error) << "Entity ref is null !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "Entity ref is null !" << '\n';
 		ComponentManager::n_errors++;
-		return IComponent::NULL_ID;
+		return nullptr;
 	}
 
+	C* comp = entity->hasComponent<C> () ? _archetypes->get<C> (entity->id ()) : nullptr;
+
 	//Component exists
-	if (!entity->hasComponent<C>()) {
-		logger->tag (LogTags::Error) << "Entity does not have Component of that type !" << '\n';
+	if (comp == nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "Entity does not have Component of that type !" << '\n';
 		ComponentManager::n_errors++;
-		return IComponent::NULL_ID;
+		return nullptr;
 	}
 
-	return entity->getComponent<C>();
+	return comp;
 }
 
 template<class C> inline C* ComponentManagerImpl::getComponent (COMPONENT_ID const& c_id) {
-	logger->tag (LogTags::Debug) << "Getting " << typeid(C).name () << " Component with ID : " << c_id << "." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "Getting " << typeid(C).name () << " Component with ID : " << c_id << "." << '\n';
 
 	//Id is invalid
 	if (!ComponentManager::isValid (c_id)) {
-		logger->tag (LogTags::Error) << "ID is invalid !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "ID is invalid !" << '\n';
 		ComponentManager::n_errors++;
 		return nullptr;
 	}
 
-	auto it = _lookup_table.find (c_id);
+	ComponentSlot* slot = _lookup_table->get (c_id);
+	C* comp = nullptr;
+	if (slot != nullptr && slot->type->id == TypeId<IComponent>::of<C> ()) {
+		comp = slot->pool != nullptr ? static_cast<ComponentPool<C>*>(slot->pool)->getById (c_id) : _archetypes->get<C> (slot->e_id);
+	}
 
-	//Entity doesn't exists
-	if (it == _lookup_table.end ()) {
-		logger->tag (LogTags::Error) << "ID is not taken by an Entity !" << '\n';
+	//Component doesn't exists
+	if (comp == nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "ID is not taken by a Component of that type !" << '\n';
 		ComponentManager::n_errors++;
 		return nullptr;
 	}
 
-	return static_cast<C*>(it->second);
+	return comp;
 }
 
-template<class C>
-inline std::vector<C*> ComponentManagerImpl::getComponents () {
-	std::vector<C*> vec;
-	for (auto it = _lookup_table.begin (); it != _lookup_table.end (); it++) {
-		if (it->second != nullptr) {
-			if(typeid(it->second) == typeid(C))
-				vec.push_back (it->second);
-		}
-	}
-	return vec;
+template<class C> inline ComponentPool<C>& ComponentManagerImpl::getComponents () {
+	return getPool<C> ();
 }
 
 template<class C> inline void ComponentManagerImpl::destroyComponent (Entity* entity) {
-	logger->tag (LogTags::Debug) << "Destroying " << typeid(C).name () << " from Entity at : " << std::hex << entity << "." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "Destroying " << typeid(C).name () << " from Entity at : " << std::hex << entity << "." << '\n';
 
 	//Entity doesn't exists
 	if (entity == nullptr) {
-		logger->tag (LogTags::Error) << "Entity ref is null !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "Entity ref is null !" << '\n';
 		ComponentManager::n_errors++;
 		return;
 	}
 
-	C* comp = entity->getComponent<C>();
+	C* comp = entity->hasComponent<C> () ? _archetypes->get<C> (entity->id ()) : nullptr;
 
 	//
 	if (comp == nullptr) {
-		logger->tag (LogTags::Debug) << "Component does not exist !" << '\n';
+		RLMS_LOG (logger, LogTags::Debug) << "Component does not exist !" << '\n';
 		ComponentManager::n_errors++;
 		return;
 	}
 
-	comp->~C ();
-	m_object_Allocator->deallocate (comp);
+	COMPONENT_ID c_id = comp->id ();
 	entity->remComponent<C> ();
-	_lookup_table.erase (comp->id ());
+	_archetypes->remove<C> (entity->id ());
+	_lookup_table->destroy (c_id);
 }
@@ -0,0 +1,122 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Memory/ArenaAllocator.h"
+#include "IComponent.h"
+#include "Entity.h"
+#include "IdTable.h"
+
+#include <limits>
+
+namespace rlms {
+	////////////////////////////////////////////////////////////
+	/// \brief Paged id to value table, a page is only allocated
+	///        once an id in its range is used.
+	///
+	/// Keyed by the slot of generational ids (see IdTable), so
+	/// an id and the stale ids of its slot share an entry :
+	/// callers check the generation against the stored value.
+	///
+	////////////////////////////////////////////////////////////
+	template<class K, class V> class SparseArray {
+	public:
+		static const size_t PAGE_SIZE = 256;
+
+		SparseArray (Allocator* const& arena, V const& null_value);
+		~SparseArray ();
+
+		V get (K const& id) const;
+		void set (K const& id, V const& value);
+		void reset (K const& id);
+
+	private:
+		//Prevent copies because it might cause errors
+		SparseArray (const SparseArray&);
+		SparseArray& operator=(const SparseArray&) = delete;
+
+		Allocator* _arena;
+		V _null_value;
+		ArenaVector<V*> _pages;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Type erased access to a ComponentPool, used by the
+	///        ComponentManager for the id based calls.
+	///
+	////////////////////////////////////////////////////////////
+	class IComponentPool {
+	public:
+		virtual ~IComponentPool () {}
+
+		virtual bool hasId (COMPONENT_ID const& c_id) const = 0;
+		virtual IComponent* getById (COMPONENT_ID const& c_id) = 0;
+		virtual void remove (COMPONENT_ID const& c_id) = 0;
+		virtual size_t size () const = 0;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sparse set of every component of type C
+	///
+	/// Components are packed in one contiguous array, removal
+	/// moves the last one in the hole. The sparse tables give
+	/// the dense index of an entity or component id in O(1).
+	///
+	////////////////////////////////////////////////////////////
+	template<class C> class ComponentPool : public IComponentPool {
+	public:
+		static const uint32_t NULL_INDEX = std::numeric_limits<uint32_t>::max ();
+
+		ComponentPool (Allocator* const& arena);
+		~ComponentPool ();
+
+		//Constructs C (e_id, c_id) at the end of the dense array, e_id can be Entity::NULL_ID
+		C* add (ENTITY_ID const& e_id, COMPONENT_ID const& c_id);
+
+		bool hasEntity (ENTITY_ID const& e_id) const;
+		bool hasId (COMPONENT_ID const& c_id) const override;
+
+		C* getByEntity (ENTITY_ID const& e_id);
+		C* getById (COMPONENT_ID const& c_id) override;
+
+		void remove (COMPONENT_ID const& c_id) override;
+		size_t size () const override;
+
+		//Dense iteration, invalidated by add and remove
+		C* begin ();
+		C* end ();
+		C& operator[] (size_t index);
+
+	private:
+		//Prevent copies because it might cause errors
+		ComponentPool (const ComponentPool&);
+		ComponentPool& operator=(const ComponentPool&) = delete;
+
+		ArenaVector<C> _dense;
+		SparseArray<ENTITY_ID, uint32_t> _entity_index;
+		SparseArray<COMPONENT_ID, uint32_t> _id_index;
+	};
+} //namespace rlms
+
+#include "ComponentPool.inl"
+
+////////////////////////////////////////////////////////////
+/// \class rlms::ComponentPool
+/// \ingroup RealmsCore
+///
+/// The ComponentManager keeps one pool per component type,
+/// for the components created without an entity.
+/// Pointers to components stay valid until the next add or
+/// remove on the same pool, keep ids rather than pointers.
+///
+/// Usage example:
+/// \code
+/// for (HealthComponent& h : ComponentManager::GetComponents<HealthComponent> ()) {
+/// 	h.cur_hp += h.reg_hp;
+/// }
+/// \endcode
+///
+/// \see rlms::ComponentManager, rlms::IComponent
+///
+////////////////////////////////////////////////////////////
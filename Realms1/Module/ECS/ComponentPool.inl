@@ -0,0 +1,129 @@
+#pragma once
+
+namespace rlms {
+	template<class K, class V> const size_t SparseArray<K, V>::PAGE_SIZE;
+
+	template<class K, class V> inline SparseArray<K, V>::SparseArray (Allocator* const& arena, V const& null_value) : _arena (arena), _null_value (null_value), _pages (ArenaAllocator<V*> (arena)) {}
+
+	template<class K, class V> inline SparseArray<K, V>::~SparseArray () {
+		for (size_t i = 0; i < _pages.size (); i++) {
+			if (_pages[i] != nullptr) {
+				_arena->deallocate (_pages[i]);
+			}
+		}
+	}
+
+	template<class K, class V> inline V SparseArray<K, V>::get (K const& id) const {
+		size_t slot = IdTable<K>::IndexOf (id);
+		V* page = slot / PAGE_SIZE < _pages.size () ? _pages[slot / PAGE_SIZE] : nullptr;
+		return page != nullptr ? page[slot % PAGE_SIZE] : _null_value;
+	}
+
+	template<class K, class V> inline void SparseArray<K, V>::set (K const& id, V const& value) {
+		size_t slot = IdTable<K>::IndexOf (id);
+		if (slot / PAGE_SIZE >= _pages.size ()) {
+			_pages.resize (slot / PAGE_SIZE + 1, nullptr);
+		}
+
+		V*& page = _pages[slot / PAGE_SIZE];
+
+		if (page == nullptr) {
+			page = static_cast<V*>(_arena->allocate (sizeof (V) * PAGE_SIZE, __alignof(V)));
+			for (size_t i = 0; i < PAGE_SIZE; i++) {
+				page[i] = _null_value;
+			}
+		}
+
+		page[slot % PAGE_SIZE] = value;
+	}
+
+	template<class K, class V> inline void SparseArray<K, V>::reset (K const& id) {
+		size_t slot = IdTable<K>::IndexOf (id);
+		V* page = slot / PAGE_SIZE < _pages.size () ? _pages[slot / PAGE_SIZE] : nullptr;
+		if (page != nullptr) {
+			page[slot % PAGE_SIZE] = _null_value;
+		}
+	}
+
+	///////
+
+	template<class C> const uint32_t ComponentPool<C>::NULL_INDEX;
+
+	template<class C> inline ComponentPool<C>::ComponentPool (Allocator* const& arena) : _dense (ArenaAllocator<C> (arena)), _entity_index (arena, NULL_INDEX), _id_index (arena, NULL_INDEX) {}
+
+	template<class C> inline ComponentPool<C>::~ComponentPool () {}
+
+	template<class C> inline C* ComponentPool<C>::add (ENTITY_ID const& e_id, COMPONENT_ID const& c_id) {
+		uint32_t index = static_cast<uint32_t>(_dense.size ());
+		_dense.emplace_back (e_id, c_id);
+
+		//Components without entity are only reachable by id
+		if (e_id != Entity::NULL_ID) {
+			_entity_index.set (e_id, index);
+		}
+		_id_index.set (c_id, index);
+
+		return &_dense.back ();
+	}
+
+	//The sparse tables are keyed by slot, the stored ids tell stale ones apart
+	template<class C> inline bool ComponentPool<C>::hasEntity (ENTITY_ID const& e_id) const {
+		uint32_t index = _entity_index.get (e_id);
+		return index != NULL_INDEX && _dense[index].entity_id () == e_id;
+	}
+
+	template<class C> inline bool ComponentPool<C>::hasId (COMPONENT_ID const& c_id) const {
+		uint32_t index = _id_index.get (c_id);
+		return index != NULL_INDEX && _dense[index].id () == c_id;
+	}
+
+	template<class C> inline C* ComponentPool<C>::getByEntity (ENTITY_ID const& e_id) {
+		return hasEntity (e_id) ? &_dense[_entity_index.get (e_id)] : nullptr;
+	}
+
+	template<class C> inline C* ComponentPool<C>::getById (COMPONENT_ID const& c_id) {
+		return hasId (c_id) ? &_dense[_id_index.get (c_id)] : nullptr;
+	}
+
+	template<class C> inline void ComponentPool<C>::remove (COMPONENT_ID const& c_id) {
+		if (!hasId (c_id)) return;
+		uint32_t index = _id_index.get (c_id);
+
+		//A component left behind by a destroyed entity doesn't own the slot anymore once it is reused
+		ENTITY_ID e_id = _dense[index].entity_id ();
+		if (e_id != Entity::NULL_ID && _entity_index.get (e_id) == index) {
+			_entity_index.reset (e_id);
+		}
+		_id_index.reset (c_id);
+
+		//Fill the hole with the last component so the array stays packed
+		uint32_t last = static_cast<uint32_t>(_dense.size () - 1);
+		if (index != last) {
+			_dense[index] = std::move (_dense[last]);
+
+			ENTITY_ID moved_e_id = _dense[index].entity_id ();
+			if (moved_e_id != Entity::NULL_ID && _entity_index.get (moved_e_id) == last) {
+				_entity_index.set (moved_e_id, index);
+			}
+			_id_index.set (_dense[index].id (), index);
+		}
+
+		_dense.pop_back ();
+	}
+
+	template<class C> inline size_t ComponentPool<C>::size () const {
+		return _dense.size ();
+	}
+
+	template<class C> inline C* ComponentPool<C>::begin () {
+		return _dense.data ();
+	}
+
+	template<class C> inline C* ComponentPool<C>::end () {
+		return _dense.data () + _dense.size ();
+	}
+
+	template<class C> inline C& ComponentPool<C>::operator[] (size_t index) {
+		return _dense[index];
+	}
+}
@@ -60,12 +60,12 @@ bool ECSCore::start (std::shared_ptr<Logger> funnel) {
 	//Valid
 	void* alloc = malloc (game_mem_alloc_size);
 	m_global_allocator = std::make_unique<FreeListAllocator,void*, size_t> (std::move(alloc), std::move(game_mem_alloc_size));
+	m_budget = std::make_unique<BudgetAllocator> ("ECS", m_global_allocator.get (), game_mem_alloc_size);
 
-
-	EntityManager::Initialize (m_global_allocator.get (), entity_mem_alloc_size, logger);
-	ComponentManager::Initialize (m_global_allocator.get (), component_mem_alloc_size, logger);
-	SystemManager::Initialize (m_global_allocator.get (), system_mem_alloc_size, logger);
-	EventManager::Initialize (m_global_allocator.get (), event_mem_alloc_size, logger);
+	EntityManager::Initialize (m_budget.get (), entity_mem_alloc_size, logger);
+	ComponentManager::Initialize (m_budget.get (), component_mem_alloc_size, logger);
+	SystemManager::Initialize (m_budget.get (), system_mem_alloc_size, logger);
+	EventManager::Initialize (m_budget.get (), event_mem_alloc_size, logger);
 	
 	return true;
 }
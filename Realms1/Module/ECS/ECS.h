@@ -66,6 +66,7 @@ namespace rlms{
 
 		IGameLoaderSystem* _loader_system;
 		std::unique_ptr<FreeListAllocator> m_global_allocator;
+		std::unique_ptr<BudgetAllocator> m_budget;
 
 		bool start (std::shared_ptr<Logger> funnel);
 
@@ -2,20 +2,30 @@
 
 using namespace rlms;
 
-std::vector<IComponent*> Entity::getComponents () {
-	std::vector<IComponent*> vec;
+constexpr ENTITY_ID Entity::NULL_ID;
+constexpr COMPONENT_ID IComponent::NULL_ID;
 
-	for (auto it = _components.begin (); it != _components.end (); it++) {
-		vec.push_back (it->second);
+std::vector<COMPONENT_ID> Entity::getComponents () {
+	std::vector<COMPONENT_ID> vec;
+
+	for (size_t type_id = 0; type_id < _components.size (); type_id++) {
+		if (_signature.test (type_id)) {
+			vec.push_back (_components[type_id]);
+		}
 	}
 
 	return vec;
 }
 
-void Entity::remComponent (IComponent*& comp_ptr) {
-	for (auto it = _components.begin (); it != _components.end (); it++) {
-		if (it->second == comp_ptr) {
-			_components.erase (it);
+const ComponentSignature& Entity::getSignature () const {
+	return _signature;
+}
+
+void Entity::remComponent (COMPONENT_ID const& c_id) {
+	for (size_t type_id = 0; type_id < _components.size (); type_id++) {
+		if (_signature.test (type_id) && _components[type_id] == c_id) {
+			_components[type_id] = IComponent::NULL_ID;
+			_signature.reset (type_id);
 			break;
 		}
 	}
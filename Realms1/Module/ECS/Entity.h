@@ -5,10 +5,11 @@
 ////////////////////////////////////////////////////////////
 #include "CoreTypes.h"
 #include "IComponent.h"
+#include "TypeId.h"
+#include "Memory/ArenaAllocator.h"
 
-#include <map>
+#include <cassert>
 #include <vector>
-#include <typeinfo>
 
 namespace rlms {
 	////////////////////////////////////////////////////////////
@@ -23,7 +24,8 @@ namespace rlms {
 		// Member data
 		////////////////////////////////////////////////////////////
 
-		std::map<const std::type_info*, IComponent*> _components; ///< internal references to components, the map forces all components to be unique
+		ComponentSignature _signature; ///< bit of each component type attached, so all components are unique
+		ArenaVector<COMPONENT_ID> _components; ///< ids of the attached components by type id (they are stored in the ComponentManager's pools)
 		ENTITY_ID _id;	///< internal id of this entity
 
 	public:
@@ -36,7 +38,7 @@ namespace rlms {
 		/// \param id	this entity id
 		///
 		////////////////////////////////////////////////////////////
-		Entity (ENTITY_ID const& id) : _id (id), _components () {}
+		Entity (ENTITY_ID const& id) : _id (id), _signature (), _components () {}
 
 		////////////////////////////////////////////////////////////
 		/// \brief Entity's id getter
@@ -53,10 +55,10 @@ namespace rlms {
 		///
 		/// \template C	the component type to be added
 		///
-		/// \param C*	a reference to the component's instance
+		/// \param c_id	the component's id
 		///
 		////////////////////////////////////////////////////////////
-		template<class C> void addComponent (C* c);
+		template<class C> void addComponent (COMPONENT_ID const& c_id);
 
 		////////////////////////////////////////////////////////////
 		/// \brief check if this entity has a C type Component reference
@@ -69,16 +71,16 @@ namespace rlms {
 		template<class C> bool hasComponent ();
 		
 		////////////////////////////////////////////////////////////
-		/// \brief get the Component from the entity's references
+		/// \brief get the id of the C type Component attached
 		///
-		/// hasComponent should be called before this function's call
+		/// The instance itself is reached through the ComponentManager
 		///
 		/// \template C	the component type to be found
 		///
-		/// \return C*	a reference to the component's instance, returns a nullptr otherwise !
+		/// \return the component's id, IComponent::NULL_ID otherwise !
 		///
 		////////////////////////////////////////////////////////////
-		template<class C> C* getComponent ();
+		template<class C> COMPONENT_ID getComponentId ();
 
 		////////////////////////////////////////////////////////////
 		/// \brief remove the Component from the entity's references
@@ -92,18 +94,26 @@ namespace rlms {
 		////////////////////////////////////////////////////////////
 		/// \brief get all the components attached to this entity
 		///
-		/// \return std::vector<IComponent*> of all the components attached
+		/// \return std::vector<COMPONENT_ID> of all the components attached
 		///
 		////////////////////////////////////////////////////////////
-		std::vector<IComponent*> getComponents ();
+		std::vector<COMPONENT_ID> getComponents ();
+
+		////////////////////////////////////////////////////////////
+		/// \brief component types attached to this entity
+		///
+		/// \return the signature, with the bit of each type id set
+		///
+		////////////////////////////////////////////////////////////
+		const ComponentSignature& getSignature () const;
 
 		////////////////////////////////////////////////////////////
 		/// \brief remove the reference if equals the param
 		///
-		/// \param an address to the component (if it's same, the component pointed erased from the map)
+		/// \param c_id	id of the component (if it's attached, it is erased from the map)
 		///
 		////////////////////////////////////////////////////////////
-		void remComponent (IComponent*& comp_ptr);
+		void remComponent (COMPONENT_ID const& c_id);
 
 		////////////////////////////////////////////////////////////
 		// Static member data
@@ -129,8 +139,8 @@ namespace rlms {
 /// \code
 /// Entity e = EntityManager::GetEntity (e_id);
 /// if(e.hasComponent<HealthComponent>()){
-/// 	auto hps = e.getComponent<HealthComponent> ();
-/// 	hps.cur_hp += reg_hp;
+/// 	auto hps = ComponentManager::GetComponent<HealthComponent> (&e);
+/// 	hps->cur_hp += hps->reg_hp;
 /// }
 /// \endcode
 /// ! This code would only be present in a related ISystem inherited class.
@@ -1,22 +1,34 @@
 #pragma once
 
 namespace rlms{
-	template<class C> inline void Entity::addComponent (C* c) {
-		_components[&typeid(C)] = c;
+	template<class C> inline void Entity::addComponent (COMPONENT_ID const& c_id) {
+		uint32_t type_id = TypeId<IComponent>::of<C> ();
+		assert (type_id < MAX_COMPONENT_TYPES);
+
+		if (type_id >= _components.size ()) {
+			_components.resize (type_id + 1, IComponent::NULL_ID);
+		}
+		_components[type_id] = c_id;
+		_signature.set (type_id);
 	}
 
-	template<class C> inline C* Entity::getComponent () {
+	template<class C> inline COMPONENT_ID Entity::getComponentId () {
 		if (hasComponent<C> ()) {
-			return static_cast<C*>(_components[&typeid(C)]);
+			return _components[TypeId<IComponent>::of<C> ()];
 		}
-		return nullptr;
+		return IComponent::NULL_ID;
 	}
 
 	template<class C> inline bool Entity::hasComponent () {
-		return (_components.find (&typeid(C)) != _components.end ());
+		uint32_t type_id = TypeId<IComponent>::of<C> ();
+		return type_id < MAX_COMPONENT_TYPES && _signature.test (type_id);
 	}
 
 	template<class C> inline void Entity::remComponent () {
-		_components.erase (&typeid(C));
+		uint32_t type_id = TypeId<IComponent>::of<C> ();
+		if (type_id < _components.size ()) {
+			_components[type_id] = IComponent::NULL_ID;
+			_signature.reset (type_id);
+		}
 	}
 }
\ No newline at end of file
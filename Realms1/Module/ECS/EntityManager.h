@@ -1,37 +1,89 @@
 #pragma once
-/*
-#include "RealmsCore/Entity.h"
-#include "Memory/PoolAllocator.h"
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
 #include "Memory/FreeListAllocator.h"
+#include "Memory/BudgetAllocator.h"
 #include "IO/ILogged.h"
+#include "Entity.h"
+#include "IdTable.h"
 
-#include <map>
+#include <atomic>
 #include <memory>
 
 namespace rlms {
+	////////////////////////////////////////////////////////////
+	/// \brief PImpl (check out https://en.cppreference.com/w/cpp/language/pimpl)
+	///
+	////////////////////////////////////////////////////////////
 	class EntityManagerImpl;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Owner of every Entity, reached by generational id
+	///
+	/// Ids of destroyed entities are detected as stale even once
+	/// their slot is reused.
+	///
+	////////////////////////////////////////////////////////////
 	class EntityManager {
 	private:
-		static std::unique_ptr<EntityManagerImpl> instance;
+
+		////////////////////////////////////////////////////////////
+		// Member data
+		////////////////////////////////////////////////////////////
+
+		static std::unique_ptr<EntityManagerImpl> instance; ///< PImpl (check out https://en.cppreference.com/w/cpp/language/pimpl)
 
 	public:
-		static int n_errors;
+
+		////////////////////////////////////////////////////////////
+		// Static member data
+		////////////////////////////////////////////////////////////
+		static std::atomic<int> n_errors; ///< Public simple var to check how many errors happenned.
 
 		static std::shared_ptr<LoggerHandler> GetLogger ();
 
-		static bool Initialize (Allocator* const& alloc, size_t entity_pool_size, std::shared_ptr<Logger> funnel = nullptr);
+		static bool Initialize (BudgetAllocator* const& budget, size_t entity_pool_size, std::shared_ptr<Logger> funnel = nullptr);
 		static void Terminate ();
 
 		static inline bool isValid (ENTITY_ID id) {
 			return id != Entity::NULL_ID;
 		}
 
+		//Entity::NULL_ID once every slot is taken, from the tick's thread only (see ISystem)
 		static const ENTITY_ID CreateEntity ();
-		static const ENTITY_ID CreateEntity (ENTITY_ID id);
+		//nullptr for stale ids
 		static Entity* GetEntity (ENTITY_ID id);
 		static bool HasEntity (ENTITY_ID id);
+		//From the tick's thread only
 		static void DestroyEntity (ENTITY_ID id);
+		static size_t GetEntityCount ();
+	};
+
+	class EntityManagerImpl : public ILogged {
+	private:
+		friend class EntityManager;
+
+		std::string getLogName () override {
+			return "EntityManager";
+		};
+
+		std::unique_ptr<FreeListAllocator> m_entity_Allocator;
+		//Entities are allocated through it, spilling to the game budget once the pool is full
+		std::unique_ptr<BudgetAllocator> m_entity_Budget;
+		IdTable<Entity*>* _lookup_table;
+
+		bool start (BudgetAllocator* const& budget, size_t entity_pool_size, std::shared_ptr<Logger> funnel);
+		void stop ();
+
+		const ENTITY_ID createEntity ();
+		bool hasEntity (ENTITY_ID id);
+		Entity* getEntity (ENTITY_ID id);
+		void destroyEntity (ENTITY_ID id);
+
+	public:
+		EntityManagerImpl ();
+		~EntityManagerImpl ();
 	};
-}
-*/
\ No newline at end of file
+} //namespace rlms
@@ -0,0 +1,100 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Memory/Allocator.h"
+#include "EventQueue.h"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rlms {
+	//Counters of a channel since it was opened
+	struct EventChannelStats {
+		size_t capacity;
+		size_t posted;
+		size_t drained;
+		//Posts refused because the channel was full, producers outrunning the ticks
+		size_t rejected;
+		//Drained events lost because the event memory of the tick was full
+		size_t dropped;
+		//Most events found waiting by a drain
+		size_t high_water;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Type erased access to an EventChannel, used by the
+	///        EventManager to drain every channel.
+	///
+	////////////////////////////////////////////////////////////
+	class IEventChannel {
+	public:
+		virtual ~IEventChannel () {}
+
+		//Moves the waiting events in the event queue, returns how many
+		virtual size_t drain () = 0;
+		virtual EventChannelStats getStats () const = 0;
+		virtual const char* getName () const = 0;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Bounded lock-free queue of E events, any thread
+	///        posts and the game tick drains
+	///
+	/// Each cell carries a sequence number telling producers
+	/// and the consumer whose turn it is (D. Vyukov's bounded
+	/// queue), so a post is one compare and swap on the write
+	/// position. A full channel refuses the post instead of
+	/// blocking the producer.
+	///
+	////////////////////////////////////////////////////////////
+	template<class E> class EventChannel : public IEventChannel {
+	public:
+		static const size_t CACHE_LINE = 64;
+
+		//capacity is rounded up to a power of 2, cells are allocated from arena
+		EventChannel (Allocator* const& arena, size_t capacity, EventQueue<E>* const& target);
+		~EventChannel ();
+
+		//Thread safe, false when the channel is full
+		template<class... Args> bool post (Args&&... args);
+
+		//Consumer thread only
+		size_t drain () override;
+		//Any thread, the counters are read one after the other so they can be a few events apart
+		EventChannelStats getStats () const override;
+		const char* getName () const override;
+
+	private:
+		struct Cell {
+			std::atomic<size_t> sequence;
+			typename std::aligned_storage<sizeof (E), __alignof(E)>::type storage;
+		};
+
+		//Prevent copies because it might cause errors
+		EventChannel (const EventChannel&);
+		EventChannel& operator=(const EventChannel&) = delete;
+
+		Allocator* _arena;
+		EventQueue<E>* _target;
+		Cell* _cells;
+		size_t _mask;
+
+		//Producers and consumer positions on their own cache lines
+		alignas(CACHE_LINE) std::atomic<size_t> _enqueue_pos;
+		alignas(CACHE_LINE) size_t _dequeue_pos;
+
+		alignas(CACHE_LINE) std::atomic<size_t> _posted;
+		std::atomic<size_t> _rejected;
+		//Only written by the consumer, atomic so the stats can be read from any thread
+		std::atomic<size_t> _dropped;
+		std::atomic<size_t> _drained;
+		std::atomic<size_t> _high_water;
+	};
+} //namespace rlms
+
+#include "EventChannel.inl"
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <typeinfo>
+
+namespace rlms {
+	template<class E> const size_t EventChannel<E>::CACHE_LINE;
+
+	template<class E> inline EventChannel<E>::EventChannel (Allocator* const& arena, size_t capacity, EventQueue<E>* const& target) : _arena (arena), _target (target), _cells (nullptr), _mask (0),
+		_enqueue_pos (0), _dequeue_pos (0), _posted (0), _rejected (0), _dropped (0), _drained (0), _high_water (0) {
+		size_t size = 2;
+		while (size < capacity) {
+			size *= 2;
+		}
+		_mask = size - 1;
+
+		_cells = static_cast<Cell*>(_arena->allocate (sizeof (Cell) * size, __alignof(Cell)));
+		for (size_t i = 0; i < size; i++) {
+			new (&_cells[i].sequence) std::atomic<size_t> (i);
+		}
+	}
+
+	template<class E> inline EventChannel<E>::~EventChannel () {
+		//Events never drained
+		for (size_t pos = _dequeue_pos; _cells[pos & _mask].sequence.load (std::memory_order_acquire) == pos + 1; pos++) {
+			reinterpret_cast<E*>(&_cells[pos & _mask].storage)->~E ();
+		}
+		_arena->deallocate (_cells);
+	}
+
+	template<class E> template<class... Args> inline bool EventChannel<E>::post (Args&&... args) {
+		size_t pos = _enqueue_pos.load (std::memory_order_relaxed);
+		Cell* cell;
+
+		for (;;) {
+			cell = &_cells[pos & _mask];
+			size_t sequence = cell->sequence.load (std::memory_order_acquire);
+			intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+			//Free cell, claim it
+			if (diff == 0) {
+				if (_enqueue_pos.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed)) break;
+			}
+			//Still holding the event of the previous lap
+			else if (diff < 0) {
+				_rejected.fetch_add (1, std::memory_order_relaxed);
+				return false;
+			}
+			//Claimed by another producer
+			else {
+				pos = _enqueue_pos.load (std::memory_order_relaxed);
+			}
+		}
+
+		new (&cell->storage) E (std::forward<Args> (args)...);
+		cell->sequence.store (pos + 1, std::memory_order_release);
+		_posted.fetch_add (1, std::memory_order_relaxed);
+		return true;
+	}
+
+	template<class E> inline size_t EventChannel<E>::drain () {
+		size_t waiting = _enqueue_pos.load (std::memory_order_relaxed) - _dequeue_pos;
+		if (waiting > _high_water.load (std::memory_order_relaxed)) {
+			_high_water.store (waiting, std::memory_order_relaxed);
+		}
+
+		size_t count = 0;
+		size_t dropped = 0;
+		for (;;) {
+			Cell& cell = _cells[_dequeue_pos & _mask];
+
+			//Empty, or the next event is still being written
+			if (cell.sequence.load (std::memory_order_acquire) != _dequeue_pos + 1) break;
+
+			E* event = reinterpret_cast<E*>(&cell.storage);
+			//Once the event memory of the tick is full the rest is lost
+			if (_target->push (std::move (*event)) == nullptr) {
+				dropped++;
+			}
+			else {
+				count++;
+			}
+			event->~E ();
+
+			//Free for the producers' next lap
+			cell.sequence.store (_dequeue_pos + _mask + 1, std::memory_order_release);
+			_dequeue_pos++;
+		}
+
+		_drained.store (_drained.load (std::memory_order_relaxed) + count, std::memory_order_relaxed);
+		_dropped.store (_dropped.load (std::memory_order_relaxed) + dropped, std::memory_order_relaxed);
+		return count;
+	}
+
+	template<class E> inline EventChannelStats EventChannel<E>::getStats () const {
+		return EventChannelStats{ _mask + 1, _posted.load (std::memory_order_relaxed), _drained.load (std::memory_order_relaxed),
+			_rejected.load (std::memory_order_relaxed), _dropped.load (std::memory_order_relaxed), _high_water.load (std::memory_order_relaxed) };
+	}
+
+	template<class E> inline const char* EventChannel<E>::getName () const {
+		return typeid(E).name ();
+	}
+}
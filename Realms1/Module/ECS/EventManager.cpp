@@ -2,16 +2,16 @@
 
 using namespace rlms;
 
-int EventManager::n_errors;
+std::atomic<int> EventManager::n_errors (0);
 std::unique_ptr<EventManagerImpl> EventManager::instance;
 
 std::shared_ptr<LoggerHandler> EventManager::GetLogger () {
 	return instance->getLogger ();
 }
 
-bool EventManager::Initialize (Allocator* const& alloc, size_t event_pool_size, std::shared_ptr<Logger> funnel) {
+bool EventManager::Initialize (BudgetAllocator* const& budget, size_t event_pool_size, std::shared_ptr<Logger> funnel) {
 	instance = std::make_unique<EventManagerImpl> ();
-	return instance->start (alloc, event_pool_size, funnel);
+	return instance->start (budget, event_pool_size, funnel);
 }
 
 void EventManager::Terminate () {
@@ -19,37 +19,120 @@ void EventManager::Terminate () {
 	instance.reset ();
 }
 
-void EventManager::ClearEvents () {
-	instance->clearEvents ();
+void EventManager::SwapEvents () {
+	instance->swapEvents ();
 }
 
-EventManagerImpl::EventManagerImpl () : _events() {}
+void EventManager::DispatchEvents () {
+	instance->dispatchEvents ();
+}
+
+void EventManager::DrainChannels () {
+	instance->drainChannels ();
+}
+
+void EventManager::LogChannelStats () {
+	instance->logChannelStats ();
+}
+
+EventManagerImpl::EventManagerImpl () : _budget (nullptr), _queues (), _channels (), _channels_rejected (), _channels_dropped () {}
 EventManagerImpl::~EventManagerImpl () {}
 
-bool EventManagerImpl::start (Allocator* const& alloc, size_t event_pool_size, std::shared_ptr<Logger> funnel) {
+bool EventManagerImpl::start (BudgetAllocator* const& budget, size_t event_pool_size, std::shared_ptr<Logger> funnel) {
 	startLogger (funnel);
-	logger->tag (LogTags::Debug) << "Initializing !" << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "Initializing !" << '\n';
 
-	_event_Allocator = std::unique_ptr<LinearAllocator> (new LinearAllocator (alloc->allocate (event_pool_size), event_pool_size));
+	_event_Allocator = std::unique_ptr<FrameAllocator> (new FrameAllocator (budget->allocate (event_pool_size), event_pool_size));
+	_event_Allocator->setTag (AllocTag::Event);
+	_event_Budget = std::make_unique<BudgetAllocator> ("Event", _event_Allocator.get (), event_pool_size, budget);
+	_budget = budget;
+	_queues = ArenaVector<IEventQueue*> (ArenaAllocator<IEventQueue*> (budget));
+	_channels = ArenaVector<IEventChannel*> (ArenaAllocator<IEventChannel*> (budget));
+	_channels_rejected = ArenaVector<size_t> (ArenaAllocator<size_t> (budget));
+	_channels_dropped = ArenaVector<size_t> (ArenaAllocator<size_t> (budget));
 
 	EventManager::n_errors = 0;
-	logger->tag (LogTags::None) << "Initialized correctly !" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Initialized correctly !" << '\n';
 	return true;
 }
 
 void EventManagerImpl::stop () {
-	logger->tag (LogTags::Debug) << "Stopping !" << '\n';
-	clearEvents ();
-	logger->tag (LogTags::None) << "Stopped correctly !" << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "Stopping !" << '\n';
+
+	//Channels first, they point to their queue
+	for (auto it = _channels.begin (); it != _channels.end (); it++) {
+		if (*it != nullptr) {
+			allocator::deallocateDelete (*_budget, *it);
+		}
+	}
+	_channels.clear ();
+	_channels_rejected.clear ();
+	_channels_dropped.clear ();
+
+	//Queues destroy their events
+	for (auto it = _queues.begin (); it != _queues.end (); it++) {
+		if (*it != nullptr) {
+			allocator::deallocateDelete (*_budget, *it);
+		}
+	}
+	_queues.clear ();
+
+	RLMS_LOG (logger, LogTags::None) << "Stopped correctly !" << '\n';
+}
+
+void EventManagerImpl::swapEvents () {
+	RLMS_LOG (logger, LogTags::Debug) << "Swapping events." << '\n';
+
+	for (auto it = _queues.begin (); it != _queues.end (); it++) {
+		if (*it != nullptr) {
+			(*it)->swap ();
+		}
+	}
+
+	//Drops the memory of the events the queues just destroyed
+	_event_Allocator->swap ();
 }
 
-void EventManagerImpl::clearEvents () {
-	logger->tag (LogTags::Debug) << "Clearing events." << '\n';
-	for (auto it = _events.begin (); it != _events.end (); it++) {
-		it->second->~IEvent ();
+void EventManagerImpl::dispatchEvents () {
+	RLMS_LOG (logger, LogTags::Debug) << "Dispatching events." << '\n';
+
+	//By index, a listener raising a new event type grows _queues
+	for (size_t i = 0; i < _queues.size (); i++) {
+		if (_queues[i] != nullptr) {
+			_queues[i]->dispatch ();
+		}
+	}
+}
+
+void EventManagerImpl::drainChannels () {
+	RLMS_LOG (logger, LogTags::Debug) << "Draining channels." << '\n';
+
+	for (size_t i = 0; i < _channels.size (); i++) {
+		if (_channels[i] == nullptr) continue;
+
+		_channels[i]->drain ();
+
+		EventChannelStats stats = _channels[i]->getStats ();
+
+		//Back pressure : producers post faster than the ticks drain
+		if (stats.rejected != _channels_rejected[i]) {
+			RLMS_LOG (logger, LogTags::Warning) << _channels[i]->getName () << " channel refused " << stats.rejected - _channels_rejected[i] << " events since the last drain." << '\n';
+			_channels_rejected[i] = stats.rejected;
+		}
+
+		//The tick's event memory is too small for what was posted
+		if (stats.dropped != _channels_dropped[i]) {
+			RLMS_LOG (logger, LogTags::Warning) << _channels[i]->getName () << " channel lost " << stats.dropped - _channels_dropped[i] << " events, the event memory is full." << '\n';
+			_channels_dropped[i] = stats.dropped;
+		}
 	}
+}
+
+void EventManagerImpl::logChannelStats () {
+	for (size_t i = 0; i < _channels.size (); i++) {
+		if (_channels[i] == nullptr) continue;
 
-	_events.clear ();
-	_event_Allocator->clear ();
-	logger->tag (LogTags::Debug) << "Events cleared." << '\n';
+		EventChannelStats stats = _channels[i]->getStats ();
+		RLMS_LOG (logger, LogTags::Info) << _channels[i]->getName () << " : " << stats.posted << " posted, " << stats.drained << " drained, " << stats.rejected << " refused, " << stats.dropped << " lost, " << stats.high_water << " / " << stats.capacity << " waiting at most" << '\n';
+	}
 }
@@ -3,28 +3,57 @@
 #include "IO/ILogged.h"
 #include "CoreTypes.h"
 #include "IEvent.h"
-#include "Memory/LinearAllocator.h"
+#include "EventQueue.h"
+#include "EventChannel.h"
+#include "EventsListener.h"
+#include "TypeId.h"
+#include "Memory/FrameAllocator.h"
+#include "Memory/BudgetAllocator.h"
+#include "Memory/ArenaAllocator.h"
+#include "../../Utility/MultiThreading/ThreadPool.h"
 
+#include <cassert>
 #include <typeinfo>
 #include <type_traits>
-#include <map>
+#include <atomic>
 #include <memory>
 namespace rlms{
 	class EventManagerImpl;
 
 	class EventManager {
 	public:
-		static int n_errors;
+		static std::atomic<int> n_errors;
 
 		static std::shared_ptr<LoggerHandler> GetLogger ();
 
-		static bool Initialize (Allocator* const& alloc, size_t event_pool_size, std::shared_ptr<Logger> funnel = nullptr);
+		static bool Initialize (BudgetAllocator* const& budget, size_t event_pool_size, std::shared_ptr<Logger> funnel = nullptr);
 		static void Terminate ();
 
-		template<class E> static bool CreateEvent ();
-		template<class E> static E* GetEvent ();
+		//Raises E (args...), dispatched at the next tick boundary, nullptr once the event memory is full
+		//From the tick's thread only, the systems running in parallel post through a channel instead (see ISystem)
+		template<class E, class... Args> static E* CreateEvent (Args&&... args);
+		//E events raised during the previous tick, valid until the next SwapEvents
+		template<class E> static const E* GetEvents ();
+		template<class E> static size_t GetEventCount ();
 		template<class E> static bool HasEvent ();
-		static void ClearEvents ();
+
+		template<class E> static void Subscribe (EventsListener<E>* listener);
+		template<class E> static void Unsubscribe (EventsListener<E>* listener);
+
+		//Tick boundary : the events raised since the last call become the dispatched ones, older ones are dropped
+		static void SwapEvents ();
+		//Hands the previous tick's events to their listeners, one batch per type and listener
+		static void DispatchEvents ();
+
+		//Channel other threads post E events through, opened once with capacity, from the tick's thread
+		//Open every channel before the producer threads start
+		template<class E> static EventChannel<E>* OpenChannel (size_t capacity);
+		//Thread safe, false when the channel is full or not opened
+		template<class E, class... Args> static bool PostEvent (Args&&... args);
+		//Moves the posted events in the queues, as if raised with CreateEvent, warns about the channels that refused or lost events
+		static void DrainChannels ();
+		template<class E> static EventChannelStats GetChannelStats ();
+		static void LogChannelStats ();
 	private:
 		static std::unique_ptr<EventManagerImpl> instance;
 	};
@@ -37,16 +66,34 @@ namespace rlms{
 			return "EventManager";
 		};
 
-		std::map<const std::type_info*, IEvent*> _events;
-		std::unique_ptr<LinearAllocator> _event_Allocator;
+		//Event arrays of the current and previous tick
+		std::unique_ptr<FrameAllocator> _event_Allocator;
+		//Only accounts for the pool : events are dropped with swap (), overflowed ones couldn't be
+		std::unique_ptr<BudgetAllocator> _event_Budget;
+		//Queues and listeners live in the game budget, they outlast the ticks
+		BudgetAllocator* _budget;
+		//At TypeId<IEvent>::of<E> (), nullptr until an E is raised or listened to
+		ArenaVector<IEventQueue*> _queues;
+		//At TypeId<IEvent>::of<E> (), nullptr until opened
+		ArenaVector<IEventChannel*> _channels;
+		//Posts refused by each channel at the last drain
+		ArenaVector<size_t> _channels_rejected;
+		//Events each channel could not move in a full event memory, at the last drain
+		ArenaVector<size_t> _channels_dropped;
 
-		bool start (Allocator* const& alloc, size_t event_pool_size, std::shared_ptr<Logger> funnel);
+		bool start (BudgetAllocator* const& budget, size_t event_pool_size, std::shared_ptr<Logger> funnel);
 		void stop ();
 
-		template<class E> bool createEvent ();
-		template<class E> E* getEvent ();
-		template<class E> bool hasEvent ();
-		void clearEvents ();
+		template<class E> EventQueue<E>* findQueue ();
+		template<class E> EventQueue<E>& getQueue ();
+		template<class E> EventChannel<E>* findChannel ();
+
+		template<class E, class... Args> E* createEvent (Args&&... args);
+		void swapEvents ();
+		void dispatchEvents ();
+		template<class E> EventChannel<E>* openChannel (size_t capacity);
+		void drainChannels ();
+		void logChannelStats ();
 	public:
 		EventManagerImpl ();
 		~EventManagerImpl ();
@@ -1,49 +1,103 @@
+template<class E, class... Args> inline E* EventManager::CreateEvent (Args&&... args) {
+	assert (!ThreadPool::InParallel () && "Post events from a parallel phase through a channel");
+	return instance->createEvent<E> (std::forward<Args> (args)...);
+}
 
-template<class E> inline bool EventManager::CreateEvent () {
-	return instance->createEvent<E> ();
+template<class E> inline const E* EventManager::GetEvents () {
+	EventQueue<E>* queue = instance->findQueue<E> ();
+	return queue != nullptr ? queue->data () : nullptr;
 }
 
-template<class E> inline E* EventManager::GetEvent () {
-	return instance->getEvent<E> ();
+template<class E> inline size_t EventManager::GetEventCount () {
+	EventQueue<E>* queue = instance->findQueue<E> ();
+	return queue != nullptr ? queue->size () : 0;
 }
 
 template<class E> inline bool EventManager::HasEvent () {
-	return instance->hasEvent<E> ();
+	return GetEventCount<E> () != 0;
 }
 
-template<class E> inline bool EventManagerImpl::createEvent () {
-	logger->tag (LogTags::Debug) << "Creating " << typeid(E).name () << "." << '\n';
+template<class E> inline void EventManager::Subscribe (EventsListener<E>* listener) {
+	instance->getQueue<E> ().subscribe (listener);
+}
 
-	auto it = _events.find (&typeid(E));
+template<class E> inline void EventManager::Unsubscribe (EventsListener<E>* listener) {
+	EventQueue<E>* queue = instance->findQueue<E> ();
+	if (queue != nullptr) {
+		queue->unsubscribe (listener);
+	}
+}
 
-   //Event doesn't exists
-	if (it != _events.end ()) {
-		logger->tag (LogTags::Error) << typeid(E).name () << " already exists." << '\n';
-		EventManager::n_errors++;
-		return false;
+template<class E> inline EventChannel<E>* EventManager::OpenChannel (size_t capacity) {
+	return instance->openChannel<E> (capacity);
+}
+
+template<class E, class... Args> inline bool EventManager::PostEvent (Args&&... args) {
+	EventChannel<E>* channel = instance->findChannel<E> ();
+	return channel != nullptr && channel->post (std::forward<Args> (args)...);
+}
+
+template<class E> inline EventChannelStats EventManager::GetChannelStats () {
+	EventChannel<E>* channel = instance->findChannel<E> ();
+	return channel != nullptr ? channel->getStats () : EventChannelStats{ 0, 0, 0, 0, 0, 0 };
+}
+
+/////////
+
+template<class E> inline EventQueue<E>* EventManagerImpl::findQueue () {
+	uint32_t type_id = TypeId<IEvent>::of<E> ();
+	return type_id < _queues.size () ? static_cast<EventQueue<E>*>(_queues[type_id]) : nullptr;
+}
+
+template<class E> inline EventQueue<E>& EventManagerImpl::getQueue () {
+	uint32_t type_id = TypeId<IEvent>::of<E> ();
+
+	if (type_id >= _queues.size ()) {
+		_queues.resize (type_id + 1, nullptr);
 	}
 
-	//Valid
-	E* new_event = new (_event_Allocator->allocate (sizeof (E), __alignof(E))) E ();
-	_events.insert (std::pair<const std::type_info*, IEvent*> (&typeid(E), new_event));
-	return true;
+	//First event or listener of that type
+	if (_queues[type_id] == nullptr) {
+		_queues[type_id] = allocator::allocateNew<EventQueue<E>> (*_budget, _budget, _event_Allocator.get ());
+	}
+
+	return *static_cast<EventQueue<E>*>(_queues[type_id]);
 }
 
-template<class E> inline E* EventManagerImpl::getEvent () {
-	logger->tag (LogTags::Debug) << "Getting " << typeid(E).name () << "." << '\n';
+template<class E, class... Args> inline E* EventManagerImpl::createEvent (Args&&... args) {
+	RLMS_LOG (logger, LogTags::Debug) << "Creating " << typeid(E).name () << "." << '\n';
 
-	auto it = _events.find (&typeid(E));
+	E* event = getQueue<E> ().push (std::forward<Args> (args)...);
 
-   //Event does exists
-	if (it == _events.end ()) {
-		logger->tag (LogTags::Error) << typeid(E).name () << " doesn't exists." << '\n';
+	//Event memory is full
+	if (event == nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "No memory left for " << typeid(E).name () << " this tick." << '\n';
 		EventManager::n_errors++;
 		return nullptr;
 	}
 
-	return static_cast<E*>(it->second);
+	return event;
 }
 
-template<class E> inline bool EventManagerImpl::hasEvent () {
-	return _events.find (&typeid(E)) != _events.end ();
+template<class E> inline EventChannel<E>* EventManagerImpl::findChannel () {
+	uint32_t type_id = TypeId<IEvent>::of<E> ();
+	return type_id < _channels.size () ? static_cast<EventChannel<E>*>(_channels[type_id]) : nullptr;
+}
+
+template<class E> inline EventChannel<E>* EventManagerImpl::openChannel (size_t capacity) {
+	EventChannel<E>* channel = findChannel<E> ();
+	if (channel != nullptr) return channel;
+
+	RLMS_LOG (logger, LogTags::Debug) << "Opening channel of " << typeid(E).name () << " for " << capacity << " events." << '\n';
+
+	uint32_t type_id = TypeId<IEvent>::of<E> ();
+	if (type_id >= _channels.size ()) {
+		_channels.resize (type_id + 1, nullptr);
+		_channels_rejected.resize (type_id + 1, 0);
+		_channels_dropped.resize (type_id + 1, 0);
+	}
+
+	channel = allocator::allocateNew<EventChannel<E>> (*_budget, _budget, capacity, &getQueue<E> ());
+	_channels[type_id] = channel;
+	return channel;
 }
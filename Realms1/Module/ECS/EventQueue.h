@@ -0,0 +1,80 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Memory/FrameAllocator.h"
+#include "Memory/ArenaAllocator.h"
+#include "IEvent.h"
+#include "EventsListener.h"
+
+namespace rlms {
+	////////////////////////////////////////////////////////////
+	/// \brief Type erased access to an EventQueue, used by the
+	///        EventManager at the tick boundary.
+	///
+	////////////////////////////////////////////////////////////
+	class IEventQueue {
+	public:
+		virtual ~IEventQueue () {}
+
+		//Events raised since the last swap become the dispatched ones, the previously dispatched are destroyed
+		virtual void swap () = 0;
+		//Hands the dispatched events to every listener in one call each
+		virtual void dispatch () = 0;
+		//Dispatched events
+		virtual size_t size () const = 0;
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Every E event of the current and previous tick
+	///
+	/// Events of a tick are packed in one array of the event
+	/// FrameAllocator, grown by doubling. The FrameAllocator
+	/// swaps with the queues, so a tick's events stay valid
+	/// during the next one while they are dispatched.
+	///
+	////////////////////////////////////////////////////////////
+	template<class E> class EventQueue : public IEventQueue {
+	public:
+		static const size_t INITIAL_CAPACITY = 16;
+
+		//Listeners are kept in arena, the events in frame
+		EventQueue (Allocator* const& arena, FrameAllocator* const& frame);
+		~EventQueue ();
+
+		//Constructs E (args...) for the next dispatch, nullptr once frame is full
+		template<class... Args> E* push (Args&&... args);
+
+		void subscribe (EventsListener<E>* listener);
+		void unsubscribe (EventsListener<E>* listener);
+
+		void swap () override;
+		void dispatch () override;
+		size_t size () const override;
+
+		//Dispatched events
+		const E* data () const;
+
+	private:
+		struct Buffer {
+			E* data;
+			size_t count;
+			size_t capacity;
+		};
+
+		//Prevent copies because it might cause errors
+		EventQueue (const EventQueue&);
+		EventQueue& operator=(const EventQueue&) = delete;
+
+		bool grow ();
+		static void destroy (Buffer& buffer);
+
+		FrameAllocator* _frame;
+		Buffer _write;
+		Buffer _read;
+		ArenaVector<EventsListener<E>*> _listeners;
+	};
+} //namespace rlms
+
+#include "EventQueue.inl"
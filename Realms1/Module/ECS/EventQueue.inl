@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+
+namespace rlms {
+	template<class E> const size_t EventQueue<E>::INITIAL_CAPACITY;
+
+	template<class E> inline EventQueue<E>::EventQueue (Allocator* const& arena, FrameAllocator* const& frame) : _frame (frame), _write{ nullptr, 0, 0 }, _read{ nullptr, 0, 0 }, _listeners (ArenaAllocator<EventsListener<E>*> (arena)) {}
+
+	template<class E> inline EventQueue<E>::~EventQueue () {
+		destroy (_write);
+		destroy (_read);
+	}
+
+	template<class E> template<class... Args> inline E* EventQueue<E>::push (Args&&... args) {
+		if (_write.count == _write.capacity && !grow ()) return nullptr;
+
+		return new (_write.data + _write.count++) E (std::forward<Args> (args)...);
+	}
+
+	template<class E> inline void EventQueue<E>::subscribe (EventsListener<E>* listener) {
+		if (std::find (_listeners.begin (), _listeners.end (), listener) == _listeners.end ()) {
+			_listeners.push_back (listener);
+		}
+	}
+
+	template<class E> inline void EventQueue<E>::unsubscribe (EventsListener<E>* listener) {
+		_listeners.erase (std::remove (_listeners.begin (), _listeners.end (), listener), _listeners.end ());
+	}
+
+	template<class E> inline void EventQueue<E>::swap () {
+		//Their memory goes back with the FrameAllocator's own swap
+		destroy (_read);
+		_read = _write;
+		_write = Buffer{ nullptr, 0, 0 };
+	}
+
+	template<class E> inline void EventQueue<E>::dispatch () {
+		if (_read.count == 0) return;
+
+		for (size_t i = 0; i < _listeners.size (); i++) {
+			_listeners[i]->onEvents (_read.data, _read.count);
+		}
+	}
+
+	template<class E> inline size_t EventQueue<E>::size () const {
+		return _read.count;
+	}
+
+	template<class E> inline const E* EventQueue<E>::data () const {
+		return _read.data;
+	}
+
+	template<class E> inline bool EventQueue<E>::grow () {
+		size_t capacity = _write.capacity != 0 ? _write.capacity * 2 : INITIAL_CAPACITY;
+		E* data = static_cast<E*>(_frame->allocate (sizeof (E) * capacity, __alignof(E)));
+		if (data == nullptr) return false;
+
+		//The old array is only reclaimed with the frame
+		for (size_t i = 0; i < _write.count; i++) {
+			new (data + i) E (std::move (_write.data[i]));
+			_write.data[i].~E ();
+		}
+
+		_write.data = data;
+		_write.capacity = capacity;
+		return true;
+	}
+
+	template<class E> inline void EventQueue<E>::destroy (Buffer& buffer) {
+		for (size_t i = 0; i < buffer.count; i++) {
+			buffer.data[i].~E ();
+		}
+		buffer.count = 0;
+	}
+}
@@ -1,2 +0,0 @@
-#include "EventsListener.h"
-using namespace rlms;
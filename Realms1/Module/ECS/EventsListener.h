@@ -1,6 +1,18 @@
 #pragma once
+
+#include <cstddef>
+
 namespace rlms {
-	class EventsListener {
+	////////////////////////////////////////////////////////////
+	/// \brief Receives the E events of the previous tick, all
+	///        at once, once subscribed to the EventManager
+	///
+	////////////////////////////////////////////////////////////
+	template<class E> class EventsListener {
+	public:
+		virtual ~EventsListener () {};
 
+		//events stay valid until the end of the tick
+		virtual void onEvents (const E* events, size_t count) = 0;
 	};
 }
@@ -10,16 +10,33 @@ private:
 		return "GameCore";
 	}
 
+	static const size_t INITIAL_COMMIT_SIZE = 1024 * 1024;
+	//Updates between two warnings while the catch up stays clamped
+	static const unsigned int OVERRUN_LOG_INTERVAL = 300;
+
+	//Time accumulated but not simulated yet, less than a tick between two updates
 	double m_dt_offset;
+	double m_tick_alpha;
+	GAME_TICK_TYPE m_current_tick;
+	unsigned long long m_overrun_ticks;
+	//Dropped since the last warning
+	unsigned long long m_unlogged_overrun_ticks;
+	unsigned int m_updates_since_overrun_log;
 
 	GameCoreSettings stgs;
 
 	IGameLoaderSystem* _loader_system;
-	std::unique_ptr<FreeListAllocator> m_global_allocator;
+	std::unique_ptr<VirtualArena> m_arena;
+	std::unique_ptr<TLSFAllocator> m_global_allocator;
+	std::unique_ptr<ThreadCacheAllocator> m_shared_allocator;
+	std::unique_ptr<BudgetAllocator> m_budget;
+	std::unique_ptr<FrameAllocator> m_frame_allocator;
+	std::unique_ptr<BudgetAllocator> m_frame_budget;
 
 	bool start (std::shared_ptr<Logger> funnel);
 
 	void update (double dt);
+	void tick ();
 
 	void preUpdate (GAME_TICK_TYPE _current_tick);
 	void midUpdate (GAME_TICK_TYPE _current_tick);
@@ -59,6 +76,31 @@ void GameCore::Update (double dt) {
 	instance->update (dt);
 }
 
+double GameCore::GetTickAlpha () {
+	return instance->m_tick_alpha;
+}
+
+GAME_TICK_TYPE GameCore::GetCurrentTick () {
+	return instance->m_current_tick;
+}
+
+unsigned long long GameCore::GetOverrunTicks () {
+	return instance->m_overrun_ticks;
+}
+
+FrameAllocator* GameCore::GetFrameAllocator () {
+	return instance->m_frame_allocator.get ();
+}
+
+BudgetAllocator* GameCore::GetBudget () {
+	return instance->m_budget.get ();
+}
+
+void GameCore::LogMemoryStats () {
+	allocator::logAllStats (*instance->logger);
+	allocator::logBudget (*instance->m_budget, *instance->logger);
+}
+
 void GameCore::Terminate () {
 	instance->stop ();
 }
@@ -78,25 +120,142 @@ bool GameCoreImpl::start (std::shared_ptr<Logger> funnel) {
 		+ stgs.component_mem_alloc_size
 		+ stgs.system_mem_alloc_size
 		+ stgs.event_mem_alloc_size
+		+ stgs.frame_mem_alloc_size
 		)) {
 		logger->tag (LogTags::Error) << "Amount of memory requested does not add up." << '\n';
 		return false;
 	}
 
+	//invalid tick
+	if (stgs.atomic_tick_time <= 0 || stgs.max_catch_up_ticks == 0) {
+		logger->tag (LogTags::Error) << "Ticks must last some time and at least one must run per update." << '\n';
+		return false;
+	}
+
 	//Valid
-	void* alloc = malloc (stgs.game_mem_alloc_size);
-	m_global_allocator = std::make_unique<FreeListAllocator, void*, size_t> (std::move (alloc), std::move (stgs.game_mem_alloc_size));
+	//Only reserved, pages are committed as the global allocator grows and backed once touched
+	m_arena = std::make_unique<VirtualArena> (stgs.game_mem_alloc_size, stgs.huge_pages);
+	if (m_arena->getStart () == nullptr) {
+		logger->tag (LogTags::Error) << "Could not reserve the game memory." << '\n';
+		return false;
+	}
+	if (stgs.huge_pages && !m_arena->usesHugePages ()) {
+		logger->tag (LogTags::Warning) << "Huge pages unavailable, game memory uses normal pages." << '\n';
+	}
+	size_t initial_size = stgs.game_mem_alloc_size < INITIAL_COMMIT_SIZE ? stgs.game_mem_alloc_size : INITIAL_COMMIT_SIZE;
+	m_global_allocator = std::make_unique<TLSFAllocator> (m_arena.get (), initial_size);
+	m_shared_allocator = std::make_unique<ThreadCacheAllocator> (m_global_allocator.get ());
+	//Subsystem pools are carved through it, and spill back into it once full
+	m_budget = std::make_unique<BudgetAllocator> ("Game", m_shared_allocator.get (), stgs.game_mem_alloc_size);
 
+	void* frame_mem = m_budget->allocate (stgs.frame_mem_alloc_size);
+	if (frame_mem == nullptr) {
+		logger->tag (LogTags::Error) << "Could not reserve the frame memory." << '\n';
+		return false;
+	}
+	m_frame_allocator = std::make_unique<FrameAllocator> (frame_mem, stgs.frame_mem_alloc_size);
+	m_frame_allocator->setTag (AllocTag::Frame);
+	m_frame_budget = std::make_unique<BudgetAllocator> ("Frame", m_frame_allocator.get (), stgs.frame_mem_alloc_size, m_budget.get ());
+
+	//Engine containers not given an arena of their own land in the shared one
+	SetDefaultArena (m_shared_allocator.get ());
 
-	EntityManager::Initialize (m_global_allocator.get (), stgs.entity_mem_alloc_size, logger);
-	ComponentManager::Initialize (m_global_allocator.get (), stgs.component_mem_alloc_size, logger);
-	SystemManager::Initialize (m_global_allocator.get (), stgs.system_mem_alloc_size, logger);
-	EventManager::Initialize (m_global_allocator.get (), stgs.event_mem_alloc_size, logger);
-	WorldManager::Initialize (m_global_allocator.get (), stgs.world_mem_alloc_size, logger);
+	ThreadPool::Initialize (stgs.worker_threads, logger);
+
+	EntityManager::Initialize (m_budget.get (), stgs.entity_mem_alloc_size, logger);
+	ComponentManager::Initialize (m_budget.get (), stgs.component_mem_alloc_size, logger);
+	SystemManager::Initialize (m_budget.get (), stgs.system_mem_alloc_size, logger);
+	SystemManager::SetTickBudget (stgs.system_tick_budget);
+	EventManager::Initialize (m_budget.get (), stgs.event_mem_alloc_size, logger);
+	WorldManager::Initialize (m_budget.get (), stgs.world_mem_alloc_size, logger);
 
 	return true;
 }
 
-GameCoreImpl::GameCoreImpl () : _loader_system(nullptr), m_dt_offset(0) {}
+void GameCoreImpl::stop () {
+	WorldManager::Terminate ();
+	EventManager::Terminate ();
+	SystemManager::Terminate ();
+	ComponentManager::Terminate ();
+	EntityManager::Terminate ();
+
+	ThreadPool::Terminate ();
+}
 
-GameCoreImpl::~GameCoreImpl () {}
+void GameCoreImpl::update (double dt) {
+	//Once per call however many ticks run, scratch data of two updates ago is dropped and the previous one's stays readable
+	m_frame_allocator->swap ();
+
+	m_dt_offset += dt;
+	if (m_updates_since_overrun_log < OVERRUN_LOG_INTERVAL) {
+		m_updates_since_overrun_log++;
+	}
+
+	unsigned int ticks = 0;
+	while (m_dt_offset >= stgs.atomic_tick_time) {
+		//Catching up further would make this frame longer still, and the next one further behind
+		if (ticks == stgs.max_catch_up_ticks) {
+			unsigned long long dropped = static_cast<unsigned long long>(m_dt_offset / stgs.atomic_tick_time);
+			m_overrun_ticks += dropped;
+			m_dt_offset -= dropped * stgs.atomic_tick_time;
+
+			//Once per interval rather than every frame the clamp holds
+			m_unlogged_overrun_ticks += dropped;
+			if (m_updates_since_overrun_log == OVERRUN_LOG_INTERVAL) {
+				logger->tag (LogTags::Warning) << "Update fell " << m_unlogged_overrun_ticks << " ticks behind since the last warning, they are dropped." << '\n';
+				m_unlogged_overrun_ticks = 0;
+				m_updates_since_overrun_log = 0;
+			}
+			break;
+		}
+
+		tick ();
+		m_dt_offset -= stgs.atomic_tick_time;
+		ticks++;
+	}
+
+	m_tick_alpha = m_dt_offset / stgs.atomic_tick_time;
+}
+
+void GameCoreImpl::tick () {
+	//Events raised last tick, and those posted by other threads since, reach their listeners before the systems run
+	EventManager::DrainChannels ();
+	EventManager::SwapEvents ();
+	EventManager::DispatchEvents ();
+
+	preUpdate (m_current_tick);
+	midUpdate (m_current_tick);
+	postUpdate (m_current_tick);
+
+	m_current_tick++;
+}
+
+//Systems are stepped by one tick each time
+void GameCoreImpl::preUpdate (GAME_TICK_TYPE _current_tick) {
+	SystemManager::PreUpdate (1);
+}
+
+void GameCoreImpl::midUpdate (GAME_TICK_TYPE _current_tick) {
+	SystemManager::Update (1);
+}
+
+void GameCoreImpl::postUpdate (GAME_TICK_TYPE _current_tick) {
+	SystemManager::PostUpdate (1);
+	//Once no system holds a chunk pointer
+	WorldManager::Update ();
+}
+
+GameCoreImpl::GameCoreImpl () : _loader_system(nullptr), m_dt_offset(0), m_tick_alpha(0), m_current_tick(0), m_overrun_ticks(0), m_unlogged_overrun_ticks(0), m_updates_since_overrun_log(OVERRUN_LOG_INTERVAL) {}
+
+GameCoreImpl::~GameCoreImpl () {
+	if (GetDefaultArena () == m_shared_allocator.get ()) {
+		SetDefaultArena (nullptr);
+	}
+
+	if (m_frame_allocator) {
+		void* frame_mem = m_frame_allocator->getStart ();
+		m_frame_budget.reset ();
+		m_frame_allocator.reset ();
+		m_budget->deallocate (std::move (frame_mem));
+	}
+}
@@ -2,7 +2,12 @@
 
 #include "IO/ILogged.h"
 
-#include "Memory/FreeListAllocator.h"
+#include "Memory/VirtualArena.h"
+#include "Memory/TLSFAllocator.h"
+#include "Memory/ThreadCacheAllocator.h"
+#include "Memory/ArenaAllocator.h"
+#include "Memory/FrameAllocator.h"
+#include "Memory/BudgetAllocator.h"
 #include "RealmsCore/IGameLoaderSystem.h"
 
 #include "RealmsCore/EntityManager.h"
@@ -12,6 +17,7 @@
 #include "RealmsCore/WorldManager.h"
 
 #include "RealmsCore/GameCoreSettings.h"
+#include "../../Utility/MultiThreading/ThreadPool.h"
 
 #include "CoreTypes.h"
 
@@ -29,8 +35,24 @@ namespace rlms{
 		static bool LoadSettings (std::string config_file);
 		void setGameLoaderSystem (IGameLoaderSystem* loader);
 
+		//Runs as many whole ticks as the time accumulated allows, up to max_catch_up_ticks
 		static void Update (double dt);
 
+		//Fraction of a tick accumulated past the last one, for rendering to interpolate between the last two ticks
+		static double GetTickAlpha ();
+		static GAME_TICK_TYPE GetCurrentTick ();
+		//Ticks dropped so far because Update was too far behind
+		static unsigned long long GetOverrunTicks ();
+
+		//Scratch memory valid for the current and the next Update call
+		static FrameAllocator* GetFrameAllocator ();
+
+		//Root of the memory budget tree, subsystem arenas are registered under it
+		static BudgetAllocator* GetBudget ();
+
+		//Dump every allocator's usage, peaks and per tag totals, then the budget tree
+		static void LogMemoryStats ();
+
 		static void Terminate ();
 	private:
 		static std::unique_ptr<GameCoreImpl> instance;
@@ -13,8 +13,21 @@ namespace rlms {
 		unsigned long long system_mem_alloc_size;
 		unsigned long long event_mem_alloc_size;
 		unsigned long long world_mem_alloc_size;
+		unsigned long long frame_mem_alloc_size;
 
+		//Back the game memory, chunk and component pools included, with 2 MB pages when the system allows it
+		bool huge_pages;
+
+		//Threads of the ThreadPool, 0 for one per hardware thread but the main one
+		unsigned int worker_threads;
+
+		//Simulated time of one tick, in the unit of GameCore::Update's dt
 		double atomic_tick_time;
+		//Ticks run at most by one Update, the time behind further is dropped
+		unsigned int max_catch_up_ticks;
+
+		//Milliseconds any system may take per tick before a warning is logged, 0 for no budget
+		double system_tick_budget;
 	};
 
 	class GameCoreSettingsImporter {
@@ -7,14 +7,14 @@
 namespace rlms{
 	class IEvent {
 	private:
-		const std::type_info*& _type;
+		const std::type_info* _type;
 	protected:
 		IEvent (const std::type_info* type) : _type (type), handled(true) {};
 	public:
 		virtual ~IEvent () {};
 		bool handled;
 
-		const std::type_info*& getType () const {
+		const std::type_info* getType () const {
 			return _type;
 		};
 
@@ -23,7 +23,7 @@ namespace rlms{
 		}
 
 		template<class E> inline static const E& as (IEvent& e) {
-			return dynamic_cast<E>(e);
+			return static_cast<const E&>(e);
 		}
 	};
 }
\ No newline at end of file
@@ -1,2 +1,21 @@
 #include "ISystem.h"
 using namespace rlms;
+
+bool ISystem::hasDeclaredAccess () const {
+	return _declared;
+}
+
+const ComponentSignature& ISystem::getReads () const {
+	return _reads;
+}
+
+const ComponentSignature& ISystem::getWrites () const {
+	return _writes;
+}
+
+bool ISystem::conflictsWith (ISystem const& other) const {
+	if (!_declared || !other._declared) return true;
+
+	//Reading the same types is the only safe overlap
+	return (_writes & (other._reads | other._writes)).any () || (other._writes & _reads).any ();
+}
@@ -1,11 +1,32 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "IComponent.h"
+#include "TypeId.h"
+#include "ComponentManager.h"
 
 namespace rlms {
+	////////////////////////////////////////////////////////////
+	/// \brief Game logic run every tick by the SystemManager
+	///
+	/// Systems declaring their access with reads and writes run
+	/// in parallel with the systems they don't conflict with,
+	/// on the ThreadPool. Their updates may then only :
+	/// - read and write the components they declared, through
+	///   GetComponents, GetView or a component they hold,
+	/// - post events with EventManager::PostEvent, to a channel
+	///   opened beforehand.
+	/// Creating or destroying entities and components, raising
+	/// events with CreateEvent and creating systems are
+	/// asserted against : keep them to systems not declaring
+	/// any access, which always run alone on the tick's thread.
+	/// The managers' loggers aren't synchronized either, the id
+	/// based lookups log their errors and are best avoided.
+	///
+	////////////////////////////////////////////////////////////
 	class ISystem {
 	public:
-		ISystem () {};
+		ISystem () : _declared (false), _reads (), _writes () {};
 		virtual ~ISystem () {};
 
 		virtual void start () = 0;
@@ -15,5 +36,36 @@ namespace rlms {
 		virtual void  postUpdate (GAME_TICK_TYPE dt) = 0;
 
 		virtual void stop () = 0;
+
+		//False until reads or writes is called, such systems never run alongside another
+		bool hasDeclaredAccess () const;
+		const ComponentSignature& getReads () const;
+		const ComponentSignature& getWrites () const;
+
+		//True when the two systems can't run at the same time
+		bool conflictsWith (ISystem const& other) const;
+
+	protected:
+		//Component types accessed in the updates, to be declared in the constructor
+		//Their pools are created right away, parallel updates can't add one
+		template<class C> void reads ();
+		template<class C> void writes ();
+
+	private:
+		bool _declared;
+		ComponentSignature _reads;
+		ComponentSignature _writes;
 	};
-}
\ No newline at end of file
+
+	template<class C> inline void ISystem::reads () {
+		_declared = true;
+		_reads.set (TypeId<IComponent>::of<C> ());
+		ComponentManager::ReservePool<C> ();
+	}
+
+	template<class C> inline void ISystem::writes () {
+		_declared = true;
+		_writes.set (TypeId<IComponent>::of<C> ());
+		ComponentManager::ReservePool<C> ();
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Memory/ArenaAllocator.h"
+
+#include <cstdint>
+
+namespace rlms {
+	////////////////////////////////////////////////////////////
+	/// \brief Dense slot array handing out generational 32 bit ids
+	///
+	/// The low INDEX_BITS of an id are its slot, the others the
+	/// generation of the slot when the id was created. Freeing a
+	/// slot bumps its generation so older ids are detected as
+	/// stale, and freed slots are reused oldest first.
+	///
+	////////////////////////////////////////////////////////////
+	template<class T> class IdTable {
+	public:
+		static const uint32_t INDEX_BITS = 20;
+		static const uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+		static const uint32_t MAX_GENERATION = (1u << (32 - INDEX_BITS)) - 1;
+		//Generations start at 1, so no id is ever 0
+		static const uint32_t NULL_ID = 0;
+
+		static uint32_t IndexOf (uint32_t id);
+		static uint32_t GenerationOf (uint32_t id);
+
+		IdTable (Allocator* const& arena);
+
+		//NULL_ID once every slot is taken
+		uint32_t create (T const& value);
+		//Stale and null ids are ignored
+		void destroy (uint32_t id);
+
+		bool isValid (uint32_t id) const;
+		//nullptr for stale and null ids
+		T* get (uint32_t id);
+
+		size_t getCount () const;
+
+		//Calls f (id, T&) for every live slot
+		template<class F> void forEach (F f);
+
+	private:
+		struct Slot {
+			T value;
+			uint32_t generation;
+			uint32_t next_free; ///< LIVE while the slot is taken
+		};
+
+		static const uint32_t LIVE = UINT32_MAX;
+		static const uint32_t NO_FREE = UINT32_MAX - 1;
+
+		//Prevent copies because it might cause errors
+		IdTable (const IdTable&);
+		IdTable& operator=(const IdTable&) = delete;
+
+		ArenaVector<Slot> _slots;
+		uint32_t _free_head;
+		uint32_t _free_tail;
+		size_t _count;
+	};
+} //namespace rlms
+
+#include "IdTable.inl"
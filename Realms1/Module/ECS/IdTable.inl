@@ -0,0 +1,90 @@
+#pragma once
+
+namespace rlms {
+	template<class T> const uint32_t IdTable<T>::INDEX_BITS;
+	template<class T> const uint32_t IdTable<T>::INDEX_MASK;
+	template<class T> const uint32_t IdTable<T>::MAX_GENERATION;
+	template<class T> const uint32_t IdTable<T>::NULL_ID;
+	template<class T> const uint32_t IdTable<T>::LIVE;
+	template<class T> const uint32_t IdTable<T>::NO_FREE;
+
+	template<class T> inline uint32_t IdTable<T>::IndexOf (uint32_t id) {
+		return id & INDEX_MASK;
+	}
+
+	template<class T> inline uint32_t IdTable<T>::GenerationOf (uint32_t id) {
+		return id >> INDEX_BITS;
+	}
+
+	template<class T> inline IdTable<T>::IdTable (Allocator* const& arena) : _slots (ArenaAllocator<Slot> (arena)), _free_head (NO_FREE), _free_tail (NO_FREE), _count (0) {}
+
+	template<class T> inline uint32_t IdTable<T>::create (T const& value) {
+		uint32_t index;
+
+		if (_free_head != NO_FREE) {
+			index = _free_head;
+			_free_head = _slots[index].next_free;
+			if (_free_head == NO_FREE) {
+				_free_tail = NO_FREE;
+			}
+		}
+		else {
+			//Every slot is taken or retired
+			if (_slots.size () > INDEX_MASK) return NULL_ID;
+
+			index = static_cast<uint32_t>(_slots.size ());
+			_slots.push_back (Slot{ value, 1, LIVE });
+		}
+
+		Slot& slot = _slots[index];
+		slot.value = value;
+		slot.next_free = LIVE;
+		_count++;
+
+		return (slot.generation << INDEX_BITS) | index;
+	}
+
+	template<class T> inline void IdTable<T>::destroy (uint32_t id) {
+		if (!isValid (id)) return;
+
+		uint32_t index = IndexOf (id);
+		Slot& slot = _slots[index];
+		slot.value = T ();
+		slot.next_free = NO_FREE;
+		_count--;
+
+		//A slot that went through every generation is retired rather than handing out an id seen before
+		if (slot.generation == MAX_GENERATION) return;
+		slot.generation++;
+
+		//Reused oldest first, so a slot's generations last as long as possible
+		if (_free_tail != NO_FREE) {
+			_slots[_free_tail].next_free = index;
+		}
+		else {
+			_free_head = index;
+		}
+		_free_tail = index;
+	}
+
+	template<class T> inline bool IdTable<T>::isValid (uint32_t id) const {
+		uint32_t index = IndexOf (id);
+		return id != NULL_ID && index < _slots.size () && _slots[index].next_free == LIVE && _slots[index].generation == GenerationOf (id);
+	}
+
+	template<class T> inline T* IdTable<T>::get (uint32_t id) {
+		return isValid (id) ? &_slots[IndexOf (id)].value : nullptr;
+	}
+
+	template<class T> inline size_t IdTable<T>::getCount () const {
+		return _count;
+	}
+
+	template<class T> template<class F> inline void IdTable<T>::forEach (F f) {
+		for (uint32_t index = 0; index < _slots.size (); index++) {
+			if (_slots[index].next_free == LIVE) {
+				f ((_slots[index].generation << INDEX_BITS) | index, _slots[index].value);
+			}
+		}
+	}
+}
@@ -1,17 +1,19 @@
 #include "SystemManager.h"
 
+#include <chrono>
+
 using namespace rlms;
 
-int SystemManager::n_errors;
+std::atomic<int> SystemManager::n_errors (0);
 std::unique_ptr<SystemManagerImpl> SystemManager::instance;
 
 std::shared_ptr<LoggerHandler> SystemManager::GetLogger () {
 	return instance->getLogger();
 }
 
-bool SystemManager::Initialize (Allocator* const& alloc, size_t system_pool_size, std::shared_ptr<Logger> funnel) {
+bool SystemManager::Initialize (BudgetAllocator* const& budget, size_t system_pool_size, std::shared_ptr<Logger> funnel) {
 	instance = std::make_unique<SystemManagerImpl> ();
-	return instance->start (alloc, system_pool_size, funnel);
+	return instance->start (budget, system_pool_size, funnel);
 }
 
 void SystemManager::Terminate () {
@@ -31,58 +33,205 @@ void SystemManager::PostUpdate (GAME_TICK_TYPE dt) {
 	instance->postUpdate (dt);
 }
 
-SystemManagerImpl::SystemManagerImpl () : _systems () {}
+void SystemManager::SetTickBudget (double ms) {
+#ifdef RLMS_SYSTEM_PROFILER
+	instance->_tick_budget = ms;
+#else
+	(void)ms;
+#endif
+}
+
+void SystemManager::LogTimings () {
+	instance->logTimings ();
+}
+
+#ifdef RLMS_SYSTEM_PROFILER
+SystemManagerImpl::SystemManagerImpl () : _systems (), _schedule (), _phases (), _schedule_dirty (false), _retired (), _profiles (), _tick_budget (0) {}
+#else
+SystemManagerImpl::SystemManagerImpl () : _systems (), _schedule (), _phases (), _schedule_dirty (false), _retired () {}
+#endif
 SystemManagerImpl::~SystemManagerImpl () {}
 
-bool SystemManagerImpl::start (Allocator* const& alloc, size_t system_pool_size, std::shared_ptr<Logger> funnel) {
+bool SystemManagerImpl::start (BudgetAllocator* const& budget, size_t system_pool_size, std::shared_ptr<Logger> funnel) {
 	startLogger (funnel);
-	logger->tag (LogTags::None) << "Initializing !" << '\n';
-
-	m_object_Allocator = std::unique_ptr<FreeListAllocator> (new FreeListAllocator (alloc->allocate (system_pool_size), system_pool_size));
+	RLMS_LOG (logger, LogTags::None) << "Initializing !" << '\n';
+
+	m_object_Allocator = std::unique_ptr<FreeListAllocator> (new FreeListAllocator (budget->allocate (system_pool_size), system_pool_size));
+	m_object_Allocator->setTag (AllocTag::System);
+	m_object_Budget = std::make_unique<BudgetAllocator> ("System", m_object_Allocator.get (), system_pool_size, budget, true);
+	_systems = ArenaVector<ISystem*> (ArenaAllocator<ISystem*> (m_object_Budget.get ()));
+	_schedule = ArenaVector<uint32_t> (ArenaAllocator<uint32_t> (m_object_Budget.get ()));
+	_phases = ArenaVector<size_t> (ArenaAllocator<size_t> (m_object_Budget.get ()));
+	_schedule_dirty = true;
+	_retired = ArenaVector<ISystem*> (ArenaAllocator<ISystem*> (m_object_Budget.get ()));
+#ifdef RLMS_SYSTEM_PROFILER
+	_profiles = ArenaVector<SystemProfile> (ArenaAllocator<SystemProfile> (m_object_Budget.get ()));
+#endif
 
 	SystemManager::n_errors = 0;
-	logger->tag (LogTags::None) << "Initialized correctly !" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Initialized correctly !" << '\n';
 	return true;
 }
 
 void SystemManagerImpl::stop () {
-	logger->tag (LogTags::None) << "Stopping !" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Stopping !" << '\n';
 
+	releaseRetired ();
 	for (auto it = _systems.begin (); it != _systems.end (); it++) {
-		it->second->~ISystem ();
-		m_object_Allocator->deallocate (it->second);
+		if (*it != nullptr) {
+			(*it)->~ISystem ();
+			m_object_Budget->deallocate (*it);
+		}
 	}
-
-	logger->tag (LogTags::None) << "Stopped correctly !" << '\n';
+	_systems.clear ();
+	_schedule.clear ();
+	_phases.clear ();
+	_retired.clear ();
+#ifdef RLMS_SYSTEM_PROFILER
+	_profiles.clear ();
+#endif
+
+	RLMS_LOG (logger, LogTags::None) << "Stopped correctly !" << '\n';
 }
 
 void SystemManagerImpl::preUpdate (GAME_TICK_TYPE dt) {
-	logger->tag (LogTags::Debug) << "preUpdating by " << dt << "ticks." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "preUpdating by " << dt << "ticks." << '\n';
 	
-	for (auto it = _systems.begin (); it != _systems.end (); it++) {
-		it->second->preUpdate (dt);
-	}
+	runSchedule (&ISystem::preUpdate, dt);
 
-	logger->tag (LogTags::Debug) << "preUpdating done." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "preUpdating done." << '\n';
 }
 
 void SystemManagerImpl::update (GAME_TICK_TYPE dt) {
-	logger->tag (LogTags::Debug) << "Updating by " << dt << "ticks." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "Updating by " << dt << "ticks." << '\n';
 
-	for (auto it = _systems.begin (); it != _systems.end (); it++) {
-		it->second->update (dt);
-	}
+	runSchedule (&ISystem::update, dt);
 
-	logger->tag (LogTags::Debug) << "Updating done." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "Updating done." << '\n';
 }
 
 void SystemManagerImpl::postUpdate (GAME_TICK_TYPE dt) {
-	logger->tag (LogTags::Debug) << "postUpdating by " << dt << "ticks." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "postUpdating by " << dt << "ticks." << '\n';
 
-	for (auto it = _systems.begin (); it != _systems.end (); it++) {
-		it->second->postUpdate (dt);
+	runSchedule (&ISystem::postUpdate, dt);
+	endTick ();
+
+	RLMS_LOG (logger, LogTags::Debug) << "postUpdating done." << '\n';
+}
+
+void SystemManagerImpl::buildSchedule () {
+	ArenaVector<uint32_t> systems{ ArenaAllocator<uint32_t> (m_object_Budget.get ()) };
+	ArenaVector<size_t> phase_of{ ArenaAllocator<size_t> (m_object_Budget.get ()) };
+	size_t phase_count = 0;
+
+	for (uint32_t type_id = 0; type_id < _systems.size (); type_id++) {
+		if (_systems[type_id] == nullptr) continue;
+
+		//Conflicting systems keep the type id order, so each tick runs them the same way
+		size_t phase = 0;
+		for (size_t i = 0; i < systems.size (); i++) {
+			if (phase_of[i] + 1 > phase && _systems[type_id]->conflictsWith (*_systems[systems[i]])) {
+				phase = phase_of[i] + 1;
+			}
+		}
+
+		systems.push_back (type_id);
+		phase_of.push_back (phase);
+		if (phase + 1 > phase_count) {
+			phase_count = phase + 1;
+		}
+	}
+
+	_schedule.clear ();
+	_phases.assign (phase_count + 1, 0);
+	for (size_t phase = 0; phase < phase_count; phase++) {
+		_phases[phase] = _schedule.size ();
+		for (size_t i = 0; i < systems.size (); i++) {
+			if (phase_of[i] == phase) {
+				_schedule.push_back (systems[i]);
+			}
+		}
+	}
+	_phases[phase_count] = _schedule.size ();
+
+	_schedule_dirty = false;
+	RLMS_LOG (logger, LogTags::Debug) << "Scheduled " << _schedule.size () << " systems in " << phase_count << " phases." << '\n';
+}
+
+void SystemManagerImpl::runSchedule (void (ISystem::*step)(GAME_TICK_TYPE), GAME_TICK_TYPE dt) {
+	if (_schedule_dirty) {
+		buildSchedule ();
+	}
+
+	//A phase only starts once the previous one is done
+	for (size_t phase = 0; phase + 1 < _phases.size (); phase++) {
+		uint32_t* type_ids = _schedule.data () + _phases[phase];
+		size_t count = _phases[phase + 1] - _phases[phase];
+
+		//Systems not declaring their access are alone in their phase and may change the structure
+		ISystem* first = _systems[type_ids[0]];
+		if (first != nullptr && !first->hasDeclaredAccess ()) {
+			runSystem (type_ids[0], step, dt);
+			continue;
+		}
+
+		//Even alone, the others only run in ParallelFor so the same calls are asserted against whatever the schedule
+		ThreadPool::ParallelFor (count, 1, [this, type_ids, step, dt](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				runSystem (type_ids[i], step, dt);
+			}
+		});
+	}
+}
+
+void SystemManagerImpl::runSystem (uint32_t type_id, void (ISystem::*step)(GAME_TICK_TYPE), GAME_TICK_TYPE dt) {
+	//Destroyed by an earlier phase of this tick
+	if (_systems[type_id] == nullptr) return;
+
+#ifdef RLMS_SYSTEM_PROFILER
+	//Each profile is only touched by the thread running its system
+	auto begin = std::chrono::steady_clock::now ();
+	(_systems[type_id]->*step) (dt);
+	_profiles[type_id].add (std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - begin).count ());
+#else
+	(_systems[type_id]->*step) (dt);
+#endif
+}
+
+void SystemManagerImpl::endTick () {
+	releaseRetired ();
+
+#ifdef RLMS_SYSTEM_PROFILER
+	for (size_t type_id = 0; type_id < _systems.size (); type_id++) {
+		if (_systems[type_id] == nullptr) continue;
+
+		SystemProfile& profile = _profiles[type_id];
+		double budget = profile.getBudget () > 0 ? profile.getBudget () : _tick_budget;
+
+		if (profile.endTick (budget)) {
+			RLMS_LOG (logger, LogTags::Warning) << profile.getName () << " took " << profile.getTimings ().last << " ms, over its " << budget << " ms budget." << '\n';
+		}
 	}
+#endif
+}
 
-	logger->tag (LogTags::Debug) << "postUpdating done." << '\n';
+void SystemManagerImpl::releaseRetired () {
+	for (auto it = _retired.begin (); it != _retired.end (); it++) {
+		(*it)->~ISystem ();
+		m_object_Budget->deallocate (*it);
+	}
+	_retired.clear ();
 }
 
+void SystemManagerImpl::logTimings () {
+#ifdef RLMS_SYSTEM_PROFILER
+	for (size_t type_id = 0; type_id < _systems.size (); type_id++) {
+		if (_systems[type_id] == nullptr) continue;
+
+		SystemTimings timings = _profiles[type_id].getTimings ();
+		RLMS_LOG (logger, LogTags::Info) << _profiles[type_id].getName () << " : mean " << timings.mean << " ms, p95 " << timings.p95 << " ms, max " << timings.max << " ms over " << timings.samples << " ticks, " << timings.overruns << " over budget" << '\n';
+	}
+#else
+	RLMS_LOG (logger, LogTags::Warning) << "System timings are compiled out (RLMS_SYSTEM_PROFILER)." << '\n';
+#endif
+}
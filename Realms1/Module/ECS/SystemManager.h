@@ -3,22 +3,28 @@
 #include "IO/ILogged.h"
 #include "CoreTypes.h"
 #include "ISystem.h"
+#include "SystemProfile.h"
+#include "TypeId.h"
 #include "Memory/FreeListAllocator.h"
+#include "Memory/BudgetAllocator.h"
+#include "Memory/ArenaAllocator.h"
+#include "../../Utility/MultiThreading/ThreadPool.h"
 
+#include <cassert>
 #include <typeinfo>
 #include <type_traits>
-#include <map>
+#include <atomic>
 #include <memory>
 namespace rlms{
 	class SystemManagerImpl;
 
 	class SystemManager {
 	public:
-		static int n_errors;
+		static std::atomic<int> n_errors;
 
 		static std::shared_ptr<LoggerHandler> GetLogger ();
 
-		static bool Initialize (Allocator* const& alloc, size_t system_pool_size, std::shared_ptr<Logger> funnel = nullptr);
+		static bool Initialize (BudgetAllocator* const& budget, size_t system_pool_size, std::shared_ptr<Logger> funnel = nullptr);
 		static void Terminate ();
 
 		static void PreUpdate (GAME_TICK_TYPE dt);
@@ -28,8 +34,17 @@ namespace rlms{
 		template<class S> static bool CreateSystem ();
 		template<class S> static S* GetSystem ();
 		template<class S> static bool HasSystem ();
+		//S stops running right away, it is freed at the end of the tick
 		template<class S> static void DestroySystem ();
 
+		//Milliseconds a system may take per tick before a warning is logged, 0 for no budget
+		static void SetTickBudget (double ms);
+		//Overrides the budget for S
+		template<class S> static void SetTickBudget (double ms);
+		//Zeroed when the profiler is compiled out (RLMS_SYSTEM_PROFILER)
+		template<class S> static SystemTimings GetTimings ();
+		static void LogTimings ();
+
 	private:
 		static std::unique_ptr<SystemManagerImpl> instance;
 	};
@@ -43,16 +58,43 @@ namespace rlms{
 			return "SystemManager";
 		};
 
-		std::map<const std::type_info*, ISystem*> _systems;
 		std::unique_ptr<FreeListAllocator> m_object_Allocator;
-
-		bool start (Allocator* const& alloc, size_t system_pool_size, std::shared_ptr<Logger> funnel);
+		//Systems are allocated through it, spilling to the game budget once the pool is full
+		std::unique_ptr<BudgetAllocator> m_object_Budget;
+		//At TypeId<ISystem>::of<S> (), nullptr for the types not created
+		ArenaVector<ISystem*> _systems;
+		//Type ids of the systems grouped by phase, the systems of a phase don't conflict and run in parallel
+		ArenaVector<uint32_t> _schedule;
+		//Start of each phase in _schedule, followed by its size
+		ArenaVector<size_t> _phases;
+		//Set when a system is created or destroyed
+		bool _schedule_dirty;
+		//Destroyed during the tick, freed once it ends as the schedule or their own update may still be running
+		ArenaVector<ISystem*> _retired;
+#ifdef RLMS_SYSTEM_PROFILER
+		//At the same index as the system
+		ArenaVector<SystemProfile> _profiles;
+		double _tick_budget;
+#endif
+
+		bool start (BudgetAllocator* const& budget, size_t system_pool_size, std::shared_ptr<Logger> funnel);
 		void stop ();
 
 		void  preUpdate (GAME_TICK_TYPE dt);
 		void  update (GAME_TICK_TYPE dt);
 		void  postUpdate (GAME_TICK_TYPE dt);
 
+		//A system goes one phase after the last earlier system (by type id) it conflicts with
+		void buildSchedule ();
+		void runSchedule (void (ISystem::*step)(GAME_TICK_TYPE), GAME_TICK_TYPE dt);
+		void runSystem (uint32_t type_id, void (ISystem::*step)(GAME_TICK_TYPE), GAME_TICK_TYPE dt);
+		//Closes the tick of every profile, warning about the systems over budget, and frees the retired systems
+		void endTick ();
+		void releaseRetired ();
+		void logTimings ();
+
+		template<class S> ISystem* findSystem ();
+
 		template<class S> bool createSystem ();
 		template<class S> S* getSystem ();
 		template<class S> bool hasSystem ();
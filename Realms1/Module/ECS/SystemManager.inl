@@ -1,6 +1,7 @@
 
 template<class S>
 inline bool SystemManager::CreateSystem () {
+	assert (!ThreadPool::InParallel () && "Structural changes are not allowed from a parallel phase");
 	return instance->createSystem<S> ();
 }
 
@@ -16,83 +17,119 @@ inline bool SystemManager::HasSystem () {
 
 template<class S>
 inline void SystemManager::DestroySystem () {
+	assert (!ThreadPool::InParallel () && "Structural changes are not allowed from a parallel phase");
 	instance->destroySystem<S> ();
 }
 
+template<class S>
+inline void SystemManager::SetTickBudget (double ms) {
+#ifdef RLMS_SYSTEM_PROFILER
+	if (instance->findSystem<S> () != nullptr) {
+		instance->_profiles[TypeId<ISystem>::of<S> ()].setBudget (ms);
+	}
+#else
+	(void)ms;
+#endif
+}
+
+template<class S>
+inline SystemTimings SystemManager::GetTimings () {
+#ifdef RLMS_SYSTEM_PROFILER
+	if (instance->findSystem<S> () != nullptr) {
+		return instance->_profiles[TypeId<ISystem>::of<S> ()].getTimings ();
+	}
+#endif
+	return SystemTimings{ 0, 0, 0, 0, 0, 0 };
+}
+
 /////////
 
+template<class S> inline ISystem* SystemManagerImpl::findSystem () {
+	uint32_t type_id = TypeId<ISystem>::of<S> ();
+	return type_id < _systems.size () ? _systems[type_id] : nullptr;
+}
+
 template<class S> inline bool SystemManagerImpl::createSystem () {
-	logger->tag (LogTags::Debug) << "creating " << typeid(S).name () << "." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "creating " << typeid(S).name () << "." << '\n';
 
 	//template is a system
 	if (!std::is_base_of<ISystem, S>::value && typeid(S) != typeid(ISystem)) {
-		logger->tag (LogTags::Error) << "System must inherit from ISystem !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "System must inherit from ISystem !" << '\n';
 		SystemManager::n_errors++;
 		return false;
 	}
 
-	auto it = _systems.find (&typeid(S));
-
 	//System type exists
-	if (it != _systems.end ()) {
-		logger->tag (LogTags::Error) << "System already exist !" << '\n';
+	if (findSystem<S> () != nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "System already exist !" << '\n';
 		SystemManager::n_errors++;
 		return false;
 	}
 
 	//Valid
-	S* new_system = new (m_object_Allocator->allocate (sizeof (S), __alignof(S))) S ();
-	_systems.insert (std::pair<const std::type_info*, ISystem*> (&typeid(S), static_cast<ISystem*>(new_system)));
+	S* new_system = new (m_object_Budget->allocate (sizeof (S), __alignof(S))) S ();
+
+	uint32_t type_id = TypeId<ISystem>::of<S> ();
+	if (type_id >= _systems.size ()) {
+		_systems.resize (type_id + 1, nullptr);
+	}
+	_systems[type_id] = static_cast<ISystem*>(new_system);
+#ifdef RLMS_SYSTEM_PROFILER
+	if (type_id >= _profiles.size ()) {
+		_profiles.resize (type_id + 1);
+	}
+	_profiles[type_id] = SystemProfile (typeid(S).name ());
+#endif
+	_schedule_dirty = true;
 	return true;
 }
 
 template<class S> inline S* SystemManagerImpl::getSystem () {
-	logger->tag (LogTags::Debug) << "getting " << typeid(S).name () << "." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "getting " << typeid(S).name () << "." << '\n';
 
 	//template is a system
 	if (!std::is_base_of<ISystem, S>::value) {
-		logger->tag (LogTags::Error) << "Systems must inherit from ISystem !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "Systems must inherit from ISystem !" << '\n';
 		SystemManager::n_errors++;
 		return nullptr;
 	}
 
-	auto it = _systems.find (&typeid(S));
+	ISystem* system = findSystem<S> ();
 
 	//System type exists
-	if (it == _systems.end ()) {
-		logger->tag (LogTags::Error) << "System doesn't exist !" << '\n';
+	if (system == nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "System doesn't exist !" << '\n';
 		SystemManager::n_errors++;
 		return nullptr;
 	}
 
-	return static_cast<S*>(it->second);
+	return static_cast<S*>(system);
 }
 
 template<class S> inline bool SystemManagerImpl::hasSystem () {
-	return _systems.find (&typeid(S)) != _systems.end ();
+	return findSystem<S> () != nullptr;
 }
 
 template<class S> inline void SystemManagerImpl::destroySystem () {
-	logger->tag (LogTags::Debug) << "Destroying " << typeid(S).name () << "." << '\n';
+	RLMS_LOG (logger, LogTags::Debug) << "Destroying " << typeid(S).name () << "." << '\n';
 
 	//template is a system
 	if (!std::is_base_of<ISystem, S>::value) {
-		logger->tag (LogTags::Error) << "Systems must inherit from ISystem !" << '\n';
+		RLMS_LOG (logger, LogTags::Error) << "Systems must inherit from ISystem !" << '\n';
 		SystemManager::n_errors++;
 		return;
 	}
 
-	auto it = _systems.find (&typeid(S));
+	ISystem* system = findSystem<S> ();
 
-	if (it == _systems.end ()) {
-		logger->tag (LogTags::Error) << "System doesn't exist !" << '\n';
+	if (system == nullptr) {
+		RLMS_LOG (logger, LogTags::Error) << "System doesn't exist !" << '\n';
 		SystemManager::n_errors++;
 		return;
 	}
 
-	S* sys = static_cast<S*>(it->second);
-
-	sys->~S ();
-	m_object_Allocator->deallocate (sys);
-	_systems.erase (it->first);
+	//The schedule being run, or the system's own update, may still use it
+	_retired.push_back (system);
+	_systems[TypeId<ISystem>::of<S> ()] = nullptr;
+	_schedule_dirty = true;
 }
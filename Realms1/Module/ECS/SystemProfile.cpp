@@ -0,0 +1,63 @@
+#include "SystemProfile.h"
+
+#include <algorithm>
+
+using namespace rlms;
+
+const size_t SystemProfile::WINDOW;
+
+SystemProfile::SystemProfile (const char* name) : _name (name), _budget (0), _samples (), _next (0), _count (0), _pending (0), _last (0), _overruns (0) {}
+
+const char* SystemProfile::getName () const {
+	return _name;
+}
+
+double SystemProfile::getBudget () const {
+	return _budget;
+}
+
+void SystemProfile::setBudget (double budget) {
+	_budget = budget;
+}
+
+void SystemProfile::add (double ms) {
+	_pending += ms;
+}
+
+bool SystemProfile::endTick (double budget) {
+	_last = _pending;
+	_pending = 0;
+
+	_samples[_next] = _last;
+	_next = (_next + 1) % WINDOW;
+	if (_count < WINDOW) {
+		_count++;
+	}
+
+	if (budget > 0 && _last > budget) {
+		_overruns++;
+		return true;
+	}
+	return false;
+}
+
+SystemTimings SystemProfile::getTimings () const {
+	SystemTimings timings = { 0, 0, 0, _last, _count, _overruns };
+	if (_count == 0) return timings;
+
+	double sorted[WINDOW];
+	double sum = 0;
+	for (size_t i = 0; i < _count; i++) {
+		sorted[i] = _samples[i];
+		sum += _samples[i];
+		timings.max = std::max (timings.max, _samples[i]);
+	}
+	timings.mean = sum / _count;
+
+	//Nearest rank
+	size_t rank = (_count * 95 + 99) / 100 - 1;
+	std::nth_element (sorted, sorted + rank, sorted + _count);
+	timings.p95 = sorted[rank];
+
+	return timings;
+}
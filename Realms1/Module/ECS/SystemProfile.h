@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../../_Preprocess.h"
+
+#include <cstddef>
+
+namespace rlms {
+	//Milliseconds a system spent in its updates, over the last SystemProfile::WINDOW ticks
+	struct SystemTimings {
+		double mean;
+		double p95;
+		double max;
+		double last;
+		size_t samples;
+		//Ticks over budget since the system was created
+		unsigned long long overruns;
+	};
+
+	//Time taken by one system in each tick, its preUpdate, update and postUpdate summed up
+	class SystemProfile {
+	public:
+		static const size_t WINDOW = 128;
+
+		SystemProfile (const char* name = "");
+
+		const char* getName () const;
+
+		//0 to use the SystemManager's
+		double getBudget () const;
+		void setBudget (double budget);
+
+		//Adds the time of one update step to the current tick
+		void add (double ms);
+		//Ends the current tick, true when it went over budget
+		bool endTick (double budget);
+
+		SystemTimings getTimings () const;
+
+	private:
+		const char* _name;
+		double _budget;
+		double _samples[WINDOW];
+		size_t _next;
+		size_t _count;
+		double _pending;
+		double _last;
+		unsigned long long _overruns;
+	};
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+
+namespace rlms {
+	////////////////////////////////////////////////////////////
+	/// \brief Dense ids for the types of one family
+	///
+	/// Each family (IComponent, ISystem, IEvent...) numbers its
+	/// types from 0 in order of first use, so managers can keep
+	/// them in plain arrays instead of maps keyed by typeid.
+	///
+	////////////////////////////////////////////////////////////
+	template<class Family> class TypeId {
+	public:
+		template<class T> static uint32_t of () {
+			static const uint32_t id = counter ()++;
+			return id;
+		}
+
+		//Types of the family seen so far
+		static uint32_t count () {
+			return counter ().load ();
+		}
+
+	private:
+		static std::atomic<uint32_t>& counter () {
+			static std::atomic<uint32_t> next_id (0);
+			return next_id;
+		}
+	};
+
+	static const size_t MAX_COMPONENT_TYPES = 256;
+
+	////////////////////////////////////////////////////////////
+	/// \brief One bit per component type id
+	///
+	////////////////////////////////////////////////////////////
+	using ComponentSignature = std::bitset<MAX_COMPONENT_TYPES>;
+} //namespace rlms
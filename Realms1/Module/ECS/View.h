@@ -0,0 +1,51 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Archetype.h"
+
+namespace rlms {
+	////////////////////////////////////////////////////////////
+	/// \brief Archetypes holding every type of a signature
+	///
+	/// Kept by the ArchetypeStorage and completed each time an
+	/// archetype is created, never rebuilt.
+	///
+	////////////////////////////////////////////////////////////
+	struct ArchetypeQuery {
+		ComponentSignature signature;
+		ArenaVector<Archetype*> archetypes;
+
+		ArchetypeQuery (Allocator* const& arena, ComponentSignature const& query) : signature (query), archetypes (ArenaAllocator<Archetype*> (arena)) {}
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Entities having all of Cs
+	///
+	/// Cheap to copy, the matching archetypes are cached in the
+	/// storage. Adding or removing components while iterating
+	/// is not allowed.
+	///
+	////////////////////////////////////////////////////////////
+	template<class... Cs> class View {
+	public:
+		View (ArchetypeQuery* const& query);
+
+		//Calls f (ENTITY_ID, Cs&...) for each entity, column by column
+		template<class F> void each (F f);
+		//Same as each with ranges of chunks spread over the ThreadPool, f is called concurrently
+		template<class F> void parallelEach (F f);
+
+		//Entities in the view
+		size_t size () const;
+
+	private:
+		template<class F> static void eachChunk (F& f, Archetype* archetype, size_t chunk);
+		template<class F> static void eachRows (F& f, size_t count, ENTITY_ID* entities, Cs*... columns);
+
+		ArchetypeQuery* _query;
+	};
+} //namespace rlms
+
+#include "View.inl"
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../../Utility/MultiThreading/ThreadPool.h"
+
+#include <algorithm>
+
+namespace rlms {
+	template<class... Cs> inline View<Cs...>::View (ArchetypeQuery* const& query) : _query (query) {}
+
+	template<class... Cs> template<class F> inline void View<Cs...>::each (F f) {
+		for (auto it = _query->archetypes.begin (); it != _query->archetypes.end (); it++) {
+			for (size_t chunk = 0; chunk < (*it)->getChunkCount (); chunk++) {
+				eachChunk (f, *it, chunk);
+			}
+		}
+	}
+
+	template<class... Cs> template<class F> inline void View<Cs...>::parallelEach (F f) {
+		size_t chunk_count = 0;
+		for (auto it = _query->archetypes.begin (); it != _query->archetypes.end (); it++) {
+			chunk_count += (*it)->getChunkCount ();
+		}
+
+		ArchetypeQuery* query = _query;
+
+		//Ranges are numbered over the chunks of every archetype, one after the other
+		ThreadPool::ParallelFor (chunk_count, 1, [query, &f](size_t begin, size_t end) {
+			size_t first = 0;
+
+			for (auto it = query->archetypes.begin (); it != query->archetypes.end () && first < end; it++) {
+				size_t last = first + (*it)->getChunkCount ();
+
+				for (size_t chunk = std::max (begin, first); chunk < std::min (end, last); chunk++) {
+					eachChunk (f, *it, chunk - first);
+				}
+				first = last;
+			}
+		});
+	}
+
+	template<class... Cs> inline size_t View<Cs...>::size () const {
+		size_t count = 0;
+		for (auto it = _query->archetypes.begin (); it != _query->archetypes.end (); it++) {
+			count += (*it)->getCount ();
+		}
+		return count;
+	}
+
+	template<class... Cs> template<class F> inline void View<Cs...>::eachChunk (F& f, Archetype* archetype, size_t chunk) {
+		eachRows (f, archetype->getChunkRows (chunk), archetype->entities (chunk), archetype->template column<Cs> (chunk)...);
+	}
+
+	template<class... Cs> template<class F> inline void View<Cs...>::eachRows (F& f, size_t count, ENTITY_ID* entities, Cs*... columns) {
+		for (size_t i = 0; i < count; i++) {
+			f (entities[i], columns[i]...);
+		}
+	}
+}
@@ -1,7 +1,7 @@
 #include "GraphicsManager.h"
 
 #include "../../Base/Logging/ILogged.h"
-#include "../../Base/Allocators/Allocator.h"
+#include "../../Base/Allocators/BudgetAllocator.h"
 
 #include "../../Utility/FileIO/VoxFileParser.h"
 
@@ -27,7 +27,10 @@ private:
 		return "GraphicsManager";
 	};
 
-	void start (Allocator* const& alloc, size_t mesh_pool_size, std::shared_ptr<Logger> funnel = nullptr);
+	//Bytes of meshes compacted each frame
+	static const size_t MESH_DEFRAGMENT_BUDGET = 4 * 1024;
+
+	void start (BudgetAllocator* const& budget, size_t mesh_pool_size, std::shared_ptr<Logger> funnel = nullptr);
 	void stop ();
 
 	MeshRegister* getRegister ();
@@ -48,12 +51,12 @@ private:
 	} sun;
 };
 
-void rlms::GraphicsManagerImpl::start (Allocator* const& alloc, size_t mesh_pool_size, std::shared_ptr<Logger> funnel) {
+void rlms::GraphicsManagerImpl::start (BudgetAllocator* const& budget, size_t mesh_pool_size, std::shared_ptr<Logger> funnel) {
 	startLogger (funnel);
 	logger->tag (LogTags::None) << "Initializing !" << '\n';
 	//ok
 	meshRegister = std::make_unique<MeshRegister> ();
-	meshRegister->start (alloc, mesh_pool_size, logger);
+	meshRegister->start (budget, mesh_pool_size, logger);
 
 	renderer = std::make_unique<GameRenderer> ();
 
@@ -139,6 +142,9 @@ void rlms::GraphicsManagerImpl::loadRenderer () {
 }
 
 void rlms::GraphicsManagerImpl::draw () {
+	//Before any mesh pointer is taken for this frame
+	meshRegister->defragment (MESH_DEFRAGMENT_BUDGET);
+
 	glClearColor (0.0f, 0.0f, 0.0f, 1.0f);
 	glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -207,9 +213,9 @@ std::shared_ptr<LoggerHandler> rlms::GraphicsManager::GetLogger () {
 	return instance->getLogger ();
 }
 
-void rlms::GraphicsManager::Initialize (Allocator* const& alloc, size_t mesh_pool_size, std::shared_ptr<Logger> funnel) {
+void rlms::GraphicsManager::Initialize (BudgetAllocator* const& budget, size_t mesh_pool_size, std::shared_ptr<Logger> funnel) {
 	instance = std::make_unique<GraphicsManagerImpl> ();
-	instance->start (alloc, mesh_pool_size, funnel);
+	instance->start (budget, mesh_pool_size, funnel);
 }
 
 void rlms::GraphicsManager::Terminate () {
@@ -16,6 +16,12 @@ namespace rlms {
 		IMesh (std::string filename) : m_filename (filename) {};
 		virtual ~IMesh () = default;
 
+		//Meshes are moved when their pool is defragmented
+		IMesh (const IMesh&) = default;
+		IMesh (IMesh&&) = default;
+		IMesh& operator=(const IMesh&) = default;
+		IMesh& operator=(IMesh&&) = default;
+
 		const std::string getFile () const {
 			return m_filename;
 		}
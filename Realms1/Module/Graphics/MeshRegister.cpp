@@ -4,11 +4,26 @@
 
 #include "MeshNameSanitizer.h"
 
-void rlms::MeshRegister::start (Allocator* const& alloc, size_t mesh_pool_size, std::shared_ptr<Logger> funnel) {
+void rlms::MeshRegister::start (BudgetAllocator* const& budget, size_t mesh_pool_size, std::shared_ptr<Logger> funnel) {
 	startLogger (funnel);
 	logger->tag (LogTags::None) << "Initializing !" << '\n';
 
-	m_model_Allocator = std::unique_ptr<FreeListAllocator> (new FreeListAllocator (alloc->allocate (mesh_pool_size), mesh_pool_size));
+	//The last quarter of the pool holds the meshes, the rest their data and the maps
+	void* mesh_pool = budget->allocate (mesh_pool_size);
+	size_t entry_pool_size = mesh_pool_size / ENTRY_POOL_DIVISOR;
+	size_t model_pool_size = mesh_pool_size - entry_pool_size;
+
+	m_model_Allocator = std::unique_ptr<TLSFAllocator> (new TLSFAllocator (mesh_pool, model_pool_size));
+	m_model_Allocator->setTag (AllocTag::Mesh);
+	m_entry_Allocator = std::unique_ptr<RelocatingAllocator> (new RelocatingAllocator (pointerMath::add (mesh_pool, model_pool_size), entry_pool_size));
+	m_entry_Allocator->setTag (AllocTag::Mesh);
+
+	//No overflow, the application arena hands out the same block to every request
+	m_model_Budget = std::make_unique<BudgetAllocator> ("Mesh data", m_model_Allocator.get (), model_pool_size, budget);
+	m_entry_Budget = std::make_unique<BudgetAllocator> ("Meshes", m_entry_Allocator.get (), entry_pool_size, budget);
+
+	m_register = ArenaMap<IMODEL_TYPE_ID, Handle> (ArenaAllocator<std::pair<const IMODEL_TYPE_ID, Handle>> (m_model_Budget.get ()));
+	m_dict = ArenaMap<std::string, IMODEL_TYPE_ID> (ArenaAllocator<std::pair<const std::string, IMODEL_TYPE_ID>> (m_model_Budget.get ()));
 
 	logger->tag (LogTags::None) << "Initialized correctly !" << '\n';
 }
@@ -17,7 +32,9 @@ void rlms::MeshRegister::stop () {
 	logger->tag (LogTags::None) << "Stopping !" << '\n';
 
 	for (auto it = m_register.begin (); it != m_register.end (); it++) {
-		allocator::deallocateDelete<IMesh> (*m_model_Allocator.get(), it->second);
+		if (m_entry_Allocator->isValid (it->second)) {
+			allocator::deallocateRelocatable<IMesh> (*m_entry_Allocator.get (), it->second);
+		}
 	}
 
 	logger->tag (LogTags::None) << "Stopped correctly !" << '\n';
@@ -38,36 +55,45 @@ void rlms::MeshRegister::RegisterAlias (IMODEL_TYPE_ID type_id, std::string&& na
 
 void rlms::MeshRegister::imports () {
 	for (auto it = m_register.begin (); it != m_register.end (); it++) {
-		it->second->import ();
+		get (it->first)->import ();
 	}
 }
 
 void rlms::MeshRegister::optimises () {
 	for (auto it = m_register.begin (); it != m_register.end (); it++) {
-		it->second->optimise ();
+		get (it->first)->optimise ();
 	}
 }
 
 void rlms::MeshRegister::loads () {
 	for (auto it = m_register.begin (); it != m_register.end (); it++) {
-		it->second->load ();
+		get (it->first)->load ();
 	}
 }
 
 void rlms::MeshRegister::unloads () {
 	for (auto it = m_register.begin (); it != m_register.end (); it++) {
-		it->second->unload ();
+		get (it->first)->unload ();
 	}
 }
 
 void rlms::MeshRegister::free () {
 	for (auto it = m_register.begin (); it != m_register.end (); it++) {
-		allocator::deallocateDelete<IMesh> (*m_model_Allocator.get (), it->second);
+		if (m_entry_Allocator->isValid (it->second)) {
+			allocator::deallocateRelocatable<IMesh> (*m_entry_Allocator.get (), it->second);
+		}
 	}
 }
 
+size_t rlms::MeshRegister::defragment (size_t maxBytes) {
+	//Moved meshes copy their data within the mesh arena
+	ArenaScope scope (m_model_Budget.get ());
+	return m_entry_Allocator->defragment (maxBytes);
+}
+
 IMesh* rlms::MeshRegister::get (IMODEL_TYPE_ID const& type_id) {
-	return m_register[type_id];
+	//Meshes only derive from IMesh, the block starts with it
+	return static_cast<IMesh*>(m_entry_Allocator->get (m_register[type_id]));
 }
 
 IMesh* rlms::MeshRegister::get (std::string && alias) {
@@ -76,5 +102,5 @@ IMesh* rlms::MeshRegister::get (std::string && alias) {
 		throw RlmsException ("Mesh not found");
 	}
 	IMODEL_TYPE_ID const type_id = it->second;
-	return m_register[type_id];
+	return get (type_id);
 }
@@ -2,7 +2,10 @@
 
 #include "../../CoreTypes.h"
 #include "../../Base/RlmsException.h"
-#include "../../Base/Allocators/FreeListAllocator.h"
+#include "../../Base/Allocators/TLSFAllocator.h"
+#include "../../Base/Allocators/ArenaAllocator.h"
+#include "../../Base/Allocators/RelocatingAllocator.h"
+#include "../../Base/Allocators/BudgetAllocator.h"
 #include "../../Base/Logging/ILogged.h"
 #include "IMesh.h"
 
@@ -10,22 +13,31 @@
 
 #include <map>
 #include <memory>
+#include <type_traits>
 
 namespace rlms {
 	class MeshRegister : public ILogged {
 	public:
+		//Share of the mesh pool given to the meshes themselves
+		static const size_t ENTRY_POOL_DIVISOR = 4;
+
+		//Declared first so the maps are released before their arena
+		std::unique_ptr<TLSFAllocator> m_model_Allocator;
+		std::unique_ptr<BudgetAllocator> m_model_Budget;
+		//The meshes themselves, kept dense by defragment ()
+		std::unique_ptr<RelocatingAllocator> m_entry_Allocator;
+		std::unique_ptr<BudgetAllocator> m_entry_Budget;
+
 		//links a mesh to an ID
-		std::map<IMODEL_TYPE_ID, IMesh*> m_register;
+		ArenaMap<IMODEL_TYPE_ID, Handle> m_register;
 		//links an id to one or multiples names
-		std::map<std::string, IMODEL_TYPE_ID> m_dict;
-
-		std::unique_ptr<FreeListAllocator> m_model_Allocator;
+		ArenaMap<std::string, IMODEL_TYPE_ID> m_dict;
 		
 		std::string getLogName () override {
 			return "MeshRegister";
 		};
 
-		void start (Allocator* const& alloc, size_t mesh_pool_size, std::shared_ptr<Logger> funnel = nullptr);
+		void start (BudgetAllocator* const& budget, size_t mesh_pool_size, std::shared_ptr<Logger> funnel = nullptr);
 		void stop ();
 
 		//word register is reserved by cpp standards so i keep the uppercase
@@ -39,6 +51,9 @@ namespace rlms {
 		void unloads ();
 		void free ();
 
+		//Moves at most maxBytes of meshes, pointers given by get () are invalidated
+		size_t defragment (size_t maxBytes);
+
 		IMesh* get (IMODEL_TYPE_ID const& type_id);
 		IMesh* get (std::string && alias);
 	};
@@ -50,6 +65,8 @@ namespace rlms {
 			logger->tag (LogTags::Error) << "Invalid Mesh type!\n";
 			throw std::exception ("Invalid Mesh type.");
 		}
+		//defragment () charges the block size only, a copying move would cost the whole mesh data
+		static_assert (std::is_nothrow_move_constructible<M>::value, "Meshes must be cheap to move");
 
 		//invalid filename
 		if (filename.empty ()) { //to be modified
@@ -61,8 +78,13 @@ namespace rlms {
 		std::string alias = MeshNameSanitizer::GetAlias (filename);
 		alias = MeshNameSanitizer::Sanitize (alias);
 		
-		//valid
-		IMesh* m = allocator::allocateNew<M, std::string> (*m_model_Allocator.get (), std::move (filename));
+		//valid, the mesh's own containers come from the mesh arena too
+		ArenaScope scope (m_model_Budget.get ());
+		Handle m = allocator::allocateRelocatable<M, std::string> (*m_entry_Allocator.get (), std::move (filename));
+		if (m.isNull ()) {
+			logger->tag (LogTags::Error) << "Mesh pool full!\n";
+			throw RlmsException ("Mesh pool full.");
+		}
 		m_register.emplace (std::make_pair (type_id, m));
 		m_dict.emplace (std::make_pair (alias, type_id));
 	}
@@ -74,6 +96,8 @@ namespace rlms {
 			logger->tag (LogTags::Error) << "Invalid Mesh type!\n";
 			throw std::exception ("Invalid Mesh type.");
 		}
+		//defragment () charges the block size only, a copying move would cost the whole mesh data
+		static_assert (std::is_nothrow_move_constructible<M>::value, "Meshes must be cheap to move");
 
 		//invalid filename
 		if (filename.empty ()) { //to be modified
@@ -82,8 +106,13 @@ namespace rlms {
 		}
 
 		alias = MeshNameSanitizer::Sanitize (alias);
-		//valid
-		IMesh* m = allocator::allocateNew<M, std::string> (*m_model_Allocator.get (), std::move (filename));
+		//valid, the mesh's own containers come from the mesh arena too
+		ArenaScope scope (m_model_Budget.get ());
+		Handle m = allocator::allocateRelocatable<M, std::string> (*m_entry_Allocator.get (), std::move (filename));
+		if (m.isNull ()) {
+			logger->tag (LogTags::Error) << "Mesh pool full!\n";
+			throw RlmsException ("Mesh pool full.");
+		}
 		m_register.emplace (std::make_pair (type_id, m));
 		m_dict.emplace (std::make_pair (alias, type_id));
 	}
@@ -9,7 +9,7 @@ const size_t rlms::StaticMesh::getVertexCount () const {
 	return m_vxs.getSize ();
 }
 
-const std::vector<Voxel>& rlms::StaticMesh::getVoxels () {
+const ArenaVector<Voxel>& rlms::StaticMesh::getVoxels () {
 	return m_vxs.getVoxels ();
 }
 
@@ -29,8 +29,10 @@ void rlms::StaticMesh::load () {
 	// Create VBO with point coordinates
 	glGenBuffers (1, &_vbo);
 
-	auto voxels = getVoxels ();
-	std::vector<GLint> points;
+	//Staging buffer taken from the mesh's arena
+	const auto& voxels = getVoxels ();
+	ArenaVector<GLint> points (voxels.get_allocator ());
+	points.reserve (voxels.size () * 5);
 	for (auto it = voxels.begin (); it != voxels.end (); it++) {
 		points.push_back (it->x);
 		points.push_back (it->y);
@@ -46,8 +48,10 @@ void rlms::StaticMesh::load () {
 void rlms::StaticMesh::reload () {
 	glBindVertexArray (_vao);
 
-	auto voxels = getVoxels ();
-	std::vector<GLint> points;
+	//Staging buffer taken from the mesh's arena
+	const auto& voxels = getVoxels ();
+	ArenaVector<GLint> points (voxels.get_allocator ());
+	points.reserve (voxels.size () * 5);
 	for (auto it = voxels.begin (); it != voxels.end (); it++) {
 		points.push_back (it->x);
 		points.push_back (it->y);
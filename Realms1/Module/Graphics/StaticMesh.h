@@ -20,7 +20,7 @@ namespace rlms {
 		const Voxel* getData () const;
 		const size_t getVertexCount ()const override;
 
-		const std::vector<Voxel>& getVoxels ();
+		const ArenaVector<Voxel>& getVoxels ();
 
 	public:
 		StaticMesh () : IMesh (""), _vao (), _vbo () {};
@@ -35,7 +35,5 @@ namespace rlms {
 		void bind () override;
 		void draw () override;
 		void unload () override;
-
-		~StaticMesh () {};
 	};
 }
@@ -68,23 +68,23 @@ public:
 
 bool rlms::InputManagerImpl::start (std::shared_ptr<Logger> funnel) {
 	startLogger (funnel);
-	logger->tag (LogTags::None) << "Initializing !" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Initializing !" << '\n';
 	m_globalMap.enable ();
-	logger->tag (LogTags::None) << "Initialized correctly !" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Initialized correctly !" << '\n';
 	return true;
 }
 
 void rlms::InputManagerImpl::stop () {
-	logger->tag (LogTags::None) << "Stopping" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Stopping" << '\n';
 	clearInputs ();
-	logger->tag (LogTags::None) << "Stopped correctly !" << '\n';
+	RLMS_LOG (logger, LogTags::None) << "Stopped correctly !" << '\n';
 }
 
 //get will create a new map if no one is found
 std::unordered_map<std::string, rlms::InputMap*>::iterator rlms::InputManagerImpl::__getMap (std::string mapName) {
 	auto it = m_maps.find (mapName);
 	if (it == m_maps.end ()) {
-		logger->tag (LogTags::Info) << "Creating map : " << mapName << ".\n";
+		RLMS_LOG (logger, LogTags::Info) << "Creating map : " << mapName << ".\n";
 		m_maps.insert (std::make_pair (mapName, new InputMap ()));
 		it = m_maps.find (mapName);
 	}
@@ -103,12 +103,12 @@ std::unordered_map<std::string, rlms::InputMap*>::iterator rlms::InputManagerImp
 void rlms::InputManagerImpl::bindInput (std::string const& name, sf::Keyboard::Key && key) {
 	if (AssignSanitizer::IsGlobal (name)) {
 		std::string inputName = AssignSanitizer::NameSanitizer (name);
-		logger->tag (LogTags::Info) << inputName << " Binding Global Key Input.\n";
+		RLMS_LOG (logger, LogTags::Info) << inputName << " Binding Global Key Input.\n";
 		m_globalMap.bindInput (inputName, std::move (key));
 	} else {
 		std::string mapName = AssignSanitizer::GetMapName (name);
 		std::string inputName = AssignSanitizer::GetInputName (name);
-		logger->tag (LogTags::Info) << mapName << "::" << inputName << " Binding Key Input.\n";
+		RLMS_LOG (logger, LogTags::Info) << mapName << "::" << inputName << " Binding Key Input.\n";
 
 		auto it = __getMap (mapName);
 
@@ -118,12 +118,12 @@ void rlms::InputManagerImpl::bindInput (std::string const& name, sf::Keyboard::K
 void rlms::InputManagerImpl::bindInput (std::string const& name, sf::Mouse::Button && button) {
 	if (AssignSanitizer::IsGlobal (name)) {
 		std::string inputName = AssignSanitizer::NameSanitizer (name);
-		logger->tag (LogTags::Info) << inputName << " Binding Global Mouse Input.\n";
+		RLMS_LOG (logger, LogTags::Info) << inputName << " Binding Global Mouse Input.\n";
 		m_globalMap.bindInput (inputName, std::move (button));
 	} else {
 		std::string mapName = AssignSanitizer::GetMapName (name);
 		std::string inputName = AssignSanitizer::GetInputName (name);
-		logger->tag (LogTags::Info) << mapName << "::" << inputName << " Binding Mouse Input.\n";
+		RLMS_LOG (logger, LogTags::Info) << mapName << "::" << inputName << " Binding Mouse Input.\n";
 
 		auto it = __getMap (mapName);
 
@@ -133,12 +133,12 @@ void rlms::InputManagerImpl::bindInput (std::string const& name, sf::Mouse::Butt
 void rlms::InputManagerImpl::bindSlide (std::string const& name, sf::Keyboard::Key && key) {
 	if (AssignSanitizer::IsGlobal (name)) {
 		std::string inputName = AssignSanitizer::NameSanitizer (name);
-		logger->tag (LogTags::Info) << inputName << "Binding Global Key Slide Input.\n";
+		RLMS_LOG (logger, LogTags::Info) << inputName << "Binding Global Key Slide Input.\n";
 		m_globalMap.bindSlide (inputName, std::move (key));
 	} else {
 		std::string mapName = AssignSanitizer::GetMapName (name);
 		std::string inputName = AssignSanitizer::GetInputName (name);
-		logger->tag (LogTags::Info) << mapName << "::" << inputName << " Binding Key Slide Input.\n";
+		RLMS_LOG (logger, LogTags::Info) << mapName << "::" << inputName << " Binding Key Slide Input.\n";
 
 		auto it = __getMap (mapName);
 
@@ -149,12 +149,12 @@ void rlms::InputManagerImpl::bindSlide (std::string const& name, sf::Mouse::Butt
 
 	if (AssignSanitizer::IsGlobal (name)) {
 		std::string inputName = AssignSanitizer::NameSanitizer (name);
-		logger->tag (LogTags::Info) << inputName << " Binding Global Mouse Slide Input.\n";
+		RLMS_LOG (logger, LogTags::Info) << inputName << " Binding Global Mouse Slide Input.\n";
 		m_globalMap.bindSlide (inputName, std::move (button));
 	} else {
 		std::string mapName = AssignSanitizer::GetMapName (name);
 		std::string inputName = AssignSanitizer::GetInputName (name);
-		logger->tag (LogTags::Info) << mapName << "::" << inputName << " Binding Mouse Slide Input.\n";
+		RLMS_LOG (logger, LogTags::Info) << mapName << "::" << inputName << " Binding Mouse Slide Input.\n";
 
 		auto it = __getMap (mapName);
 
@@ -166,13 +166,13 @@ void rlms::InputManagerImpl::bindEvent (std::string const& name, sf::Event::Even
 
 	if (AssignSanitizer::IsGlobal (name)) {
 		std::string inputName = AssignSanitizer::NameSanitizer (name);
-		logger->tag (LogTags::Info) << inputName << " Binding Global Event Input.\n";
+		RLMS_LOG (logger, LogTags::Info) << inputName << " Binding Global Event Input.\n";
 		m_globalMap.bindEvent (inputName, std::move (e));
 	} else {
 		std::string mapName = AssignSanitizer::GetMapName (name);
 		std::string inputName = AssignSanitizer::GetInputName (name);
-		logger->tag (LogTags::Info) << mapName << "::" << inputName << " Binding Event Input.\n";
-		logger->tag (LogTags::Warning) << "Binding will never be triggered !\n";
+		RLMS_LOG (logger, LogTags::Info) << mapName << "::" << inputName << " Binding Event Input.\n";
+		RLMS_LOG (logger, LogTags::Warning) << "Binding will never be triggered !\n";
 
 		auto it = __getMap (mapName);
 
@@ -181,25 +181,25 @@ void rlms::InputManagerImpl::bindEvent (std::string const& name, sf::Event::Even
 }
 
 void rlms::InputManagerImpl::enableInputMap (std::string const& mapName) {
-	logger->tag (LogTags::Info) << "Enabled Map : " << mapName << ".\n";
+	RLMS_LOG (logger, LogTags::Info) << "Enabled Map : " << mapName << ".\n";
 	auto it = __findMap (mapName);
 	it->second->enable ();
 }
 
 void rlms::InputManagerImpl::disableInputMap (std::string const& mapName) {
-	logger->tag (LogTags::Info) << "Disabled Map : " << mapName << ".\n";
+	RLMS_LOG (logger, LogTags::Info) << "Disabled Map : " << mapName << ".\n";
 	auto it = __findMap (mapName);
 	it->second->disable ();
 }
 
 void rlms::InputManagerImpl::unbindInput (std::string const& name) {
 	if (AssignSanitizer::IsGlobal (name)) {
-		logger->tag (LogTags::Info) << "Unbinding Global Input : " << name << ".\n";
+		RLMS_LOG (logger, LogTags::Info) << "Unbinding Global Input : " << name << ".\n";
 		m_globalMap.unbindInput (name);
 	} else {
 		std::string mapName = AssignSanitizer::GetMapName (name);
 		std::string inputName = AssignSanitizer::GetInputName (name);
-		logger->tag (LogTags::Info) << "Unbinding Input : " << inputName << ", to map : " << mapName << ".\n";
+		RLMS_LOG (logger, LogTags::Info) << "Unbinding Input : " << inputName << ", to map : " << mapName << ".\n";
 
 		auto it = __findMap (mapName);
 
@@ -208,7 +208,7 @@ void rlms::InputManagerImpl::unbindInput (std::string const& name) {
 }
 
 void rlms::InputManagerImpl::clearInputs () {
-	logger->tag (LogTags::Warning) << "Clearing all Inputs.\n";
+	RLMS_LOG (logger, LogTags::Warning) << "Clearing all Inputs.\n";
 	while (!m_maps.empty ()) {
 		auto it = m_maps.begin ();
 		it->second->clearInputs ();
@@ -0,0 +1,14 @@
+#include "BlockPrototype.h"
+
+#include "../Graphics/GraphicsManager.h"
+
+void rlms::BlockPrototype::load () {
+	IMesh* m = mesh ();
+	m->import ();
+	m->optimise ();
+	m->load ();
+}
+
+IMesh* rlms::BlockPrototype::mesh () {
+	return GraphicsManager::GetMesh (m_mesh_id);
+}
@@ -10,21 +10,18 @@ namespace rlms {
 	class BlockPrototype {
 	private:
 		BLOCK_TYPE_ID m_type_id;
-		IMesh* m_mesh;
+		//Meshes move when their pool is compacted, so only the id is kept
+		IMODEL_TYPE_ID m_mesh_id;
 		bool m_transparency;
 
 	public:
-		BlockPrototype (BLOCK_TYPE_ID type_id, IMesh* mesh, bool transparency = false) :
-			m_type_id (type_id), m_transparency (transparency), m_mesh (mesh) {};
+		BlockPrototype (BLOCK_TYPE_ID type_id, IMODEL_TYPE_ID mesh_id, bool transparency = false) :
+			m_type_id (type_id), m_transparency (transparency), m_mesh_id (mesh_id) {};
 
 		BlockPrototype () :
-			m_type_id (Block::None), m_transparency (true), m_mesh (nullptr) {};
+			m_type_id (Block::None), m_transparency (true), m_mesh_id (0) {};
 
-		void load() {
-			m_mesh->import ();
-			m_mesh->optimise ();
-			m_mesh->load ();
-		}
+		void load ();
 
 		void create (Block& b) {
 			b = Block (m_type_id, m_transparency);
@@ -34,8 +31,7 @@ namespace rlms {
 
 		}
 
-		IMesh* mesh () {
-			return m_mesh;
-		}
+		//Valid until the meshes are next compacted
+		IMesh* mesh ();
 	};
 }
\ No newline at end of file
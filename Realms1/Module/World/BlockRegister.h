@@ -13,8 +13,8 @@ namespace rlms{
 		static std::map<BLOCK_TYPE_ID, BlockPrototype> m_register;
 	public:
 
-		static void Register (BLOCK_TYPE_ID type_id, IMesh* mesh, bool transparency = false) {
-			m_register.try_emplace (type_id, type_id, mesh, transparency);
+		static void Register (BLOCK_TYPE_ID type_id, IMODEL_TYPE_ID mesh_id, bool transparency = false) {
+			m_register.try_emplace (type_id, type_id, mesh_id, transparency);
 		}
 
 		static BlockPrototype* Get (BLOCK_TYPE_ID const& type_id) {
@@ -35,15 +35,14 @@ namespace rlms {
 		}
 
 		void optimize () {
-			auto blocks = std::vector<std::vector<std::vector<IVoxel>>> 
-				(CHUNK_DIM, std::vector<std::vector<IVoxel>> 
-				(CHUNK_DIM, std::vector<IVoxel> 
-				(CHUNK_DIM, IVoxel ())));
+			//Grid released on return
+			StackScope scope (StackAllocator::ThreadScratch ());
+			VoxelGrid blocks (scope.stack (), CHUNK_DIM, CHUNK_DIM, CHUNK_DIM);
 
 			for (int z = 0; z < CHUNK_DIM; z++) {
 				for (int y = 0; y < CHUNK_DIM; y++) {
 					for (int x = 0; x < CHUNK_DIM; x++) {
-						blocks[x][y][z].culling = m_blocks[x][y][z].culling;
+						blocks.at (x, y, z).culling = m_blocks[x][y][z].culling;
 					}
 				}
 			}
@@ -53,7 +52,7 @@ namespace rlms {
 			for (int z = 0; z < CHUNK_DIM; z++) {
 				for (int y = 0; y < CHUNK_DIM; y++) {
 					for (int x = 0; x < CHUNK_DIM; x++) {
-						m_blocks[x][y][z].culling = blocks[x][y][z].culling;
+						m_blocks[x][y][z].culling = blocks.at (x, y, z).culling;
 					}
 				}
 			}
@@ -1,11 +1,12 @@
 #pragma once
 
 #include "../../Base/Allocators/PoolAllocator.h"
-#include "../../Base/Allocators/FreeListAllocator.h"
+#include "../../Base/Allocators/RelocatingAllocator.h"
 #include "../../Base/Logging/ILogged.h"
 
 #include "Chunk.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace rlms {
@@ -40,27 +41,70 @@ namespace rlms {
 	///
 	////////////////////////////////////////////////////////////
 
-		std::vector<Chunk*> m_activeChunks;
+		//Chunks are compacted as they are unloaded, they are only reached through handles
+		std::vector<Handle> m_activeChunks;
 
-		std::unique_ptr<FreeListAllocator> m_chunk_allocator;
+		std::unique_ptr<RelocatingAllocator> m_chunk_allocator;
+		//Gets the chunk pool back
+		Allocator* m_parent;
 	public:
+		//Chunks moved per update
+		static const size_t DEFRAGMENT_BUDGET = 4 * sizeof (Chunk);
 
 		std::string getLogName () override {
 			return "ChunkManager";
 		};
 
-		ChunkManager () : m_activeChunks(), m_chunk_allocator() {};
-		ChunkManager (Allocator* const& alloc, size_t chunk_pool_size, std::shared_ptr<Logger> funnel = nullptr) {
+		ChunkManager () : m_activeChunks(), m_chunk_allocator(), m_parent(nullptr) {};
+		ChunkManager (Allocator* const& alloc, size_t chunk_pool_size, std::shared_ptr<Logger> funnel = nullptr) : m_activeChunks(), m_chunk_allocator(), m_parent(alloc) {
 
 			startLogger (funnel);
 			logger->tag (LogTags::None) << "Initializing !" << '\n';
 
-			m_chunk_allocator = std::unique_ptr<FreeListAllocator> (new FreeListAllocator (alloc->allocate (chunk_pool_size), chunk_pool_size));
+			m_chunk_allocator = std::unique_ptr<RelocatingAllocator> (new RelocatingAllocator (alloc->allocate (chunk_pool_size), chunk_pool_size));
+			m_chunk_allocator->setTag (AllocTag::Chunk);
 
 			logger->tag (LogTags::None) << "Initialized correctly !" << '\n';
 		};
-		void createChunk () {
+		~ChunkManager () {
+			for (auto it = m_activeChunks.begin (); it != m_activeChunks.end (); it++) {
+				allocator::deallocateRelocatable<Chunk> (*m_chunk_allocator.get (), *it);
+			}
 
+			if (m_chunk_allocator) {
+				void* pool = m_chunk_allocator->getStart ();
+				m_chunk_allocator.reset ();
+				m_parent->deallocate (std::move (pool));
+			}
+		};
+
+		//Null handle when the chunk pool is full
+		Handle createChunk () {
+			Handle chunk = allocator::allocateRelocatable<Chunk> (*m_chunk_allocator.get ());
+			if (chunk.isNull ()) {
+				logger->tag (LogTags::Warning) << "Chunk pool full !" << '\n';
+				return chunk;
+			}
+			m_activeChunks.push_back (chunk);
+			return chunk;
+		}
+
+		//Valid until the next update or createChunk
+		Chunk* getChunk (const Handle& chunk) {
+			return static_cast<Chunk*>(m_chunk_allocator->get (chunk));
+		}
+
+		void destroyChunk (Handle& chunk) {
+			auto it = std::find (m_activeChunks.begin (), m_activeChunks.end (), chunk);
+			if (it == m_activeChunks.end ()) return;
+
+			m_activeChunks.erase (it);
+			allocator::deallocateRelocatable<Chunk> (*m_chunk_allocator.get (), chunk);
+		}
+
+		//Slides a few chunks over the holes left by destroyed ones
+		void update () {
+			m_chunk_allocator->defragment (DEFRAGMENT_BUDGET);
 		}
 	};
 }
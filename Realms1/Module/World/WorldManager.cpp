@@ -11,18 +11,19 @@ private:
 	};
 
 	std::map<BLOCK_TYPE_ID, BlockPrototype> m_register;
-	std::unique_ptr<FreeListAllocator> m_chunk_allocator;
+	std::unique_ptr<ChunkManager> m_chunks;
 
-	bool start (Allocator* const& alloc, size_t chunk_pool_size, std::shared_ptr<Logger> funnel = nullptr);
+	bool start (BudgetAllocator* const& budget, size_t chunk_pool_size, std::shared_ptr<Logger> funnel = nullptr);
 	void stop ();
 
 };
 
-bool rlms::WorldManagerImpl::start (Allocator* const& alloc, size_t chunk_pool_size, std::shared_ptr<Logger> funnel) {
+bool rlms::WorldManagerImpl::start (BudgetAllocator* const& budget, size_t chunk_pool_size, std::shared_ptr<Logger> funnel) {
 	startLogger (funnel);
 	logger->tag (LogTags::None) << "Initializing !" << '\n';
 
-	m_chunk_allocator = std::unique_ptr<FreeListAllocator> (new FreeListAllocator (alloc->allocate (chunk_pool_size), chunk_pool_size));
+	//Chunks are relocatable, the pool is compacted a bit every tick
+	m_chunks = std::make_unique<ChunkManager> (budget, chunk_pool_size, funnel);
 
 	WorldManager::n_errors = 0;
 	logger->tag (LogTags::None) << "Initialized correctly !" << '\n';
@@ -32,6 +33,7 @@ bool rlms::WorldManagerImpl::start (Allocator* const& alloc, size_t chunk_pool_s
 void rlms::WorldManagerImpl::stop () {
 	logger->tag (LogTags::None) << "Stopping !" << '\n';
 
+	m_chunks.reset ();
 	logger->tag (LogTags::None) << "Stopped correctly !" << '\n';
 }
 
@@ -42,12 +44,28 @@ std::shared_ptr<rlms::LoggerHandler> rlms::WorldManager::GetLogger () {
 	return instance->getLogger ();
 }
 
-bool rlms::WorldManager::Initialize (Allocator* const& alloc, size_t chunk_pool_size, std::shared_ptr<Logger> funnel) {
+bool rlms::WorldManager::Initialize (BudgetAllocator* const& budget, size_t chunk_pool_size, std::shared_ptr<Logger> funnel) {
 	instance = std::make_unique<WorldManagerImpl> ();
-	return instance->start (alloc, chunk_pool_size, funnel);
+	return instance->start (budget, chunk_pool_size, funnel);
 }
 
 void rlms::WorldManager::Terminate () {
 	instance->stop ();
 	instance.reset ();
 }
+
+void rlms::WorldManager::Update () {
+	instance->m_chunks->update ();
+}
+
+Handle rlms::WorldManager::CreateChunk () {
+	return instance->m_chunks->createChunk ();
+}
+
+Chunk* rlms::WorldManager::GetChunk (const Handle& chunk) {
+	return instance->m_chunks->getChunk (chunk);
+}
+
+void rlms::WorldManager::DestroyChunk (Handle& chunk) {
+	instance->m_chunks->destroyChunk (chunk);
+}
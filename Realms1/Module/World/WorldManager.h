@@ -1,10 +1,11 @@
 #pragma once
 
 #include "../../Base/Allocators/PoolAllocator.h"
-#include "../../Base/Allocators/FreeListAllocator.h"
+#include "../../Base/Allocators/BudgetAllocator.h"
 #include "../../Base/Logging/ILogged.h"
 
 #include "BlockPrototype.h"
+#include "ChunkManager.h"
 #include <map>
 
 namespace rlms{
@@ -17,9 +18,16 @@ namespace rlms{
 		static int n_errors;
 
 		static std::shared_ptr<rlms::LoggerHandler> GetLogger ();
-		static bool Initialize (Allocator* const& alloc, size_t chunk_pool_size, std::shared_ptr<Logger> funnel = nullptr);
+		static bool Initialize (BudgetAllocator* const& budget, size_t chunk_pool_size, std::shared_ptr<Logger> funnel = nullptr);
 		static void Terminate ();
 
+		//Compacts the chunk pool a little, chunk pointers are only valid until then
+		static void Update ();
+
+		//Null handle when the chunk pool is full
+		static Handle CreateChunk ();
+		static Chunk* GetChunk (const Handle& chunk);
+		static void DestroyChunk (Handle& chunk);
 	};
 }
 
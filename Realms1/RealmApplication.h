@@ -4,6 +4,9 @@
 #include "Base/Math/VoxelMath.h"
 
 #include "Base/Allocators/ProxyAllocator.h"
+#include "Base/Allocators/FrameAllocator.h"
+#include "Base/Allocators/VirtualArena.h"
+#include "Base/Allocators/BudgetAllocator.h"
 
 #include "Utility/FileIO/VoxFileParser.h"
 
@@ -33,6 +36,7 @@ namespace rlms {
 		struct MemorySettings {
 			size_t total_size = 4096;
 			size_t mesh_size = 4096;
+			size_t frame_size = 4096;
 
 		};
 
@@ -48,8 +52,20 @@ namespace rlms {
 
 			//read all graphics and controls and mods options
 
-			void* mem = malloc (stgs.memory.total_size);
+			//Reserved and committed, but only backed by physical pages once touched
+			app_arena = std::make_unique<VirtualArena> (stgs.memory.total_size + stgs.memory.frame_size);
+			if (!app_arena->commit (stgs.memory.total_size + stgs.memory.frame_size)) {
+				logger->tag (LogTags::Error) << "Could not reserve the application memory.\n";
+				return;
+			}
+			void* mem = app_arena->getStart ();
 			app_alloc = std::make_unique<ProxyAllocator> (mem, stgs.memory.total_size);
+			app_budget = std::make_unique<BudgetAllocator> ("Application", app_alloc.get (), stgs.memory.total_size);
+
+			//End of the arena, the proxy hands out its start to every request
+			void* frame_mem = static_cast<char*>(mem) + stgs.memory.total_size;
+			frame_alloc = std::make_unique<FrameAllocator> (frame_mem, stgs.memory.frame_size);
+			frame_alloc->setTag (AllocTag::Frame);
 
 			running = true;
 			initWindow (stgs);
@@ -62,6 +78,9 @@ namespace rlms {
 			while (running) {
 				auto start = std::chrono::high_resolution_clock::now ();
 
+				//Drops the scratch data of two frames ago, the last frame's stays valid while this one renders
+				frame_alloc->swap ();
+
 				//inputManager
 				InputLoop ();
 
@@ -95,16 +114,25 @@ namespace rlms {
 
 			//delete windows
 
-			void* mem = app_alloc->getStart ();
+			frame_alloc.reset ();
+			app_budget.reset ();
 			app_alloc.reset ();
-			free (mem);
+			app_arena.reset ();
+		}
+
+		//Scratch memory of the frame, valid until the end of the next one
+		FrameAllocator* getFrameAllocator () {
+			return frame_alloc.get ();
 		}
 
 	private:
 		sf::Window* window;
 		bool running = false;
 
+		std::unique_ptr<VirtualArena> app_arena;
 		std::unique_ptr<ProxyAllocator> app_alloc;
+		std::unique_ptr<BudgetAllocator> app_budget;
+		std::unique_ptr<FrameAllocator> frame_alloc;
 
 		std::string getLogName () override {
 			return "Realms";
@@ -153,7 +181,7 @@ namespace rlms {
 		}
 
 		void initGraphics (ApplicationSettings& stgs) {
-			rlms::GraphicsManager::Initialize (app_alloc.get (), stgs.memory.mesh_size, logger);
+			rlms::GraphicsManager::Initialize (app_budget.get (), stgs.memory.mesh_size, logger);
 
 			rlms::GraphicsManager::Register (0, "Models/Default/Workbench.vox");
 			rlms::GraphicsManager::Register (1, "Models/Default/Blocks/Dirt.vox");
@@ -157,7 +157,8 @@ int old_main () {
 
 	void* mem = malloc (4096);
 	ProxyAllocator* app_alloc = new ProxyAllocator (mem, 4096);
-	rlms::GraphicsManager::Initialize (app_alloc, 4096, main_logger);
+	BudgetAllocator* app_budget = new BudgetAllocator ("Application", app_alloc, 4096);
+	rlms::GraphicsManager::Initialize (app_budget, 4096, main_logger);
 	rlms::GraphicsManager::Load ();
 
 	main_logger->tag (LogTags::Info) << "loading Shaders...\n";
@@ -216,8 +217,8 @@ int old_main () {
 	rlms::GraphicsManager::LoadRenderer ();
 	rlms::GraphicsManager::Load ();
 
-	BlockRegister::Register (3, rlms::GraphicsManager::GetMesh (1));
-	BlockRegister::Register (4, rlms::GraphicsManager::GetMesh (2));
+	BlockRegister::Register (3, 1);
+	BlockRegister::Register (4, 2);
 
 	struct dirLight {
 		glm::vec3 direction;
@@ -437,6 +438,7 @@ int old_main () {
 	rlms::GraphicsManager::Unload ();
 	rlms::GraphicsManager::Terminate ();
 
+	delete app_budget;
 	delete app_alloc;
 	free (mem);
 	
@@ -28,32 +28,31 @@ const size_t rlms::Voxelite::getSize () const {
 	return m_voxelsArray.size ();
 }
 
-const std::vector<Voxel>& rlms::Voxelite::getVoxels () {
+const ArenaVector<Voxel>& rlms::Voxelite::getVoxels () {
 	return m_voxelsArray;
 }
 
 const void rlms::Voxelite::optimise () {
-	std::vector<std::vector<std::vector<IVoxel>>> chunk;
+	//Grid released on return
+	StackScope scope (StackAllocator::ThreadScratch ());
+	VoxelGrid chunk (scope.stack (), m_dim_x, m_dim_y, m_dim_z);
 
 	char offset_x = m_dim_x / 2, offset_y = m_dim_y / 2, offset_z = m_dim_z / 2;
 
-	chunk = std::vector<std::vector<std::vector<IVoxel>>> (m_dim_x, std::vector<std::vector<IVoxel>> (m_dim_y, std::vector<IVoxel>(m_dim_z, IVoxel())));
 	for (int i = 0; i < m_voxelsArray.size (); i++) {
 		Voxel& v = m_voxelsArray[i];
-		IVoxel::Mask (chunk[v.x + offset_x][v.y + offset_y][v.z], IVoxel::Hidden);
-	}
-	for (auto it = m_voxelsArray.begin (); it != m_voxelsArray.end (); it++) {
+		IVoxel::Mask (chunk.at (v.x + offset_x, v.y + offset_y, v.z), IVoxel::Hidden);
 	}
 	VoxelMath::OcclusionCulling (chunk);
 
-	std::vector<Voxel> oldVoxelsArray = m_voxelsArray;
-	m_voxelsArray.clear ();
-
-	for (int i = 0; i < oldVoxelsArray.size(); i++) {
-		Voxel& v = oldVoxelsArray[i];
-		v.culling = chunk[v.x + offset_x][v.y + offset_y][v.z].culling;
+	//Visible voxels compacted in place
+	size_t kept = 0;
+	for (int i = 0; i < m_voxelsArray.size(); i++) {
+		Voxel& v = m_voxelsArray[i];
+		v.culling = chunk.at (v.x + offset_x, v.y + offset_y, v.z).culling;
 		if (IVoxel::HasAny (v, IVoxel::Faces)) {
-			m_voxelsArray.push_back (v);
+			m_voxelsArray[kept++] = v;
 		}
 	}
+	m_voxelsArray.erase (m_voxelsArray.begin () + kept, m_voxelsArray.end ());
 }
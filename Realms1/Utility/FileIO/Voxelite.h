@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "../../Base/Math/IVoxel.h"
+#include "../../Base/Allocators/ArenaAllocator.h"
 
 namespace rlms {
 	/*
@@ -30,19 +31,25 @@ namespace rlms {
 		unsigned char m_dim_y;
 		unsigned char m_dim_z;
 
-		std::vector<Voxel> m_voxelsArray;
+		ArenaVector<Voxel> m_voxelsArray;
 	public:
 
-		using iterator = std::vector<Voxel>::iterator;
+		using iterator = ArenaVector<Voxel>::iterator;
 
 		Voxelite () : m_voxelsArray (), m_dim_x (0), m_dim_y (0), m_dim_z (0) {}
 		virtual ~Voxelite () = default;
 
+		//The destructor would otherwise turn every move into a copy of the voxels
+		Voxelite (const Voxelite&) = default;
+		Voxelite (Voxelite&&) = default;
+		Voxelite& operator=(const Voxelite&) = default;
+		Voxelite& operator=(Voxelite&&) = default;
+
 		void addVoxel (char const& x, char const& y, char const& z, unsigned char const& color);
 		void setDims (unsigned char const& dim_x, unsigned char const& dim_y, unsigned char const& dim_z);
 		const Voxel* getData () const;
 		const size_t getSize () const;
-		const std::vector<Voxel>& getVoxels ();
+		const ArenaVector<Voxel>& getVoxels ();
 		const void optimise ();
 	};
 }
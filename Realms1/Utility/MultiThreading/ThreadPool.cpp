@@ -0,0 +1,233 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace rlms;
+
+namespace {
+	//Above 0 while the thread may run alongside others
+	thread_local size_t t_parallel_depth = 0;
+
+	struct ParallelScope {
+		ParallelScope () { t_parallel_depth++; }
+		~ParallelScope () { t_parallel_depth--; }
+	};
+}
+
+class rlms::ThreadPoolImpl : public ILogged {
+private:
+	friend class ThreadPool;
+
+	std::string getLogName () override {
+		return "ThreadPool";
+	}
+
+	//Ranges handed out per thread taking part, so uneven ranges still balance
+	static const size_t RANGES_PER_THREAD = 4;
+
+	std::vector<std::thread> _workers;
+	std::deque<std::function<void ()>> _tasks;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	bool _stopping;
+
+	bool start (size_t worker_count, std::shared_ptr<Logger> funnel);
+	void stop ();
+
+	void submit (std::function<void ()>&& task);
+	void parallelFor (size_t count, size_t grain, std::function<void (size_t, size_t)> const& f);
+
+	void work ();
+	//Runs one queued task on the calling thread, false if there was none
+	bool runOne ();
+
+public:
+	ThreadPoolImpl ();
+	~ThreadPoolImpl ();
+};
+
+std::unique_ptr<ThreadPoolImpl> ThreadPool::instance;
+
+std::shared_ptr<LoggerHandler> ThreadPool::GetLogger () {
+	return instance->getLogger ();
+}
+
+bool ThreadPool::Initialize (size_t worker_count, std::shared_ptr<Logger> funnel) {
+	instance = std::make_unique<ThreadPoolImpl> ();
+	return instance->start (worker_count, funnel);
+}
+
+void ThreadPool::Terminate () {
+	if (instance) {
+		instance->stop ();
+		instance.reset ();
+	}
+}
+
+size_t ThreadPool::GetWorkerCount () {
+	return instance ? instance->_workers.size () : 0;
+}
+
+void ThreadPool::Submit (std::function<void ()> task) {
+	if (instance && !instance->_workers.empty ()) {
+		instance->submit (std::move (task));
+	}
+	else {
+		task ();
+	}
+}
+
+void ThreadPool::ParallelFor (size_t count, size_t grain, std::function<void (size_t, size_t)> const& f) {
+	if (count == 0) return;
+
+	ParallelScope scope;
+	if (instance && !instance->_workers.empty ()) {
+		instance->parallelFor (count, grain, f);
+	}
+	else {
+		f (0, count);
+	}
+}
+
+bool ThreadPool::InParallel () {
+	return t_parallel_depth > 0;
+}
+
+//////
+
+const size_t ThreadPoolImpl::RANGES_PER_THREAD;
+
+ThreadPoolImpl::ThreadPoolImpl () : _workers (), _tasks (), _mutex (), _condition (), _stopping (false) {}
+
+ThreadPoolImpl::~ThreadPoolImpl () {
+	stop ();
+}
+
+bool ThreadPoolImpl::start (size_t worker_count, std::shared_ptr<Logger> funnel) {
+	startLogger (funnel);
+	logger->tag (LogTags::None) << "Initializing !" << '\n';
+
+	if (worker_count == 0) {
+		unsigned int hardware = std::thread::hardware_concurrency ();
+		worker_count = hardware > 1 ? hardware - 1 : 0;
+	}
+
+	_stopping = false;
+	for (size_t i = 0; i < worker_count; i++) {
+		_workers.emplace_back (&ThreadPoolImpl::work, this);
+	}
+
+	logger->tag (LogTags::None) << "Initialized correctly with " << worker_count << " workers !" << '\n';
+	return true;
+}
+
+void ThreadPoolImpl::stop () {
+	if (_workers.empty ()) return;
+
+	{
+		std::lock_guard<std::mutex> lock (_mutex);
+		_stopping = true;
+	}
+	_condition.notify_all ();
+
+	//Workers drain the queue before leaving
+	for (auto it = _workers.begin (); it != _workers.end (); it++) {
+		it->join ();
+	}
+	_workers.clear ();
+
+	logger->tag (LogTags::None) << "Stopped correctly !" << '\n';
+}
+
+void ThreadPoolImpl::submit (std::function<void ()>&& task) {
+	{
+		std::lock_guard<std::mutex> lock (_mutex);
+		_tasks.push_back (std::move (task));
+	}
+	_condition.notify_one ();
+}
+
+void ThreadPoolImpl::parallelFor (size_t count, size_t grain, std::function<void (size_t, size_t)> const& f) {
+	grain = grain > 0 ? grain : 1;
+
+	size_t max_ranges = (_workers.size () + 1) * RANGES_PER_THREAD;
+	size_t range_count = std::min ((count + grain - 1) / grain, max_ranges);
+	size_t range_size = (count + range_count - 1) / range_count;
+	range_count = (count + range_size - 1) / range_size;
+
+	if (range_count == 1) {
+		f (0, count);
+		return;
+	}
+
+	std::atomic<size_t> next_range (0);
+	std::atomic<size_t> done_ranges (0);
+	std::atomic<size_t> helpers (0);
+
+	auto take_ranges = [&]() {
+		for (size_t range = next_range++; range < range_count; range = next_range++) {
+			f (range * range_size, std::min (count, (range + 1) * range_size));
+			done_ranges++;
+		}
+	};
+
+	//The helpers capture this frame, so it is only left once all of them ran
+	size_t helper_count = std::min (_workers.size (), range_count - 1);
+	helpers = helper_count;
+	for (size_t i = 0; i < helper_count; i++) {
+		submit ([&]() {
+			take_ranges ();
+			helpers--;
+		});
+	}
+
+	take_ranges ();
+
+	//Helpers still queued behind other tasks are run here rather than waited for
+	while (done_ranges < range_count || helpers > 0) {
+		if (!runOne ()) {
+			std::this_thread::yield ();
+		}
+	}
+}
+
+void ThreadPoolImpl::work () {
+	ParallelScope scope;
+
+	for (;;) {
+		std::function<void ()> task;
+
+		{
+			std::unique_lock<std::mutex> lock (_mutex);
+			_condition.wait (lock, [this]() { return _stopping || !_tasks.empty (); });
+
+			if (_tasks.empty ()) return;
+
+			task = std::move (_tasks.front ());
+			_tasks.pop_front ();
+		}
+
+		task ();
+	}
+}
+
+bool ThreadPoolImpl::runOne () {
+	std::function<void ()> task;
+
+	{
+		std::lock_guard<std::mutex> lock (_mutex);
+		if (_tasks.empty ()) return false;
+
+		task = std::move (_tasks.front ());
+		_tasks.pop_front ();
+	}
+
+	task ();
+	return true;
+}
@@ -1,22 +1,35 @@
 #pragma once
 #include <string>
 #include <memory>
+#include <functional>
 
-//#include "../../Base/Logging/LoggerHandler.h"
+#include "../../Base/Logging/ILogged.h"
 //#include "../../Base/RlmsException.h"
 
 namespace rlms {
 
 	class ThreadPoolImpl;
 
+	//Worker threads shared by the engine, calls run on the calling thread while it isn't initialized
 	class ThreadPool {
 	private:
 		static std::unique_ptr<ThreadPoolImpl> instance;
 
+	public:
 		static std::shared_ptr<LoggerHandler> GetLogger ();
-		static bool Initialize (std::shared_ptr<Logger> funnel = nullptr);
+		//worker_count 0 starts one worker per hardware thread, minus the calling one
+		static bool Initialize (size_t worker_count = 0, std::shared_ptr<Logger> funnel = nullptr);
 		static void Terminate ();
 
+		static size_t GetWorkerCount ();
+
+		static void Submit (std::function<void ()> task);
+
+		//Calls f (begin, end) on ranges of [0, count) at least grain long, the calling thread takes ranges too
+		//Returns once every range is done
+		static void ParallelFor (size_t count, size_t grain, std::function<void (size_t, size_t)> const& f);
+
+		//True on the workers, and on the calling thread while it runs a ParallelFor, even without workers
+		static bool InParallel ();
 	};
 }
-
@@ -33,3 +33,31 @@
 #ifndef RLMS_DEBUG
 #define RLMS_DEBUG_BOOL false
 #endif // RLMS_DEBUG
+
+// Allocator telemetry (peaks, size histogram, tags), define RLMS_NO_ALLOCATOR_STATS to compile it out
+// _DEBUG as RLMS_DEBUG is also defined with NDEBUG, release builds don't pay for the locked registry
+#if defined _DEBUG && !defined RLMS_NO_ALLOCATOR_STATS
+#define RLMS_ALLOCATOR_STATS
+#endif // RLMS_ALLOCATOR_STATS
+
+// Allocator guards (canaries, poison-on-free, double free and foreign pointer checks), debug builds only
+// _DEBUG rather than RLMS_DEBUG so release builds stay exactly the plain allocators
+#if defined _DEBUG && !defined RLMS_NO_ALLOCATOR_GUARDS
+#define RLMS_ALLOCATOR_GUARDS
+#endif // RLMS_ALLOCATOR_GUARDS
+
+// Per system tick timings and budget warnings, define RLMS_NO_SYSTEM_PROFILER to compile them out
+// Debug builds only, _DEBUG for the same reason as the allocator stats
+#if defined _DEBUG && !defined RLMS_NO_SYSTEM_PROFILER
+#define RLMS_SYSTEM_PROFILER
+#endif // RLMS_SYSTEM_PROFILER
+
+// Lowest log level compiled in (0 Debug, 1 Dev, 2 Info, 3 Warning, 4 Error) for the RLMS_LOG calls
+// Lower levels never evaluate their arguments, define it in the project settings to override
+#ifndef RLMS_LOG_LEVEL
+#ifdef _DEBUG
+#define RLMS_LOG_LEVEL 0
+#else
+#define RLMS_LOG_LEVEL 2
+#endif
+#endif // RLMS_LOG_LEVEL
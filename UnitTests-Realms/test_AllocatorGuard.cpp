@@ -0,0 +1,131 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include "Base/Allocators/StackAllocator.h"
+#include "Base/Allocators/FreeListAllocator.h"
+#include "Base/Allocators/PoolAllocator.h"
+
+#ifdef RLMS_ALLOCATOR_GUARDS
+class TestAllocatorGuard : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t large_size = data_obj_size * 64;
+	static void* large_mem;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestAllocatorGuard::large_mem;
+
+TEST_F (TestAllocatorGuard, poison) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator alloc (large_mem, large_size);
+	data_obj* a = allocator::allocateNew<data_obj> (alloc);
+	ASSERT_NE (nullptr, a);
+	unsigned char* bytes = reinterpret_cast<unsigned char*>(a);
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		for (size_t i = 0; i < data_obj_size; i++) {
+			ASSERT_EQ (allocatorGuard::POISON_BYTE, bytes[i]);
+		}
+	}
+}
+
+TEST_F (TestAllocatorGuard, alignment) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator alloc (large_mem, large_size);
+	for (uint8_t alignment = 1; alignment <= 64; alignment *= 2) {
+		SCOPED_TRACE (alignment);
+		void* p = alloc.allocate (data_obj_size, alignment);
+		ASSERT_NE (nullptr, p);
+		ASSERT_TRUE (pointerMath::isAligned (p, alignment));
+		alloc.deallocate (std::move (p));
+	}
+	ASSERT_EQ (0, alloc.getUsedMemory ());
+}
+
+TEST_F (TestAllocatorGuard, overrun) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator alloc (large_mem, large_size);
+	unsigned char* p = static_cast<unsigned char*>(alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT));
+	p[data_obj_size] = 0;
+
+	ASSERT_DEATH (alloc.deallocate (p), "Back canary");
+}
+
+TEST_F (TestAllocatorGuard, underrun) {
+	ASSERT_NE (nullptr, large_mem);
+
+	StackAllocator alloc (large_mem, large_size);
+	unsigned char* p = static_cast<unsigned char*>(alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT));
+	p[-1] = 0;
+
+	ASSERT_DEATH (alloc.deallocate (p), "Front canary");
+}
+
+TEST_F (TestAllocatorGuard, doubleFree) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator alloc (large_mem, large_size);
+	void* keep = alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT);
+	void* p = alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT);
+	void* copy = p;
+	alloc.deallocate (std::move (p));
+
+	ASSERT_DEATH (alloc.deallocate (std::move (copy)), "Double free");
+	alloc.deallocate (std::move (keep));
+}
+
+TEST_F (TestAllocatorGuard, poolForeignPointer) {
+	ASSERT_NE (nullptr, large_mem);
+
+	PoolAllocator alloc (data_obj_size, __alignof(data_obj), large_size, large_mem);
+	data_obj outside;
+
+	ASSERT_DEATH (alloc.deallocate (&outside), "not from this allocator");
+}
+
+TEST_F (TestAllocatorGuard, poolDoubleFree) {
+	ASSERT_NE (nullptr, large_mem);
+
+	PoolAllocator alloc (data_obj_size, __alignof(data_obj), large_size, large_mem);
+	data_obj* a = allocator::allocateNew<data_obj> (alloc);
+	void* copy = a;
+	allocator::deallocateDelete<data_obj> (alloc, a);
+
+	ASSERT_DEATH (alloc.deallocate (std::move (copy)), "Double free");
+}
+
+TEST_F (TestAllocatorGuard, arrayHeader) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator alloc (large_mem, large_size);
+	data_obj* a = allocator::allocateArray<data_obj> (alloc, 4);
+	ASSERT_NE (nullptr, a);
+	allocator::deallocateArray<data_obj> (alloc, a);
+
+	data_obj* b = allocator::allocateArray<data_obj> (alloc, 4);
+	reinterpret_cast<size_t*>(b)[-2] = 0;
+
+	ASSERT_DEATH (allocator::deallocateArray<data_obj> (alloc, b), "Array header overwritten");
+}
+#endif
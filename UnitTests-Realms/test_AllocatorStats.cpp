@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include "Base/Allocators/LinearAllocator.h"
+#include "Base/Allocators/FreeListAllocator.h"
+
+class TestAllocatorStats : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t large_size = data_obj_size * 64;
+	static void* large_mem;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestAllocatorStats::large_mem;
+
+TEST_F (TestAllocatorStats, tag) {
+	ASSERT_NE (nullptr, large_mem);
+
+	LinearAllocator alloc (large_mem, large_size);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (AllocTag::Untagged, alloc.getTag ());
+	}
+
+	alloc.setTag (AllocTag::Event);
+	{
+		SCOPED_TRACE ("Set");
+		ASSERT_EQ (AllocTag::Event, alloc.getTag ());
+	}
+}
+
+TEST_F (TestAllocatorStats, fragmentation) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator alloc (large_mem, large_size);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_FLOAT_EQ (0.f, alloc.getFragmentation ());
+	}
+
+	//Free every other block, the holes can't merge
+	void* blocks[8];
+	for (void*& p : blocks) {
+		p = alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT);
+		ASSERT_NE (nullptr, p);
+	}
+	for (size_t i = 0; i < 8; i += 2) {
+		alloc.deallocate (std::move (blocks[i]));
+	}
+	{
+		SCOPED_TRACE ("Holes");
+		ASSERT_LT (alloc.getLargestFreeBlock (), alloc.getSize () - alloc.getUsedMemory ());
+		ASSERT_LT (0.f, alloc.getFragmentation ());
+	}
+
+	for (size_t i = 1; i < 8; i += 2) {
+		alloc.deallocate (std::move (blocks[i]));
+	}
+	{
+		SCOPED_TRACE ("Merged");
+		ASSERT_FLOAT_EQ (0.f, alloc.getFragmentation ());
+	}
+}
+
+#ifdef RLMS_ALLOCATOR_STATS
+TEST_F (TestAllocatorStats, peak) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator alloc (large_mem, large_size);
+	void* a = alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT);
+	void* b = alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT);
+	size_t peak = alloc.getUsedMemory ();
+
+	alloc.deallocate (std::move (a));
+	alloc.deallocate (std::move (b));
+	{
+		SCOPED_TRACE ("Freed");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+		ASSERT_EQ (peak, alloc.getStats ().peak_used_memory);
+		ASSERT_EQ (2, alloc.getStats ().peak_num_allocations);
+		ASSERT_EQ (2, alloc.getStats ().total_allocations);
+	}
+
+	alloc.resetStats ();
+	{
+		SCOPED_TRACE ("Reset");
+		ASSERT_EQ (0, alloc.getStats ().peak_used_memory);
+	}
+}
+
+TEST_F (TestAllocatorStats, histogram) {
+	ASSERT_NE (nullptr, large_mem);
+
+	LinearAllocator alloc (large_mem, large_size);
+	alloc.allocate (1, 1);
+	alloc.allocate (16, DEFAULT_ALIGNMENT);
+	alloc.allocate (31, DEFAULT_ALIGNMENT);
+
+	const AllocatorStats& stats = alloc.getStats ();
+	ASSERT_EQ (1, stats.histogram[AllocatorStats::bucketOf (1)]);
+	ASSERT_EQ (2, stats.histogram[AllocatorStats::bucketOf (16)]);
+	ASSERT_EQ (AllocatorStats::bucketOf (16), AllocatorStats::bucketOf (31));
+	ASSERT_EQ (AllocatorStats::HISTOGRAM_BUCKETS - 1, AllocatorStats::bucketOf (SIZE_MAX));
+}
+
+TEST_F (TestAllocatorStats, registry) {
+	ASSERT_NE (nullptr, large_mem);
+
+	LinearAllocator alloc (large_mem, large_size);
+	alloc.setTag (AllocTag::Chunk);
+
+	size_t found = 0;
+	Allocator::ForEach ([&found, &alloc] (const Allocator& a) {
+		if (&a == &alloc) found++;
+	});
+	ASSERT_EQ (1, found);
+}
+#endif
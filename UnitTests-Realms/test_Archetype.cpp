@@ -0,0 +1,144 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include <algorithm>
+
+#include "Base/Allocators/FreeListAllocator.h"
+#include "Module/ECS/Archetype.h"
+#include "Module/ECS/Entity.h"
+
+class TestArchetype : public ::testing::Test {
+protected:
+
+	struct position {
+		rlms::ENTITY_ID owner;
+		float x;
+	};
+
+	struct velocity {
+		rlms::ENTITY_ID owner;
+	};
+
+	static constexpr size_t arena_size = 1024 * 1024;
+	static void* arena_mem;
+
+	virtual void SetUp () {
+		arena_mem = malloc (arena_size);
+	}
+
+	virtual void TearDown () {
+		free (arena_mem);
+	}
+
+	static rlms::Archetype* make (FreeListAllocator& arena) {
+		const rlms::ComponentType* types[] = { rlms::ComponentType::of<position> (), rlms::ComponentType::of<velocity> () };
+		std::sort (types, types + 2, [](const rlms::ComponentType* a, const rlms::ComponentType* b) { return a->id < b->id; });
+		return allocator::allocateNew<rlms::Archetype> (arena, &arena, types, 2);
+	}
+
+	static void push (rlms::Archetype& archetype, rlms::ENTITY_ID e_id) {
+		uint32_t row = archetype.pushRow (e_id);
+		new (archetype.get (row, rlms::ComponentType::of<position> ()->id)) position{ e_id, static_cast<float>(e_id) };
+		new (archetype.get (row, rlms::ComponentType::of<velocity> ()->id)) velocity{ e_id };
+	}
+
+	static rlms::ENTITY_ID pop (rlms::Archetype& archetype, uint32_t row) {
+		archetype.destroyRow (row);
+		return archetype.removeRow (row);
+	}
+};
+
+void* TestArchetype::arena_mem;
+
+TEST_F (TestArchetype, removeRowMovesLast) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	rlms::Archetype* archetype = make (arena);
+
+	push (*archetype, 1);
+	push (*archetype, 2);
+	push (*archetype, 3);
+
+	rlms::ENTITY_ID moved = pop (*archetype, 0);
+	{
+		SCOPED_TRACE ("Last row moved in the hole");
+		ASSERT_EQ (3, moved);
+		ASSERT_EQ (2, archetype->getCount ());
+		ASSERT_EQ (3, archetype->getEntity (0));
+		ASSERT_EQ (3, static_cast<position*>(archetype->get (0, rlms::ComponentType::of<position> ()->id))->owner);
+		ASSERT_EQ (3.f, static_cast<position*>(archetype->get (0, rlms::ComponentType::of<position> ()->id))->x);
+		ASSERT_EQ (3, static_cast<velocity*>(archetype->get (0, rlms::ComponentType::of<velocity> ()->id))->owner);
+		ASSERT_EQ (2, archetype->getEntity (1));
+	}
+
+	moved = pop (*archetype, 1);
+	{
+		SCOPED_TRACE ("Last row removed, nothing moved");
+		ASSERT_EQ (rlms::Entity::NULL_ID, moved);
+		ASSERT_EQ (1, archetype->getCount ());
+		ASSERT_EQ (3, archetype->getEntity (0));
+	}
+
+	allocator::deallocateDelete (arena, archetype);
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
+
+TEST_F (TestArchetype, chunkSpillAndRelease) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	rlms::Archetype* archetype = make (arena);
+
+	rlms::ENTITY_ID next = 1;
+	push (*archetype, next++);
+	size_t one_chunk_memory = arena.getUsedMemory ();
+
+	//Fill the first chunk, the next row spills
+	while (archetype->getChunkCount () < 2) {
+		push (*archetype, next++);
+	}
+	const size_t rows_per_chunk = archetype->getCount () - 1;
+	{
+		SCOPED_TRACE ("Spilled");
+		ASSERT_EQ (rows_per_chunk, archetype->getChunkRows (0));
+		ASSERT_EQ (1, archetype->getChunkRows (1));
+		ASSERT_LE (one_chunk_memory + rlms::Archetype::CHUNK_SIZE, arena.getUsedMemory ());
+	}
+
+	//Third chunk started
+	while (archetype->getCount () < 2 * rows_per_chunk + 1) {
+		push (*archetype, next++);
+	}
+	size_t three_chunks_memory = arena.getUsedMemory ();
+	ASSERT_EQ (3, archetype->getChunkCount ());
+
+	//Back to two full chunks, the emptied one is kept as a spare
+	pop (*archetype, 0);
+	{
+		SCOPED_TRACE ("Spare chunk kept");
+		ASSERT_EQ (2, archetype->getChunkCount ());
+		ASSERT_EQ (0, archetype->getChunkRows (2));
+		ASSERT_EQ (three_chunks_memory, arena.getUsedMemory ());
+	}
+
+	//Two chunks past the rows, the spare is given back
+	while (archetype->getCount () > rows_per_chunk) {
+		pop (*archetype, 0);
+	}
+	{
+		SCOPED_TRACE ("Released");
+		ASSERT_EQ (1, archetype->getChunkCount ());
+		ASSERT_EQ (rows_per_chunk, archetype->getChunkRows (0));
+		ASSERT_LE (arena.getUsedMemory () + rlms::Archetype::CHUNK_SIZE, three_chunks_memory);
+	}
+
+	//Rows moved around keep their own components
+	for (uint32_t row = 0; row < archetype->getCount (); row++) {
+		rlms::ENTITY_ID e_id = archetype->getEntity (row);
+		ASSERT_EQ (e_id, static_cast<position*>(archetype->get (row, rlms::ComponentType::of<position> ()->id))->owner);
+		ASSERT_EQ (e_id, static_cast<velocity*>(archetype->get (row, rlms::ComponentType::of<velocity> ()->id))->owner);
+	}
+
+	while (archetype->getCount () > 0) {
+		pop (*archetype, 0);
+	}
+	allocator::deallocateDelete (arena, archetype);
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
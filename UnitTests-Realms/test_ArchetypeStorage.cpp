@@ -0,0 +1,204 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include <atomic>
+#include <vector>
+
+#include "Base/Allocators/FreeListAllocator.h"
+#include "Module/ECS/ArchetypeStorage.h"
+
+class TestArchetypeStorage : public ::testing::Test {
+protected:
+
+	//Each keeps the entity it was added to
+	struct position {
+		rlms::ENTITY_ID owner;
+	};
+
+	struct velocity {
+		rlms::ENTITY_ID owner;
+	};
+
+	struct health {
+		rlms::ENTITY_ID owner;
+	};
+
+	struct marker {
+		rlms::ENTITY_ID owner;
+	};
+
+	using ids = rlms::IdTable<rlms::ENTITY_ID>;
+
+	static constexpr size_t arena_size = 4 * 1024 * 1024;
+	static void* arena_mem;
+
+	virtual void SetUp () {
+		arena_mem = malloc (arena_size);
+	}
+
+	virtual void TearDown () {
+		free (arena_mem);
+	}
+};
+
+void* TestArchetypeStorage::arena_mem;
+
+TEST_F (TestArchetypeStorage, moveFixesLocations) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	{
+		rlms::ArchetypeStorage storage (&arena);
+
+		for (rlms::ENTITY_ID e = 1; e <= 4; e++) {
+			storage.add<position> (e, e);
+		}
+
+		//1 leaves the first row, 4 takes its place
+		storage.add<velocity> (1, 1u);
+		{
+			SCOPED_TRACE ("Added");
+			for (rlms::ENTITY_ID e = 1; e <= 4; e++) {
+				ASSERT_TRUE (storage.has<position> (e));
+				ASSERT_EQ (e, storage.get<position> (e)->owner);
+			}
+			ASSERT_TRUE (storage.has<velocity> (1));
+			ASSERT_EQ (1, storage.get<velocity> (1)->owner);
+			ASSERT_FALSE (storage.has<velocity> (4));
+		}
+
+		//Last component, the entity is dropped and 3 takes the row of 2
+		storage.remove<position> (2);
+		{
+			SCOPED_TRACE ("Removed");
+			ASSERT_FALSE (storage.has<position> (2));
+			ASSERT_EQ (nullptr, storage.get<position> (2));
+			ASSERT_EQ (3, storage.get<position> (3)->owner);
+			ASSERT_EQ (4, storage.get<position> (4)->owner);
+		}
+
+		//Back to the first archetype
+		storage.remove<velocity> (1);
+		storage.destroy (3);
+		{
+			SCOPED_TRACE ("Moved back");
+			ASSERT_FALSE (storage.has<velocity> (1));
+			ASSERT_EQ (1, storage.get<position> (1)->owner);
+			ASSERT_FALSE (storage.has<position> (3));
+			ASSERT_EQ (4, storage.get<position> (4)->owner);
+			ASSERT_EQ (2, storage.view<position> ().size ());
+		}
+	}
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
+
+TEST_F (TestArchetypeStorage, staleIdsIgnored) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	{
+		rlms::ArchetypeStorage storage (&arena);
+
+		//Same slot, the second after the first was destroyed
+		const rlms::ENTITY_ID old_id = (1 << ids::INDEX_BITS) | 5;
+		const rlms::ENTITY_ID new_id = (2 << ids::INDEX_BITS) | 5;
+
+		storage.add<position> (old_id, old_id);
+		storage.destroy (old_id);
+		storage.add<position> (new_id, new_id);
+		storage.add<position> (7, 7u);
+		{
+			SCOPED_TRACE ("Stale lookups");
+			ASSERT_FALSE (storage.has<position> (old_id));
+			ASSERT_EQ (nullptr, storage.get<position> (old_id));
+			ASSERT_EQ (new_id, storage.get<position> (new_id)->owner);
+		}
+
+		//Must not drop what the slot holds now
+		storage.destroy (old_id);
+		storage.remove<position> (old_id);
+		{
+			SCOPED_TRACE ("Stale changes ignored");
+			ASSERT_TRUE (storage.has<position> (new_id));
+			ASSERT_EQ (new_id, storage.get<position> (new_id)->owner);
+			ASSERT_EQ (7, storage.get<position> (7)->owner);
+		}
+	}
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
+
+TEST_F (TestArchetypeStorage, viewSeesNewArchetypes) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	{
+		rlms::ArchetypeStorage storage (&arena);
+		rlms::View<position, velocity> view = storage.view<position, velocity> ();
+		ASSERT_EQ (0, view.size ());
+
+		for (rlms::ENTITY_ID e = 1; e <= 30; e++) {
+			storage.add<position> (e, e);
+			if (e % 2 == 0) storage.add<velocity> (e, e);
+			if (e % 3 == 0) storage.add<health> (e, e);
+		}
+
+		size_t count = 0;
+		view.each ([&count](rlms::ENTITY_ID e, position& p, velocity& v) {
+			ASSERT_EQ (0, e % 2);
+			ASSERT_EQ (e, p.owner);
+			ASSERT_EQ (e, v.owner);
+			count++;
+		});
+		{
+			SCOPED_TRACE ("Created before its archetypes");
+			ASSERT_EQ (15, count);
+			ASSERT_EQ (15, view.size ());
+		}
+	}
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
+
+TEST_F (TestArchetypeStorage, parallelEachChunkNumbering) {
+	rlms::ThreadPool::Initialize (3);
+
+	FreeListAllocator arena (arena_mem, arena_size);
+	{
+		rlms::ArchetypeStorage storage (&arena);
+
+		//Several chunks per archetype, uneven, with an emptied archetype in between
+		const rlms::ENTITY_ID only_position = 5000;
+		const rlms::ENTITY_ID with_velocity = 5100;
+		const rlms::ENTITY_ID with_health = 9200;
+
+		rlms::ENTITY_ID e = 1;
+		for (; e <= only_position; e++) {
+			storage.add<position> (e, e);
+		}
+		for (; e <= with_velocity; e++) {
+			storage.add<position> (e, e);
+			storage.add<velocity> (e, e);
+		}
+		storage.add<marker> (1, 1u);
+		storage.remove<marker> (1);
+		for (; e <= with_health; e++) {
+			storage.add<position> (e, e);
+			storage.add<health> (e, e);
+		}
+
+		std::vector<std::atomic<int>> visits (with_health + 1);
+		for (auto it = visits.begin (); it != visits.end (); it++) {
+			*it = 0;
+		}
+		std::atomic<int> wrong (0);
+
+		storage.view<position> ().parallelEach ([&visits, &wrong](rlms::ENTITY_ID e, position& p) {
+			if (p.owner != e) wrong++;
+			visits[e]++;
+		});
+		{
+			SCOPED_TRACE ("Each entity once");
+			ASSERT_EQ (0, wrong);
+			ASSERT_EQ (0, visits[0]);
+			for (rlms::ENTITY_ID e = 1; e <= with_health; e++) {
+				ASSERT_EQ (1, visits[e]) << "entity " << e;
+			}
+		}
+	}
+	ASSERT_EQ (0, arena.getUsedMemory ());
+
+	rlms::ThreadPool::Terminate ();
+}
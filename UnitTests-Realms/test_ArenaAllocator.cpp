@@ -0,0 +1,132 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include <string>
+
+#include "Base/Allocators/TLSFAllocator.h"
+#include "Base/Allocators/ArenaAllocator.h"
+
+class TestArenaAllocator : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t large_size = data_obj_size * 1024;
+	static void* large_mem;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestArenaAllocator::large_mem;
+
+TEST_F (TestArenaAllocator, vector) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator arena (large_mem, large_size);
+	{
+		rlms::ArenaVector<data_obj> vec ((rlms::ArenaAllocator<data_obj> (&arena)));
+		for (size_t i = 0; i < 64; i++) {
+			vec.push_back (data_obj ());
+		}
+		{
+			SCOPED_TRACE ("Filled");
+			ASSERT_EQ (&arena, vec.get_allocator ().arena ());
+			ASSERT_LT (64 * data_obj_size, arena.getUsedMemory ());
+			ASSERT_EQ (32Ui64, vec[63].data);
+		}
+
+		//Copies keep the arena
+		rlms::ArenaVector<data_obj> copy = vec;
+		{
+			SCOPED_TRACE ("Copy");
+			ASSERT_EQ (&arena, copy.get_allocator ().arena ());
+			ASSERT_EQ (2, arena.getNumAllocations ());
+		}
+	}
+
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
+
+TEST_F (TestArenaAllocator, map) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator arena (large_mem, large_size);
+	{
+		rlms::ArenaMap<int, data_obj> map ((rlms::ArenaAllocator<std::pair<const int, data_obj>> (&arena)));
+		for (int i = 0; i < 16; i++) {
+			map[i] = data_obj ();
+		}
+		{
+			SCOPED_TRACE ("Filled");
+			ASSERT_EQ (16, arena.getNumAllocations ());
+		}
+
+		map.erase (0);
+		{
+			SCOPED_TRACE ("Erase");
+			ASSERT_EQ (15, arena.getNumAllocations ());
+		}
+	}
+
+	ASSERT_EQ (0, arena.getNumAllocations ());
+}
+
+TEST_F (TestArenaAllocator, defaultArena) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator arena (large_mem, large_size);
+	{
+		SCOPED_TRACE ("Heap");
+		rlms::ArenaVector<int> vec;
+		ASSERT_EQ (nullptr, vec.get_allocator ().arena ());
+		vec.push_back (1);
+		ASSERT_EQ (0, arena.getNumAllocations ());
+	}
+
+	{
+		rlms::ArenaScope scope (&arena);
+		rlms::ArenaVector<int> vec;
+		vec.push_back (1);
+		{
+			SCOPED_TRACE ("Scoped");
+			ASSERT_EQ (&arena, rlms::GetDefaultArena ());
+			ASSERT_EQ (1, arena.getNumAllocations ());
+		}
+	}
+
+	ASSERT_EQ (nullptr, rlms::GetDefaultArena ());
+	ASSERT_EQ (0, arena.getNumAllocations ());
+}
+
+TEST_F (TestArenaAllocator, rebind) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator arena (large_mem, large_size);
+	rlms::ArenaAllocator<data_obj> objs (&arena);
+	rlms::ArenaAllocator<int> ints (objs);
+
+	ASSERT_EQ (&arena, ints.arena ());
+	ASSERT_TRUE (objs == ints);
+	ASSERT_FALSE (objs != ints);
+}
+
+TEST_F (TestArenaAllocator, exhausted) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator arena (large_mem, large_size);
+	rlms::ArenaVector<data_obj> vec ((rlms::ArenaAllocator<data_obj> (&arena)));
+
+	ASSERT_THROW (vec.reserve (large_size), std::bad_alloc);
+}
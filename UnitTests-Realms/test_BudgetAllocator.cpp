@@ -0,0 +1,195 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include "Base/Allocators/FreeListAllocator.h"
+#include "Base/Allocators/VirtualArena.h"
+#include "Base/Allocators/TLSFAllocator.h"
+#include "Base/Allocators/ThreadCacheAllocator.h"
+#include "Base/Allocators/BudgetAllocator.h"
+#include "Base/Allocators/BudgetAllocator.cpp"
+
+#include <vector>
+
+class TestBudgetAllocator : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t large_size = 4096;
+	static void* large_mem;
+
+	static constexpr size_t small_size = 256;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestBudgetAllocator::large_mem;
+
+TEST_F (TestBudgetAllocator, reportsArenaUsage) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator arena (large_mem, large_size);
+	BudgetAllocator root ("Root", &arena, large_size);
+
+	data_obj* a = allocator::allocateNew<data_obj> (root);
+	{
+		SCOPED_TRACE ("Allocate");
+		ASSERT_NE (nullptr, a);
+		ASSERT_EQ (arena.getUsedMemory (), root.getUsedMemory ());
+		ASSERT_EQ (1, root.getNumAllocations ());
+		ASSERT_EQ (large_size - root.getUsedMemory (), root.getFreeMemory ());
+	}
+
+	size_t peak = root.getUsedMemory ();
+	allocator::deallocateDelete (root, a);
+	{
+		SCOPED_TRACE ("Deallocate");
+		ASSERT_EQ (0, root.getUsedMemory ());
+		ASSERT_EQ (peak, root.getPeakMemory ());
+	}
+}
+
+TEST_F (TestBudgetAllocator, enforcesLimit) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator arena (large_mem, large_size);
+	BudgetAllocator root ("Root", &arena, large_size);
+
+	void* pool = root.allocate (small_size);
+	FreeListAllocator child_arena (pool, small_size);
+	BudgetAllocator child ("Child", &child_arena, small_size, &root);
+
+	{
+		SCOPED_TRACE ("Child carved from the root");
+		ASSERT_EQ (&root, child.getParent ());
+		ASSERT_LE (small_size, root.getUsedMemory ());
+	}
+
+	{
+		SCOPED_TRACE ("Over the limit without overflow");
+		ASSERT_EQ (nullptr, child.allocate (2 * small_size));
+		ASSERT_EQ (0, child.getOverflowMemory ());
+	}
+
+	root.deallocate (std::move (pool));
+}
+
+TEST_F (TestBudgetAllocator, overflowToParent) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator arena (large_mem, large_size);
+	BudgetAllocator root ("Root", &arena, large_size);
+
+	void* pool = root.allocate (small_size);
+	FreeListAllocator child_arena (pool, small_size);
+	BudgetAllocator child ("Child", &child_arena, small_size, &root, true);
+
+	size_t root_used = root.getUsedMemory ();
+	void* p = child.allocate (2 * small_size, 16);
+	{
+		SCOPED_TRACE ("Served by the parent");
+		ASSERT_NE (nullptr, p);
+		ASSERT_EQ (0, (uintptr_t)p % 16);
+		ASSERT_LT (0, child.getOverflowMemory ());
+		ASSERT_LT (root_used, root.getUsedMemory ());
+		ASSERT_EQ (0, child_arena.getUsedMemory ());
+		ASSERT_EQ (child.getOverflowMemory (), child.getUsedMemory ());
+	}
+
+	void* q = child.allocate (data_obj_size);
+	{
+		SCOPED_TRACE ("Still served by the arena when it fits");
+		ASSERT_NE (nullptr, q);
+		ASSERT_LT (0, child_arena.getUsedMemory ());
+	}
+
+	child.deallocate (std::move (p));
+	child.deallocate (std::move (q));
+	{
+		SCOPED_TRACE ("Given back");
+		ASSERT_EQ (0, child.getOverflowMemory ());
+		ASSERT_EQ (0, child.getUsedMemory ());
+		ASSERT_EQ (root_used, root.getUsedMemory ());
+	}
+
+	{
+		SCOPED_TRACE ("Parent limit still applies");
+		ASSERT_EQ (nullptr, child.allocate (2 * large_size));
+	}
+
+	root.deallocate (std::move (pool));
+}
+
+TEST_F (TestBudgetAllocator, tree) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FreeListAllocator arena (large_mem, large_size);
+	BudgetAllocator root ("Root", &arena, large_size);
+
+	void* pool_a = root.allocate (small_size);
+	void* pool_b = root.allocate (small_size);
+	{
+		FreeListAllocator arena_a (pool_a, small_size);
+		FreeListAllocator arena_b (pool_b, small_size);
+		BudgetAllocator a ("A", &arena_a, small_size, &root);
+		BudgetAllocator b ("B", &arena_b, small_size, &root);
+
+		size_t children = 0;
+		root.forEachChild ([&children] (const BudgetAllocator&) { children++; });
+		ASSERT_EQ (2, children);
+	}
+
+	size_t children = 0;
+	root.forEachChild ([&children] (const BudgetAllocator&) { children++; });
+	ASSERT_EQ (0, children);
+
+	root.deallocate (std::move (pool_a));
+	root.deallocate (std::move (pool_b));
+}
+
+TEST_F (TestBudgetAllocator, arenaGrowth) {
+	//Game memory layout : budget over a thread cache over a TLSF that grows in a virtual arena
+	VirtualArena virtual_arena (64 * VirtualArena::PageSize ());
+	ASSERT_NE (nullptr, virtual_arena.getStart ());
+
+	TLSFAllocator tlsf (&virtual_arena, VirtualArena::PageSize ());
+	ThreadCacheAllocator shared (&tlsf);
+	BudgetAllocator root ("Root", &shared, virtual_arena.getReservedSize ());
+
+	size_t initial_size = tlsf.getSize ();
+	std::vector<void*> blocks;
+	//Larger than the cached sizes so every block comes straight from the TLSF, until one lands past the initial size
+	void* end = pointerMath::add (tlsf.getStart (), initial_size);
+	while (blocks.empty () || blocks.back () < end) {
+		void* p = root.allocate (2 * ThreadCacheAllocator::MAX_CACHED_SIZE);
+		ASSERT_NE (nullptr, p);
+		blocks.push_back (p);
+	}
+	{
+		SCOPED_TRACE ("Grown past the initial size");
+		ASSERT_LT (initial_size, tlsf.getSize ());
+		ASSERT_EQ (tlsf.getSize (), shared.getSize ());
+	}
+
+	for (void* p : blocks) {
+		root.deallocate (std::move (p));
+	}
+	{
+		SCOPED_TRACE ("Blocks beyond the initial size given back to the arena");
+		ASSERT_EQ (0, root.getOverflowMemory ());
+		ASSERT_EQ (0, root.getNumAllocations ());
+		ASSERT_EQ (0, tlsf.getNumAllocations ());
+	}
+}
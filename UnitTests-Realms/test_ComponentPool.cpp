@@ -0,0 +1,220 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include "Base/Allocators/FreeListAllocator.h"
+#include "Module/ECS/ComponentPool.h"
+
+class TestComponentPool : public ::testing::Test {
+protected:
+
+	struct health : public rlms::IComponent {
+		int hp;
+
+		health (rlms::ENTITY_ID const& e_id, rlms::COMPONENT_ID const& c_id) : rlms::IComponent (e_id, c_id), hp (0) {}
+	};
+
+	using pool = rlms::ComponentPool<health>;
+	using ids = rlms::IdTable<int>;
+
+	static constexpr size_t arena_size = 1024 * 1024;
+	static void* arena_mem;
+
+	virtual void SetUp () {
+		arena_mem = malloc (arena_size);
+	}
+
+	virtual void TearDown () {
+		free (arena_mem);
+	}
+};
+
+void* TestComponentPool::arena_mem;
+
+TEST_F (TestComponentPool, sparseArray) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	{
+		rlms::SparseArray<uint32_t, uint32_t> array (&arena, pool::NULL_INDEX);
+
+		const uint32_t first_page = (1 << ids::INDEX_BITS) | 3;
+		const uint32_t second_page = (1 << ids::INDEX_BITS) | 1000;
+		{
+			SCOPED_TRACE ("Empty");
+			ASSERT_EQ (pool::NULL_INDEX, array.get (first_page));
+			ASSERT_EQ (0, arena.getUsedMemory ());
+		}
+
+		array.set (first_page, 7);
+		array.set (second_page, 8);
+		{
+			SCOPED_TRACE ("Set on two pages");
+			ASSERT_EQ (7, array.get (first_page));
+			ASSERT_EQ (8, array.get (second_page));
+			ASSERT_EQ (pool::NULL_INDEX, array.get (4));
+			ASSERT_EQ (pool::NULL_INDEX, array.get (500));
+		}
+
+		//Keyed by slot, the generation is left to the caller
+		{
+			SCOPED_TRACE ("Same slot");
+			ASSERT_EQ (7, array.get ((2 << ids::INDEX_BITS) | 3));
+		}
+
+		array.reset (first_page);
+		array.reset (2000);
+		{
+			SCOPED_TRACE ("Reset");
+			ASSERT_EQ (pool::NULL_INDEX, array.get (first_page));
+			ASSERT_EQ (8, array.get (second_page));
+		}
+	}
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
+
+TEST_F (TestComponentPool, addAndLookup) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	{
+		ids entities (&arena);
+		ids components (&arena);
+		pool healths (&arena);
+
+		rlms::ENTITY_ID a = entities.create (0);
+		rlms::ENTITY_ID b = entities.create (0);
+		rlms::COMPONENT_ID a_c = components.create (0);
+		rlms::COMPONENT_ID b_c = components.create (0);
+		rlms::COMPONENT_ID loose_c = components.create (0);
+
+		healths.add (a, a_c)->hp = 1;
+		healths.add (b, b_c)->hp = 2;
+		healths.add (rlms::Entity::NULL_ID, loose_c)->hp = 3;
+		{
+			SCOPED_TRACE ("By entity");
+			ASSERT_EQ (3, healths.size ());
+			ASSERT_TRUE (healths.hasEntity (a));
+			ASSERT_TRUE (healths.hasEntity (b));
+			ASSERT_EQ (1, healths.getByEntity (a)->hp);
+			ASSERT_EQ (2, healths.getByEntity (b)->hp);
+			ASSERT_FALSE (healths.hasEntity (rlms::Entity::NULL_ID));
+			ASSERT_EQ (nullptr, healths.getByEntity (rlms::Entity::NULL_ID));
+		}
+		{
+			SCOPED_TRACE ("By id");
+			ASSERT_TRUE (healths.hasId (a_c));
+			ASSERT_TRUE (healths.hasId (loose_c));
+			ASSERT_EQ (a_c, healths.getById (a_c)->id ());
+			ASSERT_EQ (a, healths.getById (a_c)->entity_id ());
+			ASSERT_EQ (3, healths.getById (loose_c)->hp);
+			ASSERT_EQ (rlms::Entity::NULL_ID, healths.getById (loose_c)->entity_id ());
+		}
+	}
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
+
+TEST_F (TestComponentPool, removeMiddleAndLast) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	{
+		ids entities (&arena);
+		ids components (&arena);
+		pool healths (&arena);
+
+		rlms::ENTITY_ID e[3];
+		rlms::COMPONENT_ID c[3];
+		for (int i = 0; i < 3; i++) {
+			e[i] = entities.create (0);
+			c[i] = components.create (0);
+			healths.add (e[i], c[i])->hp = i;
+		}
+
+		//The last one fills the hole
+		healths.remove (c[1]);
+		{
+			SCOPED_TRACE ("Middle removed");
+			ASSERT_EQ (2, healths.size ());
+			ASSERT_FALSE (healths.hasId (c[1]));
+			ASSERT_FALSE (healths.hasEntity (e[1]));
+			ASSERT_EQ (nullptr, healths.getById (c[1]));
+			ASSERT_EQ (2, healths[1].hp);
+			ASSERT_EQ (2, healths.getById (c[2])->hp);
+			ASSERT_EQ (2, healths.getByEntity (e[2])->hp);
+			ASSERT_EQ (0, healths.getByEntity (e[0])->hp);
+		}
+
+		healths.remove (c[2]);
+		{
+			SCOPED_TRACE ("Last removed");
+			ASSERT_EQ (1, healths.size ());
+			ASSERT_FALSE (healths.hasId (c[2]));
+			ASSERT_FALSE (healths.hasEntity (e[2]));
+			ASSERT_EQ (0, healths.getById (c[0])->hp);
+			ASSERT_EQ (0, healths.getByEntity (e[0])->hp);
+		}
+
+		healths.remove (c[0]);
+		healths.remove (c[0]);
+		{
+			SCOPED_TRACE ("Emptied, twice");
+			ASSERT_EQ (0, healths.size ());
+			ASSERT_EQ (healths.begin (), healths.end ());
+			ASSERT_FALSE (healths.hasEntity (e[0]));
+		}
+	}
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
+
+TEST_F (TestComponentPool, staleIdsAfterReuse) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	{
+		ids entities (&arena);
+		ids components (&arena);
+		pool healths (&arena);
+
+		rlms::ENTITY_ID old_e = entities.create (0);
+		rlms::COMPONENT_ID old_c = components.create (0);
+		healths.add (old_e, old_c)->hp = 1;
+
+		//The component is left behind by its destroyed entity, whose slot is taken again
+		entities.destroy (old_e);
+		rlms::ENTITY_ID new_e = entities.create (0);
+		rlms::COMPONENT_ID new_c = components.create (0);
+		ASSERT_EQ (ids::IndexOf (old_e), ids::IndexOf (new_e));
+		ASSERT_NE (old_e, new_e);
+
+		healths.add (new_e, new_c)->hp = 2;
+		{
+			SCOPED_TRACE ("Reused entity slot");
+			ASSERT_FALSE (healths.hasEntity (old_e));
+			ASSERT_EQ (nullptr, healths.getByEntity (old_e));
+			ASSERT_EQ (2, healths.getByEntity (new_e)->hp);
+			ASSERT_EQ (1, healths.getById (old_c)->hp);
+		}
+
+		//Must not unlink the entity now owning the slot
+		healths.remove (old_c);
+		components.destroy (old_c);
+		{
+			SCOPED_TRACE ("Left behind removed");
+			ASSERT_EQ (1, healths.size ());
+			ASSERT_EQ (2, healths.getByEntity (new_e)->hp);
+			ASSERT_EQ (2, healths.getById (new_c)->hp);
+		}
+
+		rlms::COMPONENT_ID reused_c = components.create (0);
+		ASSERT_EQ (ids::IndexOf (old_c), ids::IndexOf (reused_c));
+		healths.add (rlms::Entity::NULL_ID, reused_c)->hp = 3;
+		{
+			SCOPED_TRACE ("Reused component slot");
+			ASSERT_FALSE (healths.hasId (old_c));
+			ASSERT_EQ (nullptr, healths.getById (old_c));
+			ASSERT_EQ (3, healths.getById (reused_c)->hp);
+		}
+
+		//Stale, nothing removed
+		healths.remove (old_c);
+		{
+			SCOPED_TRACE ("Stale remove");
+			ASSERT_EQ (2, healths.size ());
+			ASSERT_TRUE (healths.hasId (reused_c));
+			ASSERT_TRUE (healths.hasId (new_c));
+		}
+	}
+	ASSERT_EQ (0, arena.getUsedMemory ());
+}
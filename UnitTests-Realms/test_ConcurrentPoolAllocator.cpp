@@ -0,0 +1,188 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "Base/Allocators/PoolAllocator.h"
+#include "Base/Allocators/PoolAllocator.cpp"
+#include "Base/Allocators/ConcurrentPoolAllocator.h"
+#include "Base/Allocators/ConcurrentPoolAllocator.cpp"
+
+class TestConcurrentPoolAllocator : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t object_count = 1024;
+	static constexpr size_t large_size = data_obj_size * object_count;
+	static void* large_mem;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestConcurrentPoolAllocator::large_mem;
+
+TEST_F (TestConcurrentPoolAllocator, getNumAllocations) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	ConcurrentPoolAllocator alloc (data_obj_size, __alignof(data_obj), large_size, large_mem);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+	}
+
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_EQ (1, alloc.getNumAllocations ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+	}
+}
+
+TEST_F (TestConcurrentPoolAllocator, getUsedMemory) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	ConcurrentPoolAllocator alloc (data_obj_size, __alignof(data_obj), large_size, large_mem);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+	}
+
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_EQ (data_obj_size, alloc.getUsedMemory ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+	}
+}
+
+TEST_F (TestConcurrentPoolAllocator, exhaustion) {
+	ASSERT_NE (nullptr, large_mem);
+
+	ConcurrentPoolAllocator alloc (data_obj_size, __alignof(data_obj), large_size, large_mem);
+
+	std::vector<void*> blocks;
+	for (size_t i = 0; i < object_count; i++) {
+		void* p = alloc.allocate (data_obj_size, __alignof(data_obj));
+		ASSERT_NE (nullptr, p);
+		blocks.push_back (p);
+	}
+	{
+		SCOPED_TRACE ("Full");
+		ASSERT_EQ (nullptr, alloc.allocate (data_obj_size, __alignof(data_obj)));
+	}
+
+	for (void*& p : blocks) {
+		alloc.deallocate (std::move (p));
+	}
+	{
+		SCOPED_TRACE ("Empty");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+	}
+}
+
+TEST_F (TestConcurrentPoolAllocator, threads) {
+	ASSERT_NE (nullptr, large_mem);
+
+	ConcurrentPoolAllocator alloc (data_obj_size, __alignof(data_obj), large_size, large_mem);
+
+	//No block may be handed to two threads at once
+	std::vector<std::thread> threads;
+	std::atomic<size_t> collisions (0);
+	for (size_t t = 0; t < 4; t++) {
+		threads.emplace_back ([&alloc, &collisions, t] () {
+			for (size_t i = 0; i < 10000; i++) {
+				data_obj* o = allocator::allocateNew<data_obj> (alloc);
+				if (o == nullptr) continue;
+				o->data = t;
+				std::this_thread::yield ();
+				if (o->data != t) collisions++;
+				allocator::deallocateDelete<data_obj> (alloc, o);
+			}
+		});
+	}
+	for (std::thread& t : threads) {
+		t.join ();
+	}
+
+	ASSERT_EQ (0, collisions.load ());
+	ASSERT_EQ (0, alloc.getNumAllocations ());
+}
+
+TEST_F (TestConcurrentPoolAllocator, exactlyOnce) {
+	ASSERT_NE (nullptr, large_mem);
+
+	ConcurrentPoolAllocator alloc (data_obj_size, __alignof(data_obj), large_size, large_mem);
+
+	//Threads drain the pool together, then give everything back for the next round
+	const size_t thread_count = 4;
+	for (size_t round = 0; round < 8; round++) {
+		std::vector<std::vector<void*>> taken (thread_count);
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < thread_count; t++) {
+			threads.emplace_back ([&alloc, &taken, t] () {
+				void* p;
+				while ((p = alloc.allocate (data_obj_size, __alignof(data_obj))) != nullptr) {
+					taken[t].push_back (p);
+				}
+			});
+		}
+		for (std::thread& t : threads) {
+			t.join ();
+		}
+
+		std::vector<void*> all;
+		for (auto& blocks : taken) {
+			all.insert (all.end (), blocks.begin (), blocks.end ());
+		}
+		std::sort (all.begin (), all.end ());
+		{
+			SCOPED_TRACE ("Every block handed out once");
+			ASSERT_EQ (object_count, all.size ());
+			ASSERT_EQ (object_count, alloc.getNumAllocations ());
+			ASSERT_TRUE (std::adjacent_find (all.begin (), all.end ()) == all.end ());
+		}
+
+		threads.clear ();
+		for (size_t t = 0; t < thread_count; t++) {
+			threads.emplace_back ([&alloc, &taken, t] () {
+				for (void*& p : taken[t]) {
+					alloc.deallocate (std::move (p));
+				}
+			});
+		}
+		for (std::thread& t : threads) {
+			t.join ();
+		}
+		{
+			SCOPED_TRACE ("All given back");
+			ASSERT_EQ (0, alloc.getNumAllocations ());
+		}
+	}
+}
@@ -0,0 +1,173 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include <thread>
+#include <vector>
+
+#include "Base/Allocators/FreeListAllocator.h"
+#include "Base/Allocators/FrameAllocator.h"
+#include "Module/ECS/EventChannel.h"
+
+class TestEventChannel : public ::testing::Test {
+protected:
+
+	struct data_event {
+		data_event (size_t p, size_t s) : producer (p), seq (s) {}
+
+		size_t producer;
+		size_t seq;
+	};
+
+	static constexpr size_t arena_size = 1024 * 1024;
+	static constexpr size_t frame_size = 1024 * 1024;
+	static void* arena_mem;
+	static void* frame_mem;
+
+	virtual void SetUp () {
+		arena_mem = malloc (arena_size);
+		frame_mem = malloc (frame_size);
+	}
+
+	virtual void TearDown () {
+		free (arena_mem);
+		free (frame_mem);
+	}
+};
+
+void* TestEventChannel::arena_mem;
+void* TestEventChannel::frame_mem;
+
+TEST_F (TestEventChannel, drainInOrder) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	FrameAllocator frame (frame_mem, frame_size);
+	rlms::EventQueue<data_event> queue (&arena, &frame);
+	rlms::EventChannel<data_event> channel (&arena, 64, &queue);
+
+	for (size_t i = 0; i < 10; i++) {
+		ASSERT_TRUE (channel.post (0, i));
+	}
+	{
+		SCOPED_TRACE ("Drained");
+		ASSERT_EQ (10, channel.drain ());
+		ASSERT_EQ (0, channel.drain ());
+	}
+
+	queue.swap ();
+	{
+		SCOPED_TRACE ("Posting order kept");
+		ASSERT_EQ (10, queue.size ());
+		for (size_t i = 0; i < 10; i++) {
+			ASSERT_EQ (i, queue.data ()[i].seq);
+		}
+	}
+}
+
+TEST_F (TestEventChannel, multipleProducers) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	FrameAllocator frame (frame_mem, frame_size);
+	rlms::EventQueue<data_event> queue (&arena, &frame);
+
+	const size_t producer_count = 4;
+	const size_t event_count = 1000;
+	rlms::EventChannel<data_event> channel (&arena, producer_count * event_count, &queue);
+
+	std::vector<std::thread> producers;
+	for (size_t p = 0; p < producer_count; p++) {
+		producers.emplace_back ([&channel, p, event_count] () {
+			for (size_t i = 0; i < event_count; i++) {
+				channel.post (p, i);
+			}
+		});
+	}
+
+	//Drain while the producers are still posting
+	size_t drained = 0;
+	for (std::thread& t : producers) {
+		drained += channel.drain ();
+		t.join ();
+	}
+	drained += channel.drain ();
+
+	queue.swap ();
+	{
+		SCOPED_TRACE ("Every event drained");
+		ASSERT_EQ (producer_count * event_count, drained);
+		ASSERT_EQ (producer_count * event_count, queue.size ());
+	}
+
+	//Each producer's events come out in the order it posted them
+	std::vector<size_t> next (producer_count, 0);
+	for (size_t i = 0; i < queue.size (); i++) {
+		const data_event& e = queue.data ()[i];
+		ASSERT_EQ (next[e.producer], e.seq);
+		next[e.producer]++;
+	}
+
+	rlms::EventChannelStats stats = channel.getStats ();
+	{
+		SCOPED_TRACE ("Stats");
+		ASSERT_EQ (producer_count * event_count, stats.posted);
+		ASSERT_EQ (producer_count * event_count, stats.drained);
+		ASSERT_EQ (0, stats.rejected);
+		ASSERT_EQ (0, stats.dropped);
+	}
+}
+
+TEST_F (TestEventChannel, backPressure) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	FrameAllocator frame (frame_mem, frame_size);
+	rlms::EventQueue<data_event> queue (&arena, &frame);
+	rlms::EventChannel<data_event> channel (&arena, 8, &queue);
+
+	for (size_t i = 0; i < 8; i++) {
+		ASSERT_TRUE (channel.post (0, i));
+	}
+	{
+		SCOPED_TRACE ("Full");
+		ASSERT_FALSE (channel.post (0, 8));
+		ASSERT_FALSE (channel.post (0, 9));
+	}
+
+	ASSERT_EQ (8, channel.drain ());
+	{
+		SCOPED_TRACE ("Room again");
+		ASSERT_TRUE (channel.post (0, 10));
+		ASSERT_EQ (1, channel.drain ());
+	}
+
+	rlms::EventChannelStats stats = channel.getStats ();
+	{
+		SCOPED_TRACE ("Stats");
+		ASSERT_EQ (8, stats.capacity);
+		ASSERT_EQ (9, stats.posted);
+		ASSERT_EQ (9, stats.drained);
+		ASSERT_EQ (2, stats.rejected);
+		ASSERT_EQ (0, stats.dropped);
+		ASSERT_EQ (8, stats.high_water);
+	}
+}
+
+TEST_F (TestEventChannel, eventMemoryFull) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	//Room for the first array of the queue only, in each half of the frame
+	const size_t small_frame_size = 2 * (rlms::EventQueue<data_event>::INITIAL_CAPACITY * sizeof (data_event) + 64);
+	FrameAllocator frame (frame_mem, small_frame_size);
+	rlms::EventQueue<data_event> queue (&arena, &frame);
+	rlms::EventChannel<data_event> channel (&arena, 64, &queue);
+
+	const size_t event_count = rlms::EventQueue<data_event>::INITIAL_CAPACITY + 4;
+	for (size_t i = 0; i < event_count; i++) {
+		ASSERT_TRUE (channel.post (0, i));
+	}
+
+	ASSERT_EQ (rlms::EventQueue<data_event>::INITIAL_CAPACITY, channel.drain ());
+
+	rlms::EventChannelStats stats = channel.getStats ();
+	{
+		SCOPED_TRACE ("Lost on the drain side, not refused");
+		ASSERT_EQ (event_count, stats.posted);
+		ASSERT_EQ (rlms::EventQueue<data_event>::INITIAL_CAPACITY, stats.drained);
+		ASSERT_EQ (0, stats.rejected);
+		ASSERT_EQ (4, stats.dropped);
+	}
+}
@@ -0,0 +1,120 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include "Base/Allocators/LinearAllocator.h"
+#include "Base/Allocators/FrameAllocator.h"
+#include "Base/Allocators/FrameAllocator.cpp"
+
+class TestFrameAllocator : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t large_size = data_obj_size * 64;
+	static void* large_mem;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestFrameAllocator::large_mem;
+
+TEST_F (TestFrameAllocator, getNumAllocations) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FrameAllocator alloc (large_mem, large_size);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+	}
+
+	allocator::allocateNew<data_obj> (alloc);
+	alloc.swap ();
+	allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Both frames");
+		ASSERT_EQ (2, alloc.getNumAllocations ());
+	}
+
+	alloc.swap ();
+	{
+		SCOPED_TRACE ("Oldest frame dropped");
+		ASSERT_EQ (1, alloc.getNumAllocations ());
+	}
+
+	alloc.swap ();
+	{
+		SCOPED_TRACE ("All dropped");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+	}
+}
+
+TEST_F (TestFrameAllocator, previousFrameValid) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FrameAllocator alloc (large_mem, large_size);
+	data_obj* a = allocator::allocateNew<data_obj> (alloc);
+	a->data = 1;
+
+	alloc.swap ();
+	data_obj* b = allocator::allocateNew<data_obj> (alloc);
+	b->data = 2;
+	{
+		SCOPED_TRACE ("Next frame");
+		ASSERT_NE (a, b);
+		ASSERT_EQ (1, a->data);
+	}
+
+	alloc.swap ();
+	data_obj* c = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Reused");
+		ASSERT_EQ (a, c);
+		ASSERT_EQ (2, b->data);
+		ASSERT_EQ (2, alloc.getFrame ());
+	}
+}
+
+TEST_F (TestFrameAllocator, deallocate) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FrameAllocator alloc (large_mem, large_size);
+	data_obj* a = allocator::allocateNew<data_obj> (alloc);
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Kept until swap");
+		ASSERT_EQ (nullptr, a);
+		ASSERT_EQ (1, alloc.getNumAllocations ());
+	}
+}
+
+TEST_F (TestFrameAllocator, full) {
+	ASSERT_NE (nullptr, large_mem);
+
+	FrameAllocator alloc (large_mem, large_size);
+	{
+		SCOPED_TRACE ("Half per frame");
+		ASSERT_EQ (nullptr, alloc.allocate (large_size / 2 + 1, 1));
+		ASSERT_NE (nullptr, alloc.allocate (large_size / 2, 1));
+		ASSERT_EQ (0, alloc.getLargestFreeBlock ());
+	}
+
+	alloc.swap ();
+	{
+		SCOPED_TRACE ("Other half");
+		ASSERT_EQ (large_size / 2, alloc.getLargestFreeBlock ());
+		ASSERT_NE (nullptr, alloc.allocate (large_size / 2, 1));
+	}
+}
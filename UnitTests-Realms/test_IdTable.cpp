@@ -0,0 +1,148 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include "Base/Allocators/FreeListAllocator.h"
+#include "Module/ECS/IdTable.h"
+
+class TestIdTable : public ::testing::Test {
+protected:
+
+	using table = rlms::IdTable<int>;
+
+	static constexpr size_t arena_size = 1024 * 1024;
+	static void* arena_mem;
+
+	virtual void SetUp () {
+		arena_mem = malloc (arena_size);
+	}
+
+	virtual void TearDown () {
+		free (arena_mem);
+	}
+};
+
+void* TestIdTable::arena_mem;
+
+TEST_F (TestIdTable, create) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	table ids (&arena);
+
+	uint32_t a = ids.create (1);
+	uint32_t b = ids.create (2);
+	{
+		SCOPED_TRACE ("Created");
+		ASSERT_NE (table::NULL_ID, a);
+		ASSERT_NE (a, b);
+		ASSERT_TRUE (ids.isValid (a));
+		ASSERT_TRUE (ids.isValid (b));
+		ASSERT_EQ (1, *ids.get (a));
+		ASSERT_EQ (2, *ids.get (b));
+		ASSERT_EQ (2, ids.getCount ());
+	}
+}
+
+TEST_F (TestIdTable, staleAfterDestroy) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	table ids (&arena);
+
+	uint32_t a = ids.create (1);
+	uint32_t b = ids.create (2);
+	ids.destroy (a);
+	{
+		SCOPED_TRACE ("Destroyed");
+		ASSERT_FALSE (ids.isValid (a));
+		ASSERT_EQ (nullptr, ids.get (a));
+		ASSERT_TRUE (ids.isValid (b));
+		ASSERT_EQ (1, ids.getCount ());
+	}
+
+	//A stale id must not destroy what lives in its slot now
+	uint32_t c = ids.create (3);
+	ids.destroy (a);
+	{
+		SCOPED_TRACE ("Stale destroy ignored");
+		ASSERT_TRUE (ids.isValid (c));
+		ASSERT_EQ (3, *ids.get (c));
+		ASSERT_EQ (2, ids.getCount ());
+	}
+}
+
+TEST_F (TestIdTable, reuseBumpsGeneration) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	table ids (&arena);
+
+	uint32_t a = ids.create (1);
+	ids.destroy (a);
+	uint32_t b = ids.create (2);
+	{
+		SCOPED_TRACE ("Same slot, next generation");
+		ASSERT_EQ (table::IndexOf (a), table::IndexOf (b));
+		ASSERT_EQ (table::GenerationOf (a) + 1, table::GenerationOf (b));
+		ASSERT_FALSE (ids.isValid (a));
+		ASSERT_TRUE (ids.isValid (b));
+	}
+}
+
+TEST_F (TestIdTable, reuseOldestFirst) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	table ids (&arena);
+
+	uint32_t a = ids.create (1);
+	uint32_t b = ids.create (2);
+	ids.create (3);
+	ids.destroy (b);
+	ids.destroy (a);
+	{
+		SCOPED_TRACE ("First freed, first reused");
+		ASSERT_EQ (table::IndexOf (b), table::IndexOf (ids.create (4)));
+		ASSERT_EQ (table::IndexOf (a), table::IndexOf (ids.create (5)));
+	}
+}
+
+TEST_F (TestIdTable, isValidOutOfRange) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	table ids (&arena);
+
+	uint32_t a = ids.create (1);
+	uint32_t past_end = (table::GenerationOf (a) << table::INDEX_BITS) | (table::IndexOf (a) + 1);
+	{
+		SCOPED_TRACE ("Invalid ids");
+		ASSERT_FALSE (ids.isValid (table::NULL_ID));
+		ASSERT_FALSE (ids.isValid (past_end));
+		ASSERT_FALSE (ids.isValid (table::INDEX_MASK));
+		ASSERT_FALSE (ids.isValid (UINT32_MAX));
+		ASSERT_EQ (nullptr, ids.get (past_end));
+	}
+
+	//Ignored rather than touching memory past the slots
+	ids.destroy (past_end);
+	ids.destroy (table::NULL_ID);
+	{
+		SCOPED_TRACE ("Destroy ignored");
+		ASSERT_TRUE (ids.isValid (a));
+		ASSERT_EQ (1, ids.getCount ());
+	}
+}
+
+TEST_F (TestIdTable, forEach) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	table ids (&arena);
+
+	uint32_t a = ids.create (1);
+	uint32_t b = ids.create (2);
+	uint32_t c = ids.create (3);
+	ids.destroy (b);
+
+	int sum = 0;
+	size_t count = 0;
+	ids.forEach ([&] (uint32_t id, int& value) {
+		ASSERT_TRUE (id == a || id == c);
+		sum += value;
+		count++;
+	});
+	{
+		SCOPED_TRACE ("Live slots only");
+		ASSERT_EQ (2, count);
+		ASSERT_EQ (4, sum);
+	}
+}
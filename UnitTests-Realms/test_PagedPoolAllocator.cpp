@@ -0,0 +1,180 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include <vector>
+
+#include "Base/Allocators/TLSFAllocator.h"
+#include "Base/Allocators/PagedPoolAllocator.h"
+#include "Base/Allocators/PagedPoolAllocator.cpp"
+
+class TestPagedPoolAllocator : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t page_size = 1024;
+	static constexpr size_t large_size = page_size * 64;
+	static void* large_mem;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestPagedPoolAllocator::large_mem;
+
+TEST_F (TestPagedPoolAllocator, getNumAllocations) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	PagedPoolAllocator alloc (data_obj_size, __alignof(data_obj), page_size, &parent);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+		ASSERT_EQ (0, alloc.getPageCount ());
+	}
+
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_EQ (1, alloc.getNumAllocations ());
+		ASSERT_EQ (1, alloc.getPageCount ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+	}
+}
+
+TEST_F (TestPagedPoolAllocator, getUsedMemory) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	PagedPoolAllocator alloc (data_obj_size, __alignof(data_obj), page_size, &parent);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+		ASSERT_EQ (0, alloc.getSize ());
+	}
+
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_EQ (data_obj_size, alloc.getUsedMemory ());
+		ASSERT_EQ (page_size, alloc.getSize ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+	}
+}
+
+TEST_F (TestPagedPoolAllocator, alignment) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	PagedPoolAllocator alloc (data_obj_size, 64, page_size, &parent);
+
+	std::vector<void*> objs;
+	for (size_t i = 0; i < alloc.getObjectsPerPage () * 2; i++) {
+		void* p = alloc.allocate (data_obj_size, 64);
+		ASSERT_NE (nullptr, p);
+		ASSERT_TRUE (pointerMath::isAligned (p, 64));
+		objs.push_back (p);
+	}
+	for (void*& p : objs) {
+		alloc.deallocate (std::move (p));
+	}
+}
+
+TEST_F (TestPagedPoolAllocator, growth) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	PagedPoolAllocator alloc (data_obj_size, __alignof(data_obj), page_size, &parent, 1);
+	size_t per_page = alloc.getObjectsPerPage ();
+
+	//Fill four pages
+	std::vector<data_obj*> objs;
+	for (size_t i = 0; i < per_page * 4; i++) {
+		data_obj* o = allocator::allocateNew<data_obj> (alloc);
+		ASSERT_NE (nullptr, o);
+		objs.push_back (o);
+	}
+	{
+		SCOPED_TRACE ("Grown");
+		ASSERT_EQ (4, alloc.getPageCount ());
+		ASSERT_EQ (4, parent.getNumAllocations ());
+	}
+
+	//Empty every page, only the slack is kept
+	for (data_obj*& o : objs) {
+		ASSERT_EQ (32Ui64, o->data);
+		allocator::deallocateDelete<data_obj> (alloc, o);
+	}
+	{
+		SCOPED_TRACE ("Shrunk");
+		ASSERT_EQ (1, alloc.getPageCount ());
+		ASSERT_EQ (1, parent.getNumAllocations ());
+	}
+
+	//The slack page is reused before asking the parent
+	data_obj* a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Reuse");
+		ASSERT_EQ (1, alloc.getPageCount ());
+	}
+	allocator::deallocateDelete<data_obj> (alloc, a);
+}
+
+TEST_F (TestPagedPoolAllocator, parentExhausted) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, page_size * 4);
+	PagedPoolAllocator alloc (data_obj_size, __alignof(data_obj), page_size, &parent);
+
+	std::vector<void*> objs;
+	void* p = nullptr;
+	while ((p = alloc.allocate (data_obj_size, __alignof(data_obj))) != nullptr) {
+		objs.push_back (p);
+	}
+	{
+		SCOPED_TRACE ("Full");
+		ASSERT_LT (0, objs.size ());
+		ASSERT_EQ (objs.size (), alloc.getNumAllocations ());
+	}
+
+	for (void*& o : objs) {
+		alloc.deallocate (std::move (o));
+	}
+}
+
+TEST_F (TestPagedPoolAllocator, release) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	{
+		PagedPoolAllocator alloc (data_obj_size, __alignof(data_obj), page_size, &parent, 4);
+		void* p = alloc.allocate (data_obj_size, __alignof(data_obj));
+		ASSERT_NE (nullptr, p);
+	}
+
+	//Every page goes back to the parent with the pool
+	ASSERT_EQ (0, parent.getNumAllocations ());
+}
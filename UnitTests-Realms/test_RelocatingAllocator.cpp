@@ -0,0 +1,186 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include "Base/Allocators/HandleTable.h"
+#include "Base/Allocators/HandleTable.cpp"
+#include "Base/Allocators/RelocatingAllocator.h"
+#include "Base/Allocators/RelocatingAllocator.cpp"
+
+class TestRelocatingAllocator : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	//Not trivially copyable, moved through relocateObject
+	class tracked_obj {
+	public:
+		static int alive;
+
+		unsigned long long data;
+
+		tracked_obj (unsigned long long d) : data (d) { alive++; }
+		tracked_obj (tracked_obj&& other) : data (other.data) { alive++; }
+		~tracked_obj () { alive--; }
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t large_size = 4096;
+	static void* large_mem;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+		tracked_obj::alive = 0;
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestRelocatingAllocator::large_mem;
+int TestRelocatingAllocator::tracked_obj::alive;
+
+TEST_F (TestRelocatingAllocator, handleTable) {
+	int a = 0, b = 0;
+	HandleTable table;
+
+	Handle ha = table.create (&a);
+	Handle hb = table.create (&b);
+	{
+		SCOPED_TRACE ("Create");
+		ASSERT_EQ (&a, table.get (ha));
+		ASSERT_EQ (&b, table.get (hb));
+		ASSERT_EQ (2, table.getCount ());
+		ASSERT_TRUE (Handle ().isNull ());
+		ASSERT_FALSE (table.isValid (Handle ()));
+	}
+
+	table.destroy (ha);
+	Handle hc = table.create (&b);
+	{
+		SCOPED_TRACE ("Slot reused with a new generation");
+		ASSERT_EQ (ha.index, hc.index);
+		ASSERT_NE (ha, hc);
+		ASSERT_FALSE (table.isValid (ha));
+		ASSERT_EQ (nullptr, table.get (ha));
+		ASSERT_EQ (&b, table.get (hc));
+	}
+
+	table.relocate (hb.index, &a);
+	{
+		SCOPED_TRACE ("Relocate");
+		ASSERT_EQ (&a, table.get (hb));
+	}
+}
+
+TEST_F (TestRelocatingAllocator, allocateHandle) {
+	ASSERT_NE (nullptr, large_mem);
+
+	RelocatingAllocator alloc (large_mem, large_size);
+	Handle h = allocator::allocateRelocatable<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Allocate");
+		ASSERT_FALSE (h.isNull ());
+		ASSERT_TRUE (alloc.isValid (h));
+		ASSERT_EQ (1, alloc.getNumAllocations ());
+		ASSERT_EQ (32Ui64, static_cast<data_obj*>(alloc.get (h))->data);
+		ASSERT_EQ (0, (uintptr_t)alloc.get (h) % RelocatingAllocator::BLOCK_ALIGNMENT);
+	}
+
+	Handle copy = h;
+	allocator::deallocateRelocatable<data_obj> (alloc, h);
+	{
+		SCOPED_TRACE ("Deallocate");
+		ASSERT_TRUE (h.isNull ());
+		ASSERT_FALSE (alloc.isValid (copy));
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+	}
+}
+
+TEST_F (TestRelocatingAllocator, defragment) {
+	ASSERT_NE (nullptr, large_mem);
+
+	RelocatingAllocator alloc (large_mem, large_size);
+	Handle handles[8];
+	for (int i = 0; i < 8; i++) {
+		handles[i] = allocator::allocateRelocatable<data_obj> (alloc);
+		static_cast<data_obj*>(alloc.get (handles[i]))->data = i;
+	}
+	size_t free_before = alloc.getLargestFreeBlock ();
+
+	//Holes every other block
+	for (int i = 0; i < 8; i += 2) {
+		allocator::deallocateRelocatable<data_obj> (alloc, handles[i]);
+	}
+	{
+		SCOPED_TRACE ("Holes are not free space on top");
+		ASSERT_EQ (free_before, alloc.getLargestFreeBlock ());
+	}
+
+	void* first = alloc.get (handles[1]);
+	size_t moved = alloc.defragment (1);
+	{
+		SCOPED_TRACE ("Budget stops after one block");
+		ASSERT_NE (0, moved);
+		ASSERT_NE (first, alloc.get (handles[1]));
+		ASSERT_EQ (1, static_cast<data_obj*>(alloc.get (handles[1]))->data);
+	}
+
+	alloc.defragment (SIZE_MAX);
+	{
+		SCOPED_TRACE ("Fully compacted");
+		ASSERT_EQ (free_before + alloc.getUsedMemory (), alloc.getLargestFreeBlock ());
+		for (int i = 1; i < 8; i += 2) {
+			ASSERT_EQ (i, static_cast<data_obj*>(alloc.get (handles[i]))->data);
+		}
+		ASSERT_EQ (0, alloc.defragment (SIZE_MAX));
+	}
+}
+
+TEST_F (TestRelocatingAllocator, relocateObjects) {
+	ASSERT_NE (nullptr, large_mem);
+
+	RelocatingAllocator alloc (large_mem, large_size);
+	Handle a = allocator::allocateRelocatable<tracked_obj> (alloc, 1Ui64);
+	Handle b = allocator::allocateRelocatable<tracked_obj> (alloc, 2Ui64);
+	Handle c = allocator::allocateRelocatable<tracked_obj> (alloc, 3Ui64);
+
+	allocator::deallocateRelocatable<tracked_obj> (alloc, a);
+	alloc.defragment (SIZE_MAX);
+	{
+		SCOPED_TRACE ("Moved with the move constructor");
+		ASSERT_EQ (2, tracked_obj::alive);
+		ASSERT_EQ (2Ui64, static_cast<tracked_obj*>(alloc.get (b))->data);
+		ASSERT_EQ (3Ui64, static_cast<tracked_obj*>(alloc.get (c))->data);
+	}
+
+	allocator::deallocateRelocatable<tracked_obj> (alloc, b);
+	allocator::deallocateRelocatable<tracked_obj> (alloc, c);
+	ASSERT_EQ (0, tracked_obj::alive);
+}
+
+TEST_F (TestRelocatingAllocator, compactsWhenFull) {
+	ASSERT_NE (nullptr, large_mem);
+
+	RelocatingAllocator alloc (large_mem, large_size);
+	std::vector<Handle> handles;
+	Handle h;
+	while (!(h = allocator::allocateRelocatable<data_obj> (alloc)).isNull ()) {
+		handles.push_back (h);
+	}
+	ASSERT_LT (2, handles.size ());
+
+	allocator::deallocateRelocatable<data_obj> (alloc, handles[0]);
+	allocator::deallocateRelocatable<data_obj> (alloc, handles[1]);
+	{
+		SCOPED_TRACE ("Allocating compacts the holes away");
+		ASSERT_FALSE (allocator::allocateRelocatable<data_obj> (alloc).isNull ());
+		ASSERT_TRUE (alloc.isValid (handles[2]));
+	}
+}
@@ -3,6 +3,9 @@
 
 #include "Base/Allocators/StackAllocator.cpp"
 
+#include <cstring>
+#include <thread>
+
 class TestStackAllocator : public ::testing::Test {
 protected:
 
@@ -145,3 +148,74 @@ TEST_F (TestStackAllocator, data_obj) {
 		ASSERT_EQ (nullptr, a);
 	}
 }
+
+TEST_F (TestStackAllocator, rewind) {
+	//Room for the guards of debug builds
+	alignas (16) char mem[1024];
+	StackAllocator alloc (mem, sizeof (mem));
+	allocator::allocateNew<data_obj> (alloc);
+	StackAllocator::Marker marker = alloc.getMarker ();
+	size_t used = alloc.getUsedMemory ();
+
+	allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Allocated past the marker");
+		ASSERT_EQ (2, alloc.getNumAllocations ());
+	}
+
+	alloc.rewind (marker);
+	{
+		SCOPED_TRACE ("Rewound");
+		ASSERT_EQ (1, alloc.getNumAllocations ());
+		ASSERT_EQ (used, alloc.getUsedMemory ());
+		ASSERT_NE (nullptr, allocator::allocateNew<data_obj> (alloc));
+	}
+}
+
+TEST_F (TestStackAllocator, stackScope) {
+	//Room for the guards of debug builds
+	alignas (16) char mem[1024];
+	StackAllocator alloc (mem, sizeof (mem));
+	{
+		StackScope outer (alloc);
+		allocator::allocateNew<data_obj> (outer.stack ());
+		{
+			StackScope inner (alloc);
+			allocator::allocateNew<data_obj> (inner.stack ());
+			ASSERT_EQ (2, alloc.getNumAllocations ());
+		}
+		{
+			SCOPED_TRACE ("Inner scope freed");
+			ASSERT_EQ (1, alloc.getNumAllocations ());
+		}
+	}
+	{
+		SCOPED_TRACE ("Outer scope freed");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+	}
+}
+
+TEST_F (TestStackAllocator, threadScratch) {
+	StackAllocator& scratch = StackAllocator::ThreadScratch ();
+	ASSERT_EQ (&scratch, &StackAllocator::ThreadScratch ());
+	ASSERT_EQ (StackAllocator::SCRATCH_SIZE, scratch.getSize ());
+
+	StackAllocator* other = nullptr;
+	std::thread t ([&other] () {
+		other = &StackAllocator::ThreadScratch ();
+	});
+	t.join ();
+	{
+		SCOPED_TRACE ("One per thread");
+		ASSERT_NE (&scratch, other);
+	}
+
+	{
+		StackScope scope (scratch);
+		void* p = scope.stack ().allocate (1024 * 1024);
+		ASSERT_NE (nullptr, p);
+		memset (p, 0, 1024 * 1024);
+	}
+	ASSERT_EQ (0, scratch.getUsedMemory ());
+}
@@ -0,0 +1,244 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Base/Allocators/FreeListAllocator.h"
+#include "Base/Allocators/BudgetAllocator.h"
+#include "Module/ECS/SystemManager.h"
+
+class TestSystemManager : public ::testing::Test {
+protected:
+
+	struct position : public rlms::IComponent {};
+	struct velocity : public rlms::IComponent {};
+
+	class test_system : public rlms::ISystem {
+	public:
+		void start () override {}
+		void preUpdate (rlms::GAME_TICK_TYPE) override {}
+		void update (rlms::GAME_TICK_TYPE) override {}
+		void postUpdate (rlms::GAME_TICK_TYPE) override {}
+		void stop () override {}
+	};
+
+	class reader_a : public test_system {
+	public:
+		reader_a () { reads<position> (); }
+		void update (rlms::GAME_TICK_TYPE) override { record ("reader_a"); reader_a_met = meet (); }
+	};
+
+	class reader_b : public test_system {
+	public:
+		reader_b () { reads<position> (); }
+		void update (rlms::GAME_TICK_TYPE) override { record ("reader_b"); reader_b_met = meet (); }
+	};
+
+	class writer : public test_system {
+	public:
+		writer () { writes<position> (); }
+		void update (rlms::GAME_TICK_TYPE) override { record ("writer"); writer_met = meet (); }
+	};
+
+	class after_writer : public test_system {
+	public:
+		after_writer () { reads<position> (); }
+		void update (rlms::GAME_TICK_TYPE) override { record ("after_writer"); }
+	};
+
+	class undeclared : public test_system {
+	public:
+		void update (rlms::GAME_TICK_TYPE) override { record ("undeclared"); undeclared_in_parallel = rlms::ThreadPool::InParallel (); }
+	};
+
+	class victim : public test_system {
+	public:
+		victim () { writes<velocity> (); }
+		~victim () { victim_destroyed = true; }
+		void update (rlms::GAME_TICK_TYPE) override { record ("victim"); }
+	};
+
+	class destroyer : public test_system {
+	public:
+		void update (rlms::GAME_TICK_TYPE) override { record ("destroyer"); rlms::SystemManager::DestroySystem<victim> (); }
+	};
+
+	class self_destroyer : public test_system {
+	public:
+		self_destroyer () : calls (0) {}
+		void update (rlms::GAME_TICK_TYPE) override {
+			rlms::SystemManager::DestroySystem<self_destroyer> ();
+			//Still alive until the end of the tick
+			calls++;
+			self_destroyer_calls = calls;
+		}
+	private:
+		int calls;
+	};
+
+	static constexpr size_t arena_size = 1024 * 1024;
+	static constexpr size_t system_pool_size = 64 * 1024;
+	static void* arena_mem;
+
+	static std::mutex order_mutex;
+	static std::vector<std::string> order;
+	static std::atomic<int> arrived;
+	static bool reader_a_met;
+	static bool reader_b_met;
+	static bool writer_met;
+	static bool undeclared_in_parallel;
+	static bool victim_destroyed;
+	static int self_destroyer_calls;
+
+	static void record (const char* name) {
+		std::lock_guard<std::mutex> lock (order_mutex);
+		order.push_back (name);
+	}
+
+	//True once two systems are inside at the same time, so only when they share a phase
+	static bool meet () {
+		arrived++;
+		auto deadline = std::chrono::steady_clock::now () + std::chrono::milliseconds (200);
+		while (arrived < 2 && std::chrono::steady_clock::now () < deadline) {
+			std::this_thread::yield ();
+		}
+		return arrived >= 2;
+	}
+
+	virtual void SetUp () {
+		arena_mem = malloc (arena_size);
+		order.clear ();
+		arrived = 0;
+		reader_a_met = false;
+		reader_b_met = false;
+		writer_met = false;
+		undeclared_in_parallel = true;
+		victim_destroyed = false;
+		self_destroyer_calls = 0;
+		//A worker is enough for the systems of a phase to meet
+		rlms::ThreadPool::Initialize (1);
+	}
+
+	virtual void TearDown () {
+		rlms::ThreadPool::Terminate ();
+		free (arena_mem);
+	}
+};
+
+void* TestSystemManager::arena_mem;
+std::mutex TestSystemManager::order_mutex;
+std::vector<std::string> TestSystemManager::order;
+std::atomic<int> TestSystemManager::arrived;
+bool TestSystemManager::reader_a_met;
+bool TestSystemManager::reader_b_met;
+bool TestSystemManager::writer_met;
+bool TestSystemManager::undeclared_in_parallel;
+bool TestSystemManager::victim_destroyed;
+int TestSystemManager::self_destroyer_calls;
+
+TEST_F (TestSystemManager, readersShareAPhase) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	BudgetAllocator root ("Root", &arena, arena_size);
+	rlms::SystemManager::Initialize (&root, system_pool_size);
+
+	rlms::SystemManager::CreateSystem<reader_a> ();
+	rlms::SystemManager::CreateSystem<reader_b> ();
+	rlms::SystemManager::Update (1);
+	{
+		SCOPED_TRACE ("Ran together");
+		ASSERT_EQ (2, order.size ());
+		ASSERT_TRUE (reader_a_met);
+		ASSERT_TRUE (reader_b_met);
+	}
+
+	rlms::SystemManager::Terminate ();
+}
+
+TEST_F (TestSystemManager, conflictsRunInTypeIdOrder) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	BudgetAllocator root ("Root", &arena, arena_size);
+	rlms::SystemManager::Initialize (&root, system_pool_size);
+
+	rlms::SystemManager::CreateSystem<writer> ();
+	rlms::SystemManager::CreateSystem<after_writer> ();
+	rlms::SystemManager::Update (1);
+	{
+		SCOPED_TRACE ("Writer alone, then its reader");
+		ASSERT_EQ (2, order.size ());
+		ASSERT_EQ ("writer", order[0]);
+		ASSERT_EQ ("after_writer", order[1]);
+		ASSERT_FALSE (writer_met);
+	}
+
+	rlms::SystemManager::Terminate ();
+}
+
+TEST_F (TestSystemManager, undeclaredRunsAlone) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	BudgetAllocator root ("Root", &arena, arena_size);
+	rlms::SystemManager::Initialize (&root, system_pool_size);
+
+	rlms::SystemManager::CreateSystem<reader_a> ();
+	rlms::SystemManager::CreateSystem<undeclared> ();
+	rlms::SystemManager::CreateSystem<reader_b> ();
+	rlms::SystemManager::Update (1);
+	{
+		SCOPED_TRACE ("On the tick's thread, the readers still together");
+		ASSERT_EQ (3, order.size ());
+		ASSERT_FALSE (undeclared_in_parallel);
+		ASSERT_TRUE (reader_a_met);
+		ASSERT_TRUE (reader_b_met);
+	}
+
+	rlms::SystemManager::Terminate ();
+}
+
+TEST_F (TestSystemManager, destroyDuringTick) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	BudgetAllocator root ("Root", &arena, arena_size);
+	rlms::SystemManager::Initialize (&root, system_pool_size);
+
+	//Created first, so the victim is scheduled after the destroyer
+	rlms::SystemManager::CreateSystem<destroyer> ();
+	rlms::SystemManager::CreateSystem<victim> ();
+	rlms::SystemManager::Update (1);
+	{
+		SCOPED_TRACE ("Skipped, not freed yet");
+		ASSERT_EQ (1, order.size ());
+		ASSERT_EQ ("destroyer", order[0]);
+		ASSERT_FALSE (rlms::SystemManager::HasSystem<victim> ());
+		ASSERT_FALSE (victim_destroyed);
+	}
+
+	rlms::SystemManager::PostUpdate (1);
+	{
+		SCOPED_TRACE ("Freed at the end of the tick");
+		ASSERT_TRUE (victim_destroyed);
+		ASSERT_EQ (0, rlms::SystemManager::n_errors);
+	}
+
+	rlms::SystemManager::Terminate ();
+}
+
+TEST_F (TestSystemManager, destroySelfDuringTick) {
+	FreeListAllocator arena (arena_mem, arena_size);
+	BudgetAllocator root ("Root", &arena, arena_size);
+	rlms::SystemManager::Initialize (&root, system_pool_size);
+
+	rlms::SystemManager::CreateSystem<self_destroyer> ();
+	rlms::SystemManager::Update (1);
+	rlms::SystemManager::PostUpdate (1);
+	rlms::SystemManager::Update (1);
+	{
+		SCOPED_TRACE ("Ran once");
+		ASSERT_EQ (1, self_destroyer_calls);
+		ASSERT_FALSE (rlms::SystemManager::HasSystem<self_destroyer> ());
+	}
+
+	rlms::SystemManager::Terminate ();
+}
@@ -0,0 +1,179 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include "Base/Allocators/TLSFAllocator.h"
+#include "Base/Allocators/TLSFAllocator.cpp"
+
+class TestTLSFAllocator : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t large_size = data_obj_size * 64;
+	static void* large_mem;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestTLSFAllocator::large_mem;
+
+TEST_F (TestTLSFAllocator, getStart) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator alloc (large_mem, large_size);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (large_mem, alloc.getStart ());
+	}
+
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_EQ (large_mem, alloc.getStart ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (large_mem, alloc.getStart ());
+	}
+}
+
+TEST_F (TestTLSFAllocator, getSize) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator alloc (large_mem, large_size);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (large_size, alloc.getSize ());
+	}
+
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_EQ (large_size, alloc.getSize ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (large_size, alloc.getSize ());
+	}
+}
+
+TEST_F (TestTLSFAllocator, getNumAllocations) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator alloc (large_mem, large_size);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+	}
+
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_EQ (1, alloc.getNumAllocations ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+	}
+}
+
+TEST_F (TestTLSFAllocator, getUsedMemory) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator alloc (large_mem, large_size);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+	}
+
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_LT (data_obj_size, alloc.getUsedMemory ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+	}
+}
+
+TEST_F (TestTLSFAllocator, alignment) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator alloc (large_mem, large_size);
+	for (uint8_t alignment = 1; alignment <= 64; alignment *= 2) {
+		SCOPED_TRACE (alignment);
+		void* p = alloc.allocate (data_obj_size, alignment);
+		ASSERT_NE (nullptr, p);
+		ASSERT_TRUE (pointerMath::isAligned (p, alignment));
+		alloc.deallocate (std::move (p));
+	}
+	ASSERT_EQ (0, alloc.getUsedMemory ());
+}
+
+TEST_F (TestTLSFAllocator, coalescing) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator alloc (large_mem, large_size);
+	void* a = alloc.allocate (large_size / 4, DEFAULT_ALIGNMENT);
+	void* b = alloc.allocate (large_size / 4, DEFAULT_ALIGNMENT);
+	void* c = alloc.allocate (large_size / 4, DEFAULT_ALIGNMENT);
+	ASSERT_NE (nullptr, a);
+	ASSERT_NE (nullptr, b);
+	ASSERT_NE (nullptr, c);
+
+	//Free out of order, neighbours must merge back into one block
+	alloc.deallocate (std::move (b));
+	alloc.deallocate (std::move (a));
+	alloc.deallocate (std::move (c));
+	{
+		SCOPED_TRACE ("Merged");
+		void* big = alloc.allocate (large_size / 2, DEFAULT_ALIGNMENT);
+		ASSERT_NE (nullptr, big);
+		alloc.deallocate (std::move (big));
+	}
+}
+
+TEST_F (TestTLSFAllocator, data_obj) {
+	data_obj* a = nullptr;
+
+	ASSERT_NE (nullptr, large_mem);
+	ASSERT_EQ (nullptr, a);
+
+	TLSFAllocator alloc (large_mem, large_size);
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_NE (nullptr, a);
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (nullptr, a);
+	}
+}
@@ -0,0 +1,206 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include <thread>
+#include <vector>
+
+#include "Base/Allocators/TLSFAllocator.h"
+#include "Base/Allocators/ThreadCacheAllocator.h"
+#include "Base/Allocators/ThreadCacheAllocator.cpp"
+
+class TestThreadCacheAllocator : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	static constexpr size_t large_size = data_obj_size * 4096;
+	static void* large_mem;
+
+	virtual void SetUp () {
+		large_mem = malloc (large_size);
+	}
+
+	virtual void TearDown () {
+		free (large_mem);
+	}
+};
+
+void* TestThreadCacheAllocator::large_mem;
+
+TEST_F (TestThreadCacheAllocator, getParent) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	ThreadCacheAllocator alloc (&parent);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (&parent, alloc.getParent ());
+		ASSERT_EQ (large_mem, alloc.getStart ());
+		ASSERT_EQ (large_size, alloc.getSize ());
+	}
+}
+
+TEST_F (TestThreadCacheAllocator, getNumAllocations) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	ThreadCacheAllocator alloc (&parent);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+	}
+
+	//A whole batch is taken from the parent on the first allocation
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_EQ (ThreadCacheAllocator::BATCH_SIZE, alloc.getNumAllocations ());
+		ASSERT_EQ (ThreadCacheAllocator::BATCH_SIZE, parent.getNumAllocations ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (ThreadCacheAllocator::BATCH_SIZE, alloc.getNumAllocations ());
+	}
+
+	alloc.flush ();
+	{
+		SCOPED_TRACE ("Flush");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+		ASSERT_EQ (0, parent.getNumAllocations ());
+	}
+}
+
+TEST_F (TestThreadCacheAllocator, getUsedMemory) {
+	data_obj* a = nullptr;
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	ThreadCacheAllocator alloc (&parent);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+	}
+
+	a = allocator::allocateNew<data_obj> (alloc);
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_LT (data_obj_size, alloc.getUsedMemory ());
+	}
+
+	allocator::deallocateDelete<data_obj> (alloc, a);
+	alloc.flush ();
+	{
+		SCOPED_TRACE ("Flush");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+		ASSERT_EQ (0, parent.getUsedMemory ());
+	}
+}
+
+TEST_F (TestThreadCacheAllocator, reuse) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	ThreadCacheAllocator alloc (&parent);
+
+	//Freed block goes back on top of the thread's list
+	void* a = alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT);
+	void* expected = a;
+	alloc.deallocate (std::move (a));
+	void* b = alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT);
+	{
+		SCOPED_TRACE ("Reuse");
+		ASSERT_EQ (expected, b);
+	}
+	alloc.deallocate (std::move (b));
+}
+
+TEST_F (TestThreadCacheAllocator, destroyFlushes) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	{
+		ThreadCacheAllocator alloc (&parent);
+
+		data_obj* o = allocator::allocateNew<data_obj> (alloc);
+		ASSERT_NE (nullptr, o);
+		allocator::deallocateDelete<data_obj> (alloc, o);
+		{
+			SCOPED_TRACE ("Cached");
+			ASSERT_LT (0, parent.getUsedMemory ());
+		}
+	}
+	{
+		SCOPED_TRACE ("Destroyed");
+		ASSERT_EQ (0, parent.getUsedMemory ());
+		ASSERT_EQ (0, parent.getNumAllocations ());
+	}
+}
+
+TEST_F (TestThreadCacheAllocator, large) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	ThreadCacheAllocator alloc (&parent);
+
+	//Beyond the size classes or with a strict alignment, go straight to the parent
+	void* a = alloc.allocate (ThreadCacheAllocator::MAX_CACHED_SIZE * 2, DEFAULT_ALIGNMENT);
+	void* b = alloc.allocate (data_obj_size, 64);
+	ASSERT_NE (nullptr, a);
+	ASSERT_NE (nullptr, b);
+	ASSERT_TRUE (pointerMath::isAligned (b, 64));
+	{
+		SCOPED_TRACE ("Alloc");
+		ASSERT_EQ (2, alloc.getNumAllocations ());
+		ASSERT_EQ (2, parent.getNumAllocations ());
+	}
+
+	alloc.deallocate (std::move (a));
+	alloc.deallocate (std::move (b));
+	{
+		SCOPED_TRACE ("Dealloc");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+		ASSERT_EQ (0, parent.getNumAllocations ());
+	}
+}
+
+TEST_F (TestThreadCacheAllocator, threads) {
+	ASSERT_NE (nullptr, large_mem);
+
+	TLSFAllocator parent (large_mem, large_size);
+	ThreadCacheAllocator alloc (&parent);
+
+	//Caches of exiting threads are flushed back to the parent
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < 4; t++) {
+		threads.emplace_back ([&alloc] () {
+			std::vector<data_obj*> objs;
+			for (size_t i = 0; i < 256; i++) {
+				data_obj* o = allocator::allocateNew<data_obj> (alloc);
+				ASSERT_NE (nullptr, o);
+				objs.push_back (o);
+			}
+			for (data_obj*& o : objs) {
+				ASSERT_EQ (32Ui64, o->data);
+				allocator::deallocateDelete<data_obj> (alloc, o);
+			}
+		});
+	}
+	for (std::thread& t : threads) {
+		t.join ();
+	}
+
+	{
+		SCOPED_TRACE ("Joined");
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+		ASSERT_EQ (0, parent.getUsedMemory ());
+	}
+}
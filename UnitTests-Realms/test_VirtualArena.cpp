@@ -0,0 +1,232 @@
+#include "pch.h"
+#include "pch_allocators.h"
+
+#include "Base/Allocators/VirtualArena.h"
+#include "Base/Allocators/VirtualArena.cpp"
+#include "Base/Allocators/TLSFAllocator.h"
+
+#include <cstring>
+
+class TestVirtualArena : public ::testing::Test {
+protected:
+
+	class data_obj {
+	public:
+		unsigned long long data = 32Ui64;
+		unsigned long long data_the_return = 32Ui64;
+	};
+
+	static constexpr unsigned long long data_obj_size = sizeof (data_obj);
+
+	//Far more than is ever touched
+	static constexpr size_t reserve_size = 1024Ui64 * 1024 * 1024;
+};
+
+TEST_F (TestVirtualArena, reserve) {
+	VirtualArena arena (reserve_size);
+	{
+		SCOPED_TRACE ("Init");
+		ASSERT_NE (nullptr, arena.getStart ());
+		ASSERT_LE (reserve_size, arena.getReservedSize ());
+		ASSERT_EQ (0, arena.getCommittedSize ());
+	}
+}
+
+TEST_F (TestVirtualArena, commit) {
+	VirtualArena arena (reserve_size);
+	ASSERT_NE (nullptr, arena.getStart ());
+
+	ASSERT_TRUE (arena.commit (1));
+	{
+		SCOPED_TRACE ("Page");
+		ASSERT_EQ (VirtualArena::PageSize (), arena.getCommittedSize ());
+		memset (arena.getStart (), 0xAB, VirtualArena::PageSize ());
+	}
+
+	ASSERT_TRUE (arena.commit (3 * VirtualArena::PageSize ()));
+	{
+		SCOPED_TRACE ("Grow");
+		ASSERT_EQ (3 * VirtualArena::PageSize (), arena.getCommittedSize ());
+		ASSERT_EQ (0xAB, *static_cast<uint8_t*>(arena.getStart ()));
+	}
+
+	{
+		SCOPED_TRACE ("Beyond");
+		ASSERT_FALSE (arena.commit (arena.getReservedSize () + 1));
+		ASSERT_EQ (3 * VirtualArena::PageSize (), arena.getCommittedSize ());
+	}
+}
+
+TEST_F (TestVirtualArena, decommit) {
+	VirtualArena arena (reserve_size);
+	ASSERT_TRUE (arena.commit (4 * VirtualArena::PageSize ()));
+
+	uint8_t* start = static_cast<uint8_t*>(arena.getStart ());
+	memset (start, 0xAB, 4 * VirtualArena::PageSize ());
+
+	//Only the pages fully inside the range are dropped
+	arena.decommit (start + 1, 3 * VirtualArena::PageSize ());
+	{
+		SCOPED_TRACE ("Partial pages kept");
+		ASSERT_EQ (0xAB, start[1]);
+		ASSERT_EQ (0xAB, start[3 * VirtualArena::PageSize ()]);
+	}
+
+#ifdef RLMS_PLATFORM_LINUX
+	{
+		SCOPED_TRACE ("Dropped");
+		ASSERT_EQ (0, start[VirtualArena::PageSize ()]);
+		ASSERT_EQ (0, start[3 * VirtualArena::PageSize () - 1]);
+	}
+#endif
+
+	//Still usable
+	start[VirtualArena::PageSize ()] = 1;
+	ASSERT_EQ (1, start[VirtualArena::PageSize ()]);
+}
+
+TEST_F (TestVirtualArena, hugePages) {
+	VirtualArena arena (reserve_size, true);
+	ASSERT_NE (nullptr, arena.getStart ());
+
+	if (!arena.usesHugePages ()) {
+		SCOPED_TRACE ("Fallback");
+		ASSERT_EQ (VirtualArena::PageSize (), arena.getGranularity ());
+		return;
+	}
+
+	{
+		SCOPED_TRACE ("Aligned");
+		ASSERT_TRUE (pointerMath::isAligned (arena.getStart (), 64));
+		ASSERT_EQ (0, reinterpret_cast<uintptr_t>(arena.getStart ()) % VirtualArena::HUGE_PAGE_SIZE);
+		ASSERT_EQ (VirtualArena::HUGE_PAGE_SIZE, arena.getGranularity ());
+	}
+
+	ASSERT_TRUE (arena.commit (1));
+	{
+		SCOPED_TRACE ("Commit by huge page");
+		ASSERT_EQ (VirtualArena::HUGE_PAGE_SIZE, arena.getCommittedSize ());
+		memset (arena.getStart (), 0xAB, VirtualArena::HUGE_PAGE_SIZE);
+	}
+
+	//Less than a huge page, nothing is dropped
+	arena.decommit (arena.getStart (), VirtualArena::HUGE_PAGE_SIZE - 1);
+	{
+		SCOPED_TRACE ("Partial huge page kept");
+		ASSERT_EQ (0xAB, *static_cast<uint8_t*>(arena.getStart ()));
+	}
+}
+
+TEST_F (TestVirtualArena, tlsfGrow) {
+	VirtualArena arena (reserve_size);
+	ASSERT_NE (nullptr, arena.getStart ());
+
+	TLSFAllocator alloc (&arena, VirtualArena::PageSize ());
+	size_t initial_size = alloc.getSize ();
+
+	void* small = alloc.allocate (data_obj_size, DEFAULT_ALIGNMENT);
+	void* large = alloc.allocate (16 * initial_size, DEFAULT_ALIGNMENT);
+	{
+		SCOPED_TRACE ("Grown");
+		ASSERT_NE (nullptr, small);
+		ASSERT_NE (nullptr, large);
+		ASSERT_LT (initial_size, alloc.getSize ());
+		ASSERT_EQ (alloc.getSize (), arena.getCommittedSize ());
+		memset (large, 0xAB, 16 * initial_size);
+	}
+
+	void* first = small;
+	alloc.deallocate (std::move (large));
+	alloc.deallocate (std::move (small));
+	{
+		SCOPED_TRACE ("Freed");
+		ASSERT_EQ (0, alloc.getUsedMemory ());
+		ASSERT_EQ (0, alloc.getNumAllocations ());
+	}
+
+	//The appended memory merged back with the initial pool
+	void* all = alloc.allocate (alloc.getLargestFreeBlock () / 2, DEFAULT_ALIGNMENT);
+	{
+		SCOPED_TRACE ("Merged");
+		ASSERT_NE (nullptr, all);
+		ASSERT_EQ (first, all);
+		ASSERT_LT (16 * initial_size, alloc.getLargestFreeBlock () + alloc.getUsedMemory ());
+	}
+	alloc.deallocate (std::move (all));
+}
+
+TEST_F (TestVirtualArena, tlsfDecommit) {
+	VirtualArena arena (reserve_size);
+	ASSERT_NE (nullptr, arena.getStart ());
+
+	TLSFAllocator alloc (&arena, VirtualArena::PageSize ());
+	size_t size = 2 * TLSFAllocator::DECOMMIT_THRESHOLD;
+
+	uint8_t* p = static_cast<uint8_t*>(alloc.allocate (size, DEFAULT_ALIGNMENT));
+	ASSERT_NE (nullptr, p);
+	memset (p, 0xAB, size);
+
+	uint8_t* middle = p + size / 2;
+	alloc.deallocate (std::move (reinterpret_cast<void*&>(p)));
+
+#ifdef RLMS_PLATFORM_LINUX
+	{
+		SCOPED_TRACE ("Pages given back");
+		ASSERT_EQ (0, *middle);
+	}
+#endif
+
+	//Memory given back is still usable
+	void* again = alloc.allocate (size, DEFAULT_ALIGNMENT);
+	ASSERT_NE (nullptr, again);
+	memset (again, 0xAB, size);
+	alloc.deallocate (std::move (again));
+	ASSERT_EQ (0, alloc.getUsedMemory ());
+}
+
+TEST_F (TestVirtualArena, tlsfDecommitOnce) {
+	VirtualArena arena (reserve_size);
+	ASSERT_NE (nullptr, arena.getStart ());
+
+	TLSFAllocator alloc (&arena, VirtualArena::PageSize ());
+	size_t size = 2 * TLSFAllocator::DECOMMIT_THRESHOLD;
+
+	uint8_t* p = static_cast<uint8_t*>(alloc.allocate (size, DEFAULT_ALIGNMENT));
+	void* small = alloc.allocate (VirtualArena::PageSize (), DEFAULT_ALIGNMENT);
+	ASSERT_NE (nullptr, p);
+	ASSERT_NE (nullptr, small);
+	memset (p, 0xAB, size);
+
+	uint8_t* middle = p + size / 2;
+	alloc.deallocate (std::move (reinterpret_cast<void*&>(p)));
+
+	//Freeing a neighbour only hands back its own pages, not the large free block again
+	*middle = 0xAB;
+	alloc.deallocate (std::move (small));
+
+#ifdef RLMS_PLATFORM_LINUX
+	{
+		SCOPED_TRACE ("Pages already given back left alone");
+		ASSERT_EQ (0xAB, *middle);
+	}
+#endif
+	ASSERT_EQ (0, alloc.getUsedMemory ());
+}
+
+TEST_F (TestVirtualArena, tlsfExhausted) {
+	VirtualArena arena (64 * VirtualArena::PageSize ());
+	ASSERT_NE (nullptr, arena.getStart ());
+
+	TLSFAllocator alloc (&arena, VirtualArena::PageSize ());
+	{
+		SCOPED_TRACE ("Beyond reservation");
+		ASSERT_EQ (nullptr, alloc.allocate (arena.getReservedSize (), DEFAULT_ALIGNMENT));
+	}
+
+	void* p = alloc.allocate (32 * VirtualArena::PageSize (), DEFAULT_ALIGNMENT);
+	{
+		SCOPED_TRACE ("Within reservation");
+		ASSERT_NE (nullptr, p);
+	}
+	alloc.deallocate (std::move (p));
+}